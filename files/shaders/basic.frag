@@ -1,14 +0,0 @@
-#version 330 core
-
-uniform float transparency;
-uniform vec3 color;
-
-out vec4 FragColor;
-
-void main()
-{
-	vec4 outputColor = vec4(color, 1.0);
-	outputColor.a *= transparency;
-	
-	FragColor = outputColor;
-}
\ No newline at end of file
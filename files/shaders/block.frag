@@ -0,0 +1,39 @@
+#version 330 core
+
+out vec4 FragColor;
+
+in vec3 FragPos;
+in vec3 Normal;
+in vec2 TexCoords;
+flat in float Layer;
+
+uniform vec3 viewPos;
+uniform sampler2DArray blockTextures;
+
+//directional light from the render snapshot
+uniform vec3 lightDirection;
+uniform vec3 lightColor;
+uniform float ambientStrength;
+
+const float specularStrength = 0.2;
+const float shininess = 32.0;
+
+void main()
+{
+	vec3 albedo = texture(blockTextures, vec3(TexCoords, Layer)).rgb;
+	
+	vec3 norm = normalize(Normal);
+	vec3 lightDir = normalize(-lightDirection);
+	vec3 viewDir = normalize(viewPos - FragPos);
+	
+	//diffuse shading
+	float diff = max(dot(norm, lightDir), 0.0);
+	
+	//specular shading
+	vec3 reflectDir = reflect(-lightDir, norm);
+	float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
+	
+	vec3 result = albedo * (ambientStrength + diff * lightColor) + lightColor * (specularStrength * spec);
+	
+	FragColor = vec4(result, 1.0);
+}
\ No newline at end of file
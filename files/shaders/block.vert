@@ -0,0 +1,29 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aTexCoords;
+
+//per-instance
+layout(location = 3) in mat4 aModel;
+layout(location = 7) in float aLayer;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoords;
+flat out float Layer;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main()
+{
+	FragPos = vec3(aModel * vec4(aPos, 1.0));
+	//rigid blocks only, rotation and uniform scale keep normals perpendicular
+	//and block.frag normalizes them, so no normal matrix is needed
+	Normal = mat3(aModel) * aNormal;
+	TexCoords = aTexCoords;
+	Layer = aLayer;
+	
+	gl_Position = projection * view * vec4(FragPos, 1.0);
+}
\ No newline at end of file
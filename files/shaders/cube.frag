@@ -1,111 +0,0 @@
-#version 330 core
-
-out vec4 FragColor;
-
-struct Material
-{
-	sampler2D diffuse;
-	sampler2D specular;
-	float shininess;
-};
-
-struct DirLight
-{
-	vec3 direction;
-	vec3 intensity;
-	
-	vec3 ambient;
-	vec3 diffuse;
-	vec3 specular;
-};
-struct PointLight
-{
-	vec3 position;
-	float intensity;
-	float distance;
-	
-	float constant;
-	float linear;
-	float quadratic;
-	
-	vec3 ambient;
-	vec3 diffuse;
-	vec3 specular;
-};
-
-#define NR_POINT_LIGHTS 4
-
-in vec3 FragPos;
-in vec3 Normal;
-in vec2 TexCoords;
-
-uniform vec3 viewPos;
-uniform DirLight dirLight;
-uniform PointLight pointLights[NR_POINT_LIGHTS];
-uniform Material material;
-
-vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
-
-void main()
-{
-	vec3 norm = normalize(Normal);
-	vec3 viewDir = normalize(viewPos - FragPos);
-	
-	vec3 result = CalcDirLight(dirLight, norm, viewDir);
-	for (int i = 0; i < NR_POINT_LIGHTS; i++)
-	{
-		result += CalcPointLight(pointLights[i], norm, FragPos, viewDir);
-	}
-	
-	FragColor = vec4(result, 1.0);
-}
-
-vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir)
-{
-	vec3 lightDir = normalize(-light.direction);
-	
-	//diffuse shading
-	float diff = max(dot(normal, lightDir), 0.0);
-	
-	//specular shading
-	vec3 reflectDir = reflect(-lightDir, normal);
-	float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-	
-	//combine results
-	vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-	vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-	vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
-	ambient *= light.intensity;
-	diffuse *= light.intensity;
-	specular *= light.intensity;
-	
-	return (ambient + diffuse + specular);
-}
-
-vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir)
-{
-	vec3 lightDir = normalize(light.position - fragPos);
-	
-	//diffuse shading
-	float diff = max(dot(normal, lightDir), 0.0);
-	
-	//specular shading
-	vec3 reflectDir = reflect(-lightDir, normal);
-	float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
-	
-	//attenuation
-	float distance = length(light.position - fragPos);
-	distance /= light.distance;
-	float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
-	
-	//combine results
-	vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-	vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-	vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
-	ambient *= attenuation * light.intensity;
-	diffuse *= attenuation * light.intensity;
-	specular *= attenuation * light.intensity;
-	
-	return (ambient + diffuse + specular);
-}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#version 330 core
+
+out vec4 FragColor;
+
+//directional light from the render snapshot
+uniform vec3 lightDirection;
+uniform vec3 lightColor;
+uniform float ambientStrength;
+
+const vec3 waterColor = vec3(0.12, 0.32, 0.7);
+const float waterAlpha = 0.6;
+
+void main()
+{
+	//surfaces are flat, lit as if facing straight up
+	float diff = max(-normalize(lightDirection).y, 0.0);
+	
+	vec3 result = waterColor * (ambientStrength + diff * lightColor);
+	
+	FragColor = vec4(result, waterAlpha);
+}
\ No newline at end of file
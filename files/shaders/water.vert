@@ -0,0 +1,18 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos;
+
+//per-instance
+layout(location = 1) in vec3 aCellMin;
+layout(location = 2) in float aHeight;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform float cellSize;
+
+void main()
+{
+	vec3 worldPos = aCellMin + vec3(aPos.x * cellSize, aHeight, aPos.z * cellSize);
+	
+	gl_Position = projection * view * vec4(worldPos, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <cstddef>
+
+//kalawindow
+#include "core/platform.hpp"
+
+//Counting replacements of the global operator new and delete, only compiled in
+//when CIRCUIT_ALLOC_TRACKING is defined, see the CIRCUIT_ALLOC_TRACKING CMake option.
+//Header only apart from the replacements, so the job system can tag its workers
+//without the tools linking the tracker.
+
+#define CIRCUIT_ALLOC_CONCAT_INNER(a, b) a##b
+#define CIRCUIT_ALLOC_CONCAT(a, b) CIRCUIT_ALLOC_CONCAT_INNER(a, b)
+
+#ifdef CIRCUIT_ALLOC_TRACKING
+#define ALLOC_SCOPE(tag) ::CircuitGame::Core::AllocScope CIRCUIT_ALLOC_CONCAT(allocScope, __LINE__)(tag)
+#define ALLOC_THREAD_TAG(tag) ::CircuitGame::Core::AllocTracker::SetThreadTag(tag)
+#else
+#define ALLOC_SCOPE(tag) ((void)0)
+#define ALLOC_THREAD_TAG(tag) ((void)0)
+#endif
+
+namespace CircuitGame::Core
+{
+	//Subsystem an allocation is counted for, set per thread and per scope
+	enum class AllocTag : u8
+	{
+		Tag_Untagged,
+		Tag_Game,   //Game thread outside any other scope
+		Tag_Window, //Window message pump and title
+		Tag_Input,  //Player input and hotkeys
+		Tag_Render, //Render snapshot and render thread
+		Tag_Jobs,   //Job system workers
+		Tag_Log,    //Async log writer, formats outside of any frame
+		TagCount
+	};
+
+	inline constexpr u32 ALLOC_TAG_COUNT = static_cast<u32>(AllocTag::TagCount);
+
+	inline const char* GetAllocTagName(AllocTag tag)
+	{
+		switch (tag)
+		{
+		case AllocTag::Tag_Untagged: return "untagged";
+		case AllocTag::Tag_Game:     return "game";
+		case AllocTag::Tag_Window:   return "window";
+		case AllocTag::Tag_Input:    return "input";
+		case AllocTag::Tag_Render:   return "render";
+		case AllocTag::Tag_Jobs:     return "jobs";
+		case AllocTag::Tag_Log:      return "log";
+		default:                     return "unknown";
+		}
+	}
+
+	struct AllocStats
+	{
+		u64 count{};
+		u64 bytes{};
+	};
+
+	class AllocTracker
+	{
+	public:
+		static constexpr bool IsEnabled()
+		{
+#ifdef CIRCUIT_ALLOC_TRACKING
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		static AllocTag GetThreadTag() { return threadTag; }
+		static void SetThreadTag(AllocTag tag) { threadTag = tag; }
+
+		//Called by operator new
+		static void RecordAllocation(size_t size);
+		static void RecordFree();
+
+		//Game thread, once per frame. Moves the counters of this frame to the last frame
+		//and checks the frame while the guard runs, discarded frames are not checked.
+		static void EndFrame(bool discard = false);
+
+		//Allocations of the last finished frame
+		static AllocStats GetFrameStats(AllocTag tag);
+		static AllocStats GetFrameTotal();
+
+		//Since program start
+		static u64 GetTotalAllocationCount();
+		static u64 GetTotalFreeCount();
+
+		//Steady state test, after warmupFrames every one of the next frameCount frames
+		//must not allocate outside Tag_Log. Each failing frame is logged with its tag breakdown.
+		static void StartGuard(
+			u32 warmupFrames,
+			u32 frameCount);
+		static bool IsGuarding() { return guardFramesLeft > 0; }
+
+		//Frames that allocated during the last guard run
+		static u32 GetGuardFailureCount() { return guardFailureCount; }
+	private:
+		static inline thread_local AllocTag threadTag{};
+
+		static inline u32 guardWarmupLeft{};
+		static inline u32 guardFramesLeft{};
+		static inline u32 guardFrameCount{};
+		static inline u32 guardFailureCount{};
+	};
+
+	//Counts allocations in the enclosing scope for this tag
+	class AllocScope
+	{
+	public:
+		explicit AllocScope(AllocTag tag)
+			: previous(AllocTracker::GetThreadTag())
+		{
+			AllocTracker::SetThreadTag(tag);
+		}
+
+		~AllocScope() { AllocTracker::SetThreadTag(previous); }
+
+		AllocScope(const AllocScope&) = delete;
+		AllocScope& operator=(const AllocScope&) = delete;
+	private:
+		AllocTag previous{};
+	};
+}
\ No newline at end of file
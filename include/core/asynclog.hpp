@@ -0,0 +1,65 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <atomic>
+#include <string_view>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CIRCUIT_PRINTF_FORMAT(formatIndex, firstArgument) __attribute__((format(printf, formatIndex, firstArgument)))
+#else
+#define CIRCUIT_PRINTF_FORMAT(formatIndex, firstArgument)
+#endif
+
+//kalawindow
+#include "core/log.hpp"
+
+namespace CircuitGame::Core
+{
+	using KalaWindow::Core::LogType;
+
+	using std::atomic;
+	using std::string_view;
+	using std::memory_order_acquire;
+
+	//Logger::Print for hot paths. Producers copy the message into a fixed size record
+	//of a lock-free multi producer ring and return, a background thread formats and writes it.
+	//Identical messages in a row are collapsed into one repeat count and any message
+	//printed more than ASYNC_LOG_RATE_LIMIT times per second is suppressed until the next second.
+	//The printed time stamp is the write time, usually well under a millisecond later.
+	class AsyncLog
+	{
+	public:
+		//Starts the writer thread, Print writes synchronously before this and after Shutdown
+		static bool Initialize();
+
+		static bool IsRunning() { return isRunning.load(memory_order_acquire); }
+
+		//Never blocks, messages longer than a record are cut
+		//and records are dropped while the ring is full
+		static void Print(
+			string_view message,
+			string_view target,
+			LogType type,
+			u32 indentation = 0);
+
+		//Formats into a stack buffer first, used by the LOGF macros in core/loglevel.hpp
+		static void PrintFormatted(
+			LogType type,
+			const char* target,
+			u32 indentation,
+			const char* format,
+			...) CIRCUIT_PRINTF_FORMAT(4, 5);
+
+		//Records lost to a full ring since Initialize
+		static u64 GetDroppedCount();
+
+		//Writes everything still queued and joins the writer thread
+		static void Shutdown();
+	private:
+		static inline atomic<bool> isRunning{};
+	};
+}
\ No newline at end of file
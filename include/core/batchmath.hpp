@@ -0,0 +1,112 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::Core
+{
+	enum class SIMDLevel : u8
+	{
+		SIMD_Scalar,
+		SIMD_SSE,  //4 objects per step, every x86-64 CPU
+		SIMD_AVX   //8 objects per step, picked when the CPU and OS support it
+	};
+
+	inline const char* GetSIMDLevelName(SIMDLevel level)
+	{
+		switch (level)
+		{
+		case SIMDLevel::SIMD_Scalar: return "scalar";
+		case SIMDLevel::SIMD_SSE:    return "sse";
+		case SIMDLevel::SIMD_AVX:    return "avx";
+		default:                     return "unknown";
+		}
+	}
+
+	//Structure of arrays inputs, entry i of every array belongs to object i.
+	//Rotations are unit quaternions.
+	struct TRSArrays
+	{
+		const f32* posX{};
+		const f32* posY{};
+		const f32* posZ{};
+		const f32* rotX{};
+		const f32* rotY{};
+		const f32* rotZ{};
+		const f32* rotW{};
+		const f32* scaleX{};
+		const f32* scaleY{};
+		const f32* scaleZ{};
+	};
+
+	struct Vec4Arrays
+	{
+		f32* x{};
+		f32* y{};
+		f32* z{};
+		f32* w{};
+	};
+
+	struct AABBArrays
+	{
+		f32* minX{};
+		f32* minY{};
+		f32* minZ{};
+		f32* maxX{};
+		f32* maxY{};
+		f32* maxZ{};
+	};
+
+	//Matrix math over whole arrays of objects instead of one glm call per object.
+	//The widest instruction set the CPU supports is picked at startup, results match glm
+	//up to float rounding. Outputs may alias inputs of the same layout.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries.
+	class BatchMath
+	{
+	public:
+		static SIMDLevel GetSIMDLevel();
+		static SIMDLevel GetSupportedSIMDLevel();
+
+		//Forces a narrower instruction set, used to compare them, returns false if the CPU lacks it
+		static bool SetSIMDLevel(SIMDLevel level);
+
+		//translate * rotate * scale, like the model matrix TransformSystem builds
+		static void ComposeTRS(
+			const TRSArrays& trs,
+			mat4* out,
+			u32 count);
+
+		//out[i] = left * right[i], like a view projection matrix applied to every model matrix
+		static void MultiplyMat4(
+			const mat4& left,
+			const mat4* right,
+			mat4* out,
+			u32 count);
+
+		//out[i] = left[i] * right[i]
+		static void MultiplyMat4(
+			const mat4* left,
+			const mat4* right,
+			mat4* out,
+			u32 count);
+
+		//out[i] = matrix * in[i]
+		static void TransformVec4(
+			const mat4& matrix,
+			const Vec4Arrays& in,
+			const Vec4Arrays& out,
+			u32 count);
+
+		//Smallest boxes around the transformed boxes
+		static void TransformAABB(
+			const mat4& matrix,
+			const AABBArrays& in,
+			const AABBArrays& out,
+			u32 count);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//kalawindow
+#include "core/platform.hpp"
+
+//Shared between the game and the Circuit_Chan_bench tool, must not depend on KalaWindow libraries.
+namespace CircuitGame::Core
+{
+	using std::size_t;
+	using std::max_align_t;
+	using std::vector;
+	using std::basic_string;
+	using std::char_traits;
+	using std::bad_alloc;
+	using std::forward;
+
+	//Linear allocator for data that lives for one frame, like render packets,
+	//visible lists, debug strings and job payloads.
+	//Every thread bumps a pointer in its own sub-arena, so allocating never locks.
+	//There are two sets of sub-arenas, one for this frame and one for the previous frame,
+	//so memory stays valid until the end of the frame after the one it was allocated in.
+	//Nothing is freed one by one, EndFrame resets a whole set with one pass over the threads.
+	//Only for the game thread and the jobs it waits for within the frame,
+	//the render thread runs on its own frames and must not allocate here.
+	class FrameArena
+	{
+	public:
+		//Any thread, returns nullptr only when the system is out of memory
+		static void* Allocate(
+			size_t size,
+			size_t alignment = alignof(max_align_t));
+
+		//Destructors never run, so only trivially destructible types
+		template<typename T, typename... Args> static T* New(Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "Frame arena objects are never destroyed!");
+
+			void* memory = Allocate(sizeof(T), alignof(T));
+			if (memory == nullptr) return nullptr;
+
+			return new (memory) T(forward<Args>(args)...);
+		}
+
+		//Game thread, once per frame while no job is running.
+		//Frees everything allocated in the frame before the one that just ended.
+		static void EndFrame();
+
+		static u64 GetFrameIndex() { return frameIndex; }
+
+		//Bytes allocated on all threads in the last finished frame
+		static size_t GetLastFrameBytes() { return lastFrameBytes; }
+
+		//Bytes reserved by both sets of sub-arenas
+		static size_t GetCapacity();
+
+		//Releases every block, nothing allocated from the arena may be used afterwards
+		static void Shutdown();
+	private:
+		static inline u64 frameIndex{};
+		static inline size_t lastFrameBytes{};
+	};
+
+	//STL allocator on top of FrameArena, deallocate does nothing
+	template<typename T> class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator() = default;
+		template<typename U> ArenaAllocator(const ArenaAllocator<U>&) {}
+
+		T* allocate(size_t count)
+		{
+			void* memory = FrameArena::Allocate(count * sizeof(T), alignof(T));
+			if (memory == nullptr) throw bad_alloc();
+
+			return static_cast<T*>(memory);
+		}
+
+		void deallocate(T*, size_t) {}
+
+		template<typename U> bool operator==(const ArenaAllocator<U>&) const { return true; }
+		template<typename U> bool operator!=(const ArenaAllocator<U>&) const { return false; }
+	};
+
+	template<typename T> using FrameVector = vector<T, ArenaAllocator<T>>;
+	using FrameString = basic_string<char, char_traits<char>, ArenaAllocator<char>>;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::Core
+{
+	//Caps the game loop to an exact frame interval when vsync is off.
+	//Sleeps while the remaining time is larger than the measured sleep overshoot,
+	//then spins on steady_clock for the rest so frames end on time without burning a core.
+	//On Windows sleeps use a high resolution waitable timer, or a 1ms system timer period
+	//where that timer does not exist, the default 15.6ms tick would miss every 144Hz slot.
+	class FrameLimiter
+	{
+	public:
+		//Sets up the sleep timer, call before the first Wait
+		static void Initialize();
+
+		//Restores the system timer period
+		static void Shutdown();
+
+		//Only caps while enabled, the game thread is always paced by the render thread presenting
+		static bool IsEnabled() { return isEnabled; }
+		static void SetEnabled(bool newEnabled);
+
+		//Frames per second, zero is uncapped
+		static f64 GetTargetRate() { return targetRate; }
+		static void SetTargetRate(f64 newTargetRate);
+
+		//Steps through 60, 144, 240 and uncapped
+		static void CycleTargetRate();
+
+		//Call once per frame, returns when the next frame interval starts
+		static void Wait();
+
+		//Smoothed absolute difference between the measured and the target frame interval, in milliseconds
+		static f64 GetJitter() { return jitter; }
+	private:
+		static inline bool isEnabled{};
+		static inline f64 targetRate = 144.0;
+		static inline f64 jitter{};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::Core
+{
+	//Everything that is timed per frame, all in milliseconds
+	enum class FrameMetric : u8
+	{
+		Metric_CPUFrame,  //BeginFrame to EndFrame on the game thread
+		Metric_GPUFrame,  //GPU time of one submitted frame, reported by the render thread
+		Metric_Events,    //Window message pump
+		Metric_Input,     //Player input and hotkeys
+		Metric_Snapshot,  //Filling and publishing the render snapshot
+		Metric_Limiter,   //Waiting for the render thread to present, then for the frame limiter
+		Metric_Submit,    //Render thread GL submission and swap, reported by the render thread
+		Metric_GPUClear,  //GPU time of each pass, in GPUPass order, reported by the render thread
+		Metric_GPUOpaque,
+		Metric_GPUTransparent,
+		Metric_GPUDebug,
+		Metric_GPUPost,
+		Metric_GPUUI,
+		MetricCount
+	};
+
+	inline constexpr u32 FRAME_METRIC_COUNT = static_cast<u32>(FrameMetric::MetricCount);
+
+	inline const char* GetFrameMetricName(FrameMetric metric)
+	{
+		switch (metric)
+		{
+		case FrameMetric::Metric_CPUFrame:       return "cpu_frame";
+		case FrameMetric::Metric_GPUFrame:       return "gpu_frame";
+		case FrameMetric::Metric_Events:         return "events";
+		case FrameMetric::Metric_Input:          return "input";
+		case FrameMetric::Metric_Snapshot:       return "snapshot";
+		case FrameMetric::Metric_Limiter:        return "limiter";
+		case FrameMetric::Metric_Submit:         return "submit";
+		case FrameMetric::Metric_GPUClear:       return "gpu_clear";
+		case FrameMetric::Metric_GPUOpaque:      return "gpu_opaque";
+		case FrameMetric::Metric_GPUTransparent: return "gpu_transparent";
+		case FrameMetric::Metric_GPUDebug:       return "gpu_debug";
+		case FrameMetric::Metric_GPUPost:        return "gpu_post";
+		case FrameMetric::Metric_GPUUI:          return "gpu_ui";
+		default:                                 return "unknown";
+		}
+	}
+
+	struct FrameMetricSummary
+	{
+		f32 p50{};
+		f32 p95{};
+		f32 p99{};
+		f32 max{};
+		u32 sampleCount{}; //Zero if nothing was reported in the window
+	};
+
+	//Rolling histograms over the last FRAME_STATS_WINDOW frames for every metric.
+	//The game thread owns the histograms, the render thread reports its timings
+	//through a lock-free single producer queue that is drained in EndFrame.
+	class FrameStats
+	{
+	public:
+		//Game thread side
+
+		static void BeginFrame();
+
+		//Time since BeginFrame or the previous EndStage goes to this metric
+		static void EndStage(FrameMetric metric);
+
+		//Discarded frames, like idle mode ticks, do not enter the statistics
+		static void EndFrame(bool discard = false);
+
+		//Index of the frame between BeginFrame and EndFrame, used to tag render thread reports
+		static u64 GetFrameIndex() { return frameIndex; }
+
+		static FrameMetricSummary GetSummary(FrameMetric metric);
+
+		//Frames in the window that took over twice the median CPU frame time
+		static u32 GetHitchCount() { return hitchCount; }
+		static u64 GetTotalHitchCount() { return totalHitchCount; }
+
+		//First call starts recording every frame, second call writes them to a CSV file
+		static void ToggleCapture();
+		static bool IsCapturing() { return isCapturing; }
+
+		//Render thread side, value for a frame that is still in the window
+		static void Report(
+			u64 reportFrameIndex,
+			FrameMetric metric,
+			f32 milliseconds);
+	private:
+		static inline u64 frameIndex{};
+		static inline u32 hitchCount{};
+		static inline u64 totalHitchCount{};
+		static inline bool isCapturing{};
+	};
+}
\ No newline at end of file
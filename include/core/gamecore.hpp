@@ -5,14 +5,11 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <vector>
 #include <memory>
 
 //kalawindow
 #include "graphics/window.hpp"
 
-#include "gameobjects/cube.hpp"
 #include "graphics/camera.hpp"
 
 namespace CircuitGame::Core
@@ -20,31 +17,24 @@ namespace CircuitGame::Core
 	using KalaWindow::Graphics::Window;
 
 	using CircuitGame::Graphics::Camera;
-	using CircuitGame::GameObjects::Cube;
 
-	using std::unordered_map;
-	using std::vector;
 	using std::unique_ptr;
 
 	//
 	// INIT STAGE DATA
 	//
 
-	extern unordered_map<u32, unique_ptr<Cube>> createdCubes;
 	extern unique_ptr<Camera> createdCamera;
 	extern Window* mainWindow;
 
-	//
-	// RUNTIME STAGE DATA
-	//
-
-	extern vector<Cube*> runtimeCubes;
-
 	class Game
 	{
 	public:
-		//Initializes all parts of this program
-		static void Initialize();
+		//Initializes all parts of this program.
+		//--profile-startup starts a profiler capture before anything loads.
+		static void Initialize(
+			int argc,
+			char* argv[]);
 
 		//Unmodified, raw frame time as measured by the clock
 		static f64 GetFrameTime() { return frameTime; }
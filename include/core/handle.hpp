@@ -0,0 +1,117 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::Core
+{
+	using std::vector;
+
+	inline constexpr u32 HANDLE_INDEX_BITS = 20;
+	inline constexpr u32 HANDLE_INDEX_MASK = (1u << HANDLE_INDEX_BITS) - 1;
+	inline constexpr u32 HANDLE_GENERATION_MASK = (1u << (32 - HANDLE_INDEX_BITS)) - 1;
+
+	//Up to about a million live objects of one type, the last index is reserved for invalid handles
+	inline constexpr u32 HANDLE_MAX_INDEX = HANDLE_INDEX_MASK - 1;
+
+	//32-bit reference to an engine object, slot index in the low bits and slot generation in the high bits.
+	//A handle to a destroyed object keeps its old generation, so it is detected as stale
+	//instead of reaching whatever reused the slot. Tag only keeps handles of different types apart.
+	template<typename Tag> struct Handle
+	{
+		u32 value = 0xFFFFFFFFu;
+
+		static constexpr Handle Make(u32 index, u32 generation)
+		{
+			return Handle{ (generation << HANDLE_INDEX_BITS) | (index & HANDLE_INDEX_MASK) };
+		}
+
+		constexpr u32 GetIndex() const { return value & HANDLE_INDEX_MASK; }
+		constexpr u32 GetGeneration() const { return value >> HANDLE_INDEX_BITS; }
+
+		constexpr bool IsValid() const { return value != 0xFFFFFFFFu; }
+
+		constexpr bool operator==(const Handle&) const = default;
+	};
+
+	//Hands out handles and tells live ones from stale ones, the slot map side of an object type.
+	//The objects themselves live in arrays indexed by GetIndex, sized with GetSlotCount.
+	//IsAlive only reads, so any number of threads may check handles
+	//as long as nothing is created or destroyed at the same time.
+	template<typename Tag> class HandleSlots
+	{
+	public:
+		//Reuses destroyed slots before growing, returns an invalid handle once every index is used
+		Handle<Tag> Create()
+		{
+			u32 index{};
+			if (!freeSlots.empty())
+			{
+				index = freeSlots.back();
+				freeSlots.pop_back();
+			}
+			else
+			{
+				if (generations.size() > HANDLE_MAX_INDEX) return Handle<Tag>{};
+
+				index = static_cast<u32>(generations.size());
+				generations.push_back(0);
+				alive.push_back(false);
+			}
+
+			alive[index] = true;
+			++aliveCount;
+
+			return Handle<Tag>::Make(index, generations[index]);
+		}
+
+		//Every handle to this slot becomes stale
+		void Destroy(Handle<Tag> handle)
+		{
+			if (!IsAlive(handle)) return;
+
+			u32 index = handle.GetIndex();
+			alive[index] = false;
+			generations[index] = (generations[index] + 1) & HANDLE_GENERATION_MASK;
+			freeSlots.push_back(index);
+			--aliveCount;
+		}
+
+		bool IsAlive(Handle<Tag> handle) const
+		{
+			u32 index = handle.GetIndex();
+			return index < generations.size()
+				&& alive[index]
+				&& generations[index] == handle.GetGeneration();
+		}
+
+		//Destroys every live handle, slots and their memory are kept for reuse
+		void Clear()
+		{
+			freeSlots.clear();
+			for (u32 index = static_cast<u32>(generations.size()); index-- > 0; )
+			{
+				if (alive[index]) generations[index] = (generations[index] + 1) & HANDLE_GENERATION_MASK;
+
+				alive[index] = false;
+				freeSlots.push_back(index);
+			}
+			aliveCount = 0;
+		}
+
+		u32 GetAliveCount() const { return aliveCount; }
+		u32 GetSlotCount() const { return static_cast<u32>(generations.size()); }
+	private:
+		vector<u32> generations{};
+		vector<u8> alive{};
+		vector<u32> freeSlots{};
+		u32 aliveCount{};
+	};
+}
\ No newline at end of file
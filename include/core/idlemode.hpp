@@ -0,0 +1,41 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "graphics/window.hpp"
+
+namespace CircuitGame::Core
+{
+	using KalaWindow::Graphics::Window;
+
+	//Keeps the game loop from spinning while the window is unfocused or minimized.
+	//The loop sleeps on window events instead and only runs the simulation at a low rate.
+	class IdleMode
+	{
+	public:
+		//Blocks until a window event arrives or the next idle tick is due,
+		//returns true if the idle tick is due and the simulation should run.
+		//Leaves idle mode right away if the window is not idle anymore.
+		static bool Wait(Window* window);
+
+		static bool IsActive() { return isActive; }
+
+		//Simulation ticks per second while idle
+		static f64 GetIdleRate() { return idleRate; }
+		static void SetIdleRate(f64 newIdleRate) { idleRate = newIdleRate; }
+
+		//Process CPU time over wall time of the last idle period, 100 is one full core
+		static f64 GetIdleCPUUsage() { return idleCPUUsage; }
+
+		//Logs how long the window was idle and the CPU it used meanwhile
+		static void Exit();
+	private:
+		static inline bool isActive{};
+		static inline f64 idleRate = 10.0;
+		static inline f64 idleCPUUsage{};
+	};
+}
\ No newline at end of file
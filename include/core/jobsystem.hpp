@@ -0,0 +1,98 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <atomic>
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "core/profiler.hpp"
+
+//Shared between the game and the Circuit_Chan_bench tool, must not depend on KalaWindow libraries.
+namespace CircuitGame::Core
+{
+	using std::atomic;
+
+	//Runs the [begin, end) part of a job, data is owned by the caller
+	using JobFunction = void (*)(void* data, u32 begin, u32 end);
+
+	//Number of submitted jobs that have not finished yet
+	struct JobCounter
+	{
+		atomic<u32> pending{};
+
+		bool IsDone() const { return pending.load() == 0; }
+	};
+
+	struct JobDesc
+	{
+		JobFunction function{};
+		void* data{};
+		u32 begin{};
+		u32 end = 1;
+
+		//The job is not started before this counter reaches zero
+		const JobCounter* dependency{};
+
+		//Zone name in profiler captures
+		const char* name = "Job";
+	};
+
+	//Work-stealing scheduler, every worker owns a Chase-Lev deque and
+	//steals from the others when its own deque runs dry.
+	//The thread that calls Initialize is worker 0 and only runs jobs while waiting.
+	class JobSystem
+	{
+	public:
+		//Zero worker count uses the hardware concurrency
+		static bool Initialize(u32 workerCount = 0);
+
+		static bool IsInitialized() { return isInitialized; }
+
+		//Includes the calling thread
+		static u32 GetWorkerCount() { return workerCount; }
+
+		//Adds one job, counter is incremented now and decremented when the job finishes
+		static void Submit(
+			const JobDesc& job,
+			JobCounter* counter);
+
+		//Runs other jobs until the counter reaches zero
+		static void Wait(const JobCounter& counter);
+
+		//Splits [0, count) into jobs of at most grainSize items and waits for all of them
+		static void ParallelFor(
+			u32 count,
+			u32 grainSize,
+			JobFunction function,
+			void* data,
+			const char* name = "ParallelFor");
+
+		template<typename Func> static void ParallelFor(
+			u32 count,
+			u32 grainSize,
+			const Func& function,
+			const char* name = "ParallelFor")
+		{
+			ParallelFor(
+				count,
+				grainSize,
+				[](void* data, u32 begin, u32 end)
+				{
+					(*static_cast<const Func*>(data))(begin, end);
+				},
+				const_cast<Func*>(&function),
+				name);
+		}
+
+		//Finishes queued jobs and joins all workers
+		static void Shutdown();
+	private:
+		static inline bool isInitialized{};
+		static inline u32 workerCount{};
+	};
+}
\ No newline at end of file
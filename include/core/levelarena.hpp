@@ -0,0 +1,64 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::Core
+{
+	using std::size_t;
+	using std::max_align_t;
+	using std::string_view;
+	using std::forward;
+
+	//Linear allocator for everything a level owns, like blocks and their names.
+	//Nothing is freed one by one, Reset releases the whole level at once
+	//and the next level is placed in the same memory. Game thread only.
+	class LevelArena
+	{
+	public:
+		//Reserves the first block, the arena grows past it if a level needs more
+		static bool Initialize(size_t capacity);
+
+		//Returns nullptr only when the system is out of memory
+		static void* Allocate(
+			size_t size,
+			size_t alignment = alignof(max_align_t));
+
+		//Destructors never run, so only trivially destructible types
+		template<typename T, typename... Args> static T* New(Args&&... args)
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "Level arena objects are never destroyed!");
+
+			void* memory = Allocate(sizeof(T), alignof(T));
+			if (memory == nullptr) return nullptr;
+
+			return new (memory) T(forward<Args>(args)...);
+		}
+
+		//Null terminated copy that lives as long as the level
+		static const char* CopyString(string_view text);
+
+		//Releases everything allocated since the last reset, every pointer into the arena becomes invalid
+		static void Reset();
+
+		//Bytes allocated by the current level
+		static size_t GetUsedBytes();
+
+		//Bytes reserved for levels
+		static size_t GetCapacity();
+
+		//Frees the reserved memory
+		static void Shutdown();
+	};
+}
\ No newline at end of file
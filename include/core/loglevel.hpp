@@ -0,0 +1,66 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/log.hpp"
+
+#include "core/asynclog.hpp"
+
+//Lowest severity that is compiled in, set by the CIRCUIT_LOG_LEVEL CMake cache variable:
+//0 debug, 1 info, 2 success, 3 warning, 4 error
+#ifndef CIRCUIT_LOG_LEVEL
+#ifdef _DEBUG
+#define CIRCUIT_LOG_LEVEL 0
+#else
+#define CIRCUIT_LOG_LEVEL 1
+#endif
+#endif
+
+//printf style logging through AsyncLog. Below the threshold the whole statement
+//is discarded at compile time, so the arguments are never evaluated.
+//Above it the message is formatted into a stack buffer, no strings are concatenated.
+//Errors are indented by 2 like every other error log.
+
+#define CIRCUIT_LOGF(type, target, indentation, ...) \
+	do \
+	{ \
+		if constexpr (::CircuitGame::Core::IsLogLevelEnabled(type)) \
+		{ \
+			::CircuitGame::Core::AsyncLog::PrintFormatted(type, target, indentation, __VA_ARGS__); \
+		} \
+	} while (false)
+
+#define LOGF_DEBUG(target, ...)   CIRCUIT_LOGF(::KalaWindow::Core::LogType::LOG_DEBUG, target, 0, __VA_ARGS__)
+#define LOGF_INFO(target, ...)    CIRCUIT_LOGF(::KalaWindow::Core::LogType::LOG_INFO, target, 0, __VA_ARGS__)
+#define LOGF_SUCCESS(target, ...) CIRCUIT_LOGF(::KalaWindow::Core::LogType::LOG_SUCCESS, target, 0, __VA_ARGS__)
+#define LOGF_WARNING(target, ...) CIRCUIT_LOGF(::KalaWindow::Core::LogType::LOG_WARNING, target, 0, __VA_ARGS__)
+#define LOGF_ERROR(target, ...)   CIRCUIT_LOGF(::KalaWindow::Core::LogType::LOG_ERROR, target, 2, __VA_ARGS__)
+
+namespace CircuitGame::Core
+{
+	using KalaWindow::Core::LogType;
+
+	inline constexpr u32 LOG_LEVEL = CIRCUIT_LOG_LEVEL;
+
+	constexpr u32 GetLogLevel(LogType type)
+	{
+		switch (type)
+		{
+		case LogType::LOG_DEBUG:   return 0;
+		case LogType::LOG_INFO:    return 1;
+		case LogType::LOG_SUCCESS: return 2;
+		case LogType::LOG_WARNING: return 3;
+		case LogType::LOG_ERROR:   return 4;
+		default:                   return 4;
+		}
+	}
+
+	constexpr bool IsLogLevelEnabled(LogType type)
+	{
+		return GetLogLevel(type) >= LOG_LEVEL;
+	}
+}
\ No newline at end of file
@@ -5,11 +5,26 @@
 
 #pragma once
 
+#include "world/chunkstore.hpp"
+
 namespace CircuitGame::Core
 {
+	using CircuitGame::World::RaycastHit;
+
 	class PlayerInput
 	{
 	public:
+		//Reads the keys and mouse once per frame, movement itself waits for FixedUpdate
 		static void HandleInput();
+
+		//Moves the player by one fixed timestep through the block grid
+		static void FixedUpdate(f32 fixedDelta);
+
+		//Places the camera between the last two fixed steps, blend is how far into the next step this frame is
+		static void UpdateCamera(f32 blend);
+
+		//Grid cell the camera looks at this frame, false if nothing is within reach
+		//or the camera is not controlled by the player
+		static bool GetTarget(RaycastHit& outHit);
 	};
 }
\ No newline at end of file
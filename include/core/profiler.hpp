@@ -0,0 +1,117 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#if defined(_M_X64) || defined(__x86_64__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#include <chrono>
+#endif
+
+//kalawindow
+#include "core/platform.hpp"
+
+//Shared between the game and the Circuit_Chan_bench tool, must not depend on KalaWindow libraries.
+//Zones only exist when CIRCUIT_PROFILER_ENABLED is defined, see the CIRCUIT_PROFILER CMake option.
+//Zone names must outlive the capture, string literals are the usual choice.
+
+#define CIRCUIT_PROFILE_CONCAT_INNER(a, b) a##b
+#define CIRCUIT_PROFILE_CONCAT(a, b) CIRCUIT_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef CIRCUIT_PROFILER_ENABLED
+#define PROFILE_ZONE(name) ::CircuitGame::Core::ProfileZone CIRCUIT_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) ::CircuitGame::Core::Profiler::SetThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+namespace CircuitGame::Core
+{
+	using std::atomic;
+	using std::string;
+	using std::memory_order_relaxed;
+
+	//Raw CPU timestamp, converted to microseconds only when a capture is written
+	inline u64 ReadProfilerTimestamp()
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		return __rdtsc();
+#else
+		return static_cast<u64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+	}
+
+	class Profiler
+	{
+	public:
+		//Records zones on every thread for the next frameCount frames
+		static void BeginCapture(u32 frameCount);
+
+		static bool IsCapturing() { return isCapturing.load(memory_order_relaxed); }
+
+		//Call once per game frame, returns true on the frame the capture finished
+		static bool EndFrame();
+
+		//Writes the finished capture as a Chrome trace-event file, returns false if it could not be written.
+		//Waits for threads still appending a zone, so it may be called while they keep running.
+		static bool WriteCapture(const string& filePath);
+
+		//Names the calling thread in captures
+		static void SetThreadName(const char* name);
+
+		//Called by ProfileZone, appends to the ring buffer of the calling thread.
+		//Zones that end after the capture has ended are dropped.
+		static void Record(
+			const char* name,
+			u64 begin,
+			u64 end);
+
+		//Timeline that is not tied to a thread, like the GPU, shown next to the thread timelines.
+		//Only one thread may record to a track.
+		static u32 CreateTrack(const char* name);
+
+		static void RecordOnTrack(
+			u32 track,
+			const char* name,
+			u64 begin,
+			u64 end);
+
+		//Converts a duration measured elsewhere to timestamp ticks, zero outside a capture
+		static u64 NanosecondsToTicks(u64 nanoseconds);
+	private:
+		static inline atomic<bool> isCapturing{};
+	};
+
+	class ProfileZone
+	{
+	public:
+		explicit ProfileZone(const char* newName)
+		{
+			if (!Profiler::IsCapturing()) return;
+
+			name = newName;
+			begin = ReadProfilerTimestamp();
+		}
+
+		~ProfileZone()
+		{
+			if (name != nullptr) Profiler::Record(name, begin, ReadProfilerTimestamp());
+		}
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+	private:
+		const char* name{};
+		u64 begin{};
+	};
+}
\ No newline at end of file
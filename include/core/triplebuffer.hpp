@@ -0,0 +1,59 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <atomic>
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::Core
+{
+	using std::atomic;
+	using std::memory_order_acq_rel;
+	using std::memory_order_acquire;
+
+	//Lock-free single producer, single consumer hand-off of whole values.
+	//The producer always owns one slot, the consumer owns one slot
+	//and the third slot is exchanged between them with one atomic swap,
+	//so neither side ever waits for the other to finish with a slot.
+	template<typename T> class TripleBuffer
+	{
+	public:
+		//Producer side, the slot to fill for the next publish
+		T& GetWriteBuffer() { return buffers[writeIndex]; }
+
+		//Producer side, hands the write slot to the consumer and takes the shared one back
+		void Publish()
+		{
+			u32 previous = shared.exchange(writeIndex | DIRTY_BIT, memory_order_acq_rel);
+			writeIndex = previous & INDEX_MASK;
+		}
+
+		//Consumer side, swaps in the newest published slot.
+		//Returns false if nothing was published since the last acquire.
+		bool Acquire()
+		{
+			if ((shared.load(memory_order_acquire) & DIRTY_BIT) == 0) return false;
+
+			u32 previous = shared.exchange(readIndex, memory_order_acq_rel);
+			readIndex = previous & INDEX_MASK;
+			return true;
+		}
+
+		//Consumer side, the most recently acquired slot
+		const T& GetReadBuffer() const { return buffers[readIndex]; }
+	private:
+		static constexpr u32 DIRTY_BIT = 0x4;
+		static constexpr u32 INDEX_MASK = 0x3;
+
+		T buffers[3]{};
+
+		u32 writeIndex = 0;      //Only touched by the producer
+		u32 readIndex = 1;       //Only touched by the consumer
+		atomic<u32> shared = 2;  //Exchanged between both, with a dirty bit
+	};
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <string>
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::GameObjects
+{
+	using std::string;
+
+	//Every placeable circuit block, the value doubles as the block texture array layer
+	enum class BlockType : u8
+	{
+		//power blocks
+
+		Wire,
+		LayerSocket,
+		Repeater,
+		PowerSwitch,
+		SplitSwitch,
+		Delay,
+		Inverter,
+
+		//state blocks
+
+		Activator,
+		Memory,
+
+		//special
+
+		OneWaySocket,
+		PassthroughSocket,
+
+		BlockTypeCount
+	};
+
+	inline constexpr u32 BLOCK_TYPE_COUNT = static_cast<u32>(BlockType::BlockTypeCount);
+
+	//Returns the file name stem used for this block type's assets
+	inline string GetBlockTypeName(BlockType type)
+	{
+		switch (type)
+		{
+		case BlockType::Wire:
+			return "wire";
+		case BlockType::LayerSocket:
+			return "layer_socket";
+		case BlockType::Repeater:
+			return "repeater";
+		case BlockType::PowerSwitch:
+			return "power_switch";
+		case BlockType::SplitSwitch:
+			return "split_switch";
+		case BlockType::Delay:
+			return "delay";
+		case BlockType::Inverter:
+			return "inverter";
+		case BlockType::Activator:
+			return "activator";
+		case BlockType::Memory:
+			return "memory";
+		case BlockType::OneWaySocket:
+			return "one_way_socket";
+		case BlockType::PassthroughSocket:
+			return "passthrough_socket";
+		case BlockType::BlockTypeCount:
+			break;
+		}
+
+		return "";
+	}
+
+	//Tint of the shared cube texture for block types that have no texture of their own yet,
+	//the game and the Circuit_Chan_cook tool must tint the same way
+	inline vec3 GetBlockFallbackTint(BlockType type)
+	{
+		switch (type)
+		{
+		case BlockType::Wire:
+			return vec3(0.85f, 0.20f, 0.20f);
+		case BlockType::LayerSocket:
+			return vec3(0.90f, 0.55f, 0.15f);
+		case BlockType::Repeater:
+			return vec3(0.95f, 0.85f, 0.20f);
+		case BlockType::PowerSwitch:
+			return vec3(0.30f, 0.80f, 0.30f);
+		case BlockType::SplitSwitch:
+			return vec3(0.20f, 0.75f, 0.70f);
+		case BlockType::Delay:
+			return vec3(0.25f, 0.45f, 0.90f);
+		case BlockType::Inverter:
+			return vec3(0.55f, 0.30f, 0.85f);
+		case BlockType::Activator:
+			return vec3(0.90f, 0.35f, 0.70f);
+		case BlockType::Memory:
+			return vec3(0.60f, 0.60f, 0.60f);
+		case BlockType::OneWaySocket:
+			return vec3(0.95f, 0.95f, 0.95f);
+		case BlockType::PassthroughSocket:
+			return vec3(0.35f, 0.35f, 0.35f);
+		case BlockType::BlockTypeCount:
+			break;
+		}
+
+		return vec3(1.0f);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <span>
+#include <utility>
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "core/handle.hpp"
+
+namespace CircuitGame::GameObjects
+{
+	using std::vector;
+	using std::span;
+	using std::move;
+
+	using CircuitGame::Core::Handle;
+
+	struct EntityTag {};
+	using Entity = Handle<EntityTag>;
+
+	inline constexpr Entity INVALID_ENTITY{};
+
+	//Sparse set of one component type.
+	//Components are packed back to back in the dense array so systems iterate them without gaps,
+	//the sparse array maps an entity slot index to its dense index for lookups.
+	//A stale handle to a reused slot does not match the stored entity and finds nothing.
+	//Removing swaps the last component into the hole, so dense order is not stable.
+	//Lookups only read, adding and removing must not overlap with them.
+	template<typename T> class ComponentArray
+	{
+	public:
+		//Overwrites the component if the entity already has one
+		T& Add(Entity entity, const T& component = T{})
+		{
+			u32 slot = entity.GetIndex();
+			if (slot >= sparse.size()) sparse.resize(slot + 1, INVALID_INDEX);
+
+			u32& index = sparse[slot];
+			if (index != INVALID_INDEX
+				&& entities[index] == entity)
+			{
+				components[index] = component;
+				return components[index];
+			}
+
+			index = static_cast<u32>(components.size());
+			entities.push_back(entity);
+			components.push_back(component);
+
+			return components.back();
+		}
+
+		void Remove(Entity entity)
+		{
+			if (!Has(entity)) return;
+
+			u32 index = sparse[entity.GetIndex()];
+			u32 last = static_cast<u32>(components.size()) - 1;
+
+			if (index != last)
+			{
+				components[index] = move(components[last]);
+				entities[index] = entities[last];
+				sparse[entities[index].GetIndex()] = index;
+			}
+
+			components.pop_back();
+			entities.pop_back();
+			sparse[entity.GetIndex()] = INVALID_INDEX;
+		}
+
+		bool Has(Entity entity) const
+		{
+			u32 slot = entity.GetIndex();
+			return slot < sparse.size()
+				&& sparse[slot] != INVALID_INDEX
+				&& entities[sparse[slot]] == entity;
+		}
+
+		//Returns nullptr if the entity has no such component
+		T* Get(Entity entity)
+		{
+			return Has(entity) ? &components[sparse[entity.GetIndex()]] : nullptr;
+		}
+		const T* Get(Entity entity) const
+		{
+			return Has(entity) ? &components[sparse[entity.GetIndex()]] : nullptr;
+		}
+
+		u32 GetSize() const { return static_cast<u32>(components.size()); }
+
+		//Dense arrays, entry i of both belongs to the same entity
+		span<T> GetComponents() { return components; }
+		span<const T> GetComponents() const { return components; }
+		span<const Entity> GetEntities() const { return entities; }
+
+		void Reserve(u32 count)
+		{
+			entities.reserve(count);
+			components.reserve(count);
+		}
+
+		//Keeps the capacity for the next level
+		void Clear()
+		{
+			for (Entity entity : entities) sparse[entity.GetIndex()] = INVALID_INDEX;
+
+			entities.clear();
+			components.clear();
+		}
+	private:
+		static constexpr u32 INVALID_INDEX = 0xFFFFFFFFu;
+
+		vector<u32> sparse{};
+		vector<Entity> entities{};
+		vector<T> components{};
+	};
+}
\ No newline at end of file
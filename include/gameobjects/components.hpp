@@ -0,0 +1,118 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//glm
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/blocktype.hpp"
+#include "gameobjects/componentarray.hpp"
+#include "core/handle.hpp"
+
+namespace CircuitGame::World
+{
+	//defined with the broadphase, debris only stores the handle
+	struct ProxyTag;
+	using Proxy = CircuitGame::Core::Handle<ProxyTag>;
+}
+
+namespace CircuitGame::GameObjects
+{
+	//Components are plain data, systems that read them live elsewhere.
+	//Keep them small, every byte is paid for on each iteration of its array.
+
+	struct NameComponent
+	{
+		const char* name = ""; //Points into the level arena
+	};
+
+	//Written through TransformSystem so the cached matrices follow,
+	//position, rotation and scale are relative to the parent
+	struct TransformComponent
+	{
+		vec3 pos{};
+		vec3 rot{}; //Euler angles in degrees
+		vec3 scale = vec3(1.0f);
+
+		mat4 local = mat4(1.0f); //World and normal matrices live in TransformSystem
+
+		Entity parent{};
+		Entity firstChild{};
+		Entity nextSibling{};
+		Entity previousSibling{};
+
+		u16 depth{}; //Zero for roots
+		bool isDirty{};
+	};
+
+	struct RenderComponent
+	{
+		BlockType blockType{};
+		bool isVisible = true;
+	};
+
+	//Power level a source block puts out
+	inline constexpr u8 MAX_POWER_LEVEL = 255;
+
+	//Every placed block has one, power switches are the sources.
+	//Nothing conducts power yet, so a source is powered unless water shorts it and other blocks stay unpowered.
+	struct CircuitComponent
+	{
+		u8 powerLevel{};
+		bool isPowered{};
+		bool isSource{};
+		bool isShorted{}; //Water stands next to the block, WaterSystem keeps it unpowered until that is gone
+	};
+
+	struct TriggerComponent
+	{
+		vec3 halfExtents = vec3(0.5f);
+		bool isTriggered{};
+	};
+
+	//Falling box simulated by DebrisSystem, which writes its pose back into the transform
+	struct DebrisComponent
+	{
+		glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+		vec3 pos{};
+		vec3 velocity{};
+		vec3 angularVelocity{};
+		vec3 halfExtents = vec3(0.5f);
+
+		f32 inverseMass = 1.0f;
+		vec3 inverseInertia{}; //Along the box axes, a box has no products of inertia
+
+		CircuitGame::World::Proxy proxy{};
+		f32 restTime{};        //Seconds spent slower than the sleep thresholds
+		bool isSleeping{};
+	};
+
+	//Placed block standing on the grid, SupportSystem removes it once nothing holds it up
+	struct SupportComponent
+	{
+		glm::ivec3 minCell{};
+		glm::ivec3 maxCell{}; //Inclusive
+		bool isAnchored{};    //Built into the level, stays even without ground under it
+		bool canRestOnWire{}; //Layer sockets may be placed on wires, which hold up nothing else
+	};
+
+	//Builds the model matrix from position, rotation and scale
+	inline mat4 GetModelMatrix(
+		const vec3& pos,
+		const vec3& rot,
+		const vec3& scale)
+	{
+		mat4 model = glm::translate(mat4(1.0f), pos);
+		model *= glm::mat4_cast(glm::quat(glm::radians(rot)));
+		model = glm::scale(model, scale);
+
+		return model;
+	}
+}
\ No newline at end of file
@@ -7,35 +7,26 @@
 
 #include <string>
 
-//kalawindow
-#include "graphics/opengl/texture_opengl.hpp"
-
-#include "gameobjects/gameobject.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "gameobjects/blocktype.hpp"
 
 namespace CircuitGame::GameObjects
 {
 	using std::string;
 
-	//kalawindow
-	using KalaWindow::Graphics::OpenGL::Texture_OpenGL;
-
-	class Cube : public GameObject
+	//Creates block entities, they are drawn through BlockBatch
+	class Cube
 	{
 	public:
-		static Cube* Initialize(
+		//Entity with a name, transform, render and circuit component placed in the block grid,
+		//the name is placed in the level arena and released by LevelArena::Reset.
+		//An anchored block stays without ground under it, for blocks fixed to walls or ceilings by the level.
+		static Entity Initialize(
 			const string& name,
 			const vec3& pos = vec3(0),
 			const vec3& rot = vec3(0),
-			const vec3& scale = vec3(1));
-
-		const Texture_OpenGL* GetTexture() { return texture; }
-		void SetTexture(Texture_OpenGL* newTexture) { texture = newTexture; }
-
-		bool Render(
-			const mat4& view,
-			const mat4& projection) override;
-		~Cube() override;
-	private:
-		Texture_OpenGL* texture{};
+			const vec3& scale = vec3(1),
+			BlockType blockType = BlockType::Wire,
+			bool isAnchored = false);
 	};
 }
\ No newline at end of file
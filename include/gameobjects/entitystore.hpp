@@ -0,0 +1,59 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/componentarray.hpp"
+#include "gameobjects/components.hpp"
+
+namespace CircuitGame::GameObjects
+{
+	//Every object of the level is an entity handle with components in dense per type arrays.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries.
+	//Creating, destroying and adding components is game thread only and never happens while jobs run,
+	//so during a frame worker threads may look up handles and read components freely.
+	class EntityStore
+	{
+	public:
+		//Reuses slots of destroyed entities before handing out new ones,
+		//returns INVALID_ENTITY once every slot is in use
+		static Entity Create();
+
+		//Queued until EndFrame so handles read this frame stay valid until every job is done
+		static void Destroy(Entity entity);
+
+		//Removes the components of entities destroyed this frame, their handles become stale
+		static void EndFrame();
+
+		//False for handles of destroyed entities, even once their slot is reused
+		static bool IsAlive(Entity entity);
+
+		//Entities currently alive
+		static u32 GetCount();
+
+		//Destroys every entity at once, used when a level is unloaded.
+		//Handles from before the call are stale afterwards.
+		static void Clear();
+
+		static ComponentArray<NameComponent>& GetNames() { return names; }
+		static ComponentArray<TransformComponent>& GetTransforms() { return transforms; }
+		static ComponentArray<RenderComponent>& GetRenders() { return renders; }
+		static ComponentArray<CircuitComponent>& GetCircuits() { return circuits; }
+		static ComponentArray<TriggerComponent>& GetTriggers() { return triggers; }
+		static ComponentArray<DebrisComponent>& GetDebris() { return debris; }
+		static ComponentArray<SupportComponent>& GetSupports() { return supports; }
+	private:
+		static inline ComponentArray<NameComponent> names{};
+		static inline ComponentArray<TransformComponent> transforms{};
+		static inline ComponentArray<RenderComponent> renders{};
+		static inline ComponentArray<CircuitComponent> circuits{};
+		static inline ComponentArray<TriggerComponent> triggers{};
+		static inline ComponentArray<DebrisComponent> debris{};
+		static inline ComponentArray<SupportComponent> supports{};
+	};
+}
\ No newline at end of file
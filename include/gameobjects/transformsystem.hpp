@@ -0,0 +1,72 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/componentarray.hpp"
+#include "gameobjects/components.hpp"
+
+namespace CircuitGame::GameObjects
+{
+	//What Update writes for one transform. Kept out of TransformComponent
+	//so the render gather only walks matrices and the hierarchy walk only walks links,
+	//stored at the same dense index as the transform so one sparse lookup finds both.
+	struct TransformMatrices
+	{
+		mat4 world = mat4(1.0f);
+
+		//Inverse transpose of the world rotation and scale, only kept up to date when not rigid,
+		//rigid transforms only rotate and scale all axes the same, so the world matrix itself is enough
+		mat3 normal = mat3(1.0f);
+		bool isRigid = true;
+	};
+
+	//Keeps the local and world matrices of every transform cached.
+	//Setters only flag a transform when its value really changes,
+	//Update then rebuilds the flagged transforms and the world matrices below them in one pass,
+	//so a level where nothing moves costs nothing per frame.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries. Game thread only.
+	class TransformSystem
+	{
+	public:
+		//Adds a root transform to the entity, its matrices are valid after the next Update
+		static TransformComponent* Add(
+			Entity entity,
+			const vec3& pos = vec3(0),
+			const vec3& rot = vec3(0),
+			const vec3& scale = vec3(1));
+
+		//Returns nullptr if the entity has no transform, valid after the next Update
+		static const TransformMatrices* GetMatrices(Entity entity);
+
+		//Entry i belongs to entry i of the dense transform array
+		static span<const TransformMatrices> GetAllMatrices();
+
+		static void SetPos(Entity entity, const vec3& pos);
+		static void SetRot(Entity entity, const vec3& rot);
+		static void SetScale(Entity entity, const vec3& scale);
+
+		//Attaches the child below the parent, INVALID_ENTITY makes it a root again.
+		//The child keeps its local values, so it moves with the parent from now on.
+		//Returns false if either has no transform or the parent is inside the child's subtree.
+		static bool SetParent(Entity child, Entity parent);
+
+		//Detaches the entity from its parent and turns its children into roots,
+		//called before its transform component is removed
+		static void Remove(Entity entity);
+
+		//Rebuilds every flagged transform and the world matrices of its subtree, parents first
+		static void Update();
+
+		//Transforms waiting for the next Update
+		static u32 GetDirtyCount();
+
+		//Forgets flagged transforms, used when every entity is cleared at once
+		static void Clear();
+	};
+}
\ No newline at end of file
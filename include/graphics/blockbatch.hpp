@@ -0,0 +1,59 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/blocktype.hpp"
+
+namespace CircuitGame::Graphics
+{
+	using CircuitGame::GameObjects::BlockType;
+
+	//Per-instance data of a rigid block, layout matches block.vert.
+	//Rigid blocks only rotate and scale all axes the same, so the shader lights them with the model matrix.
+	struct BlockInstance
+	{
+		mat4 model{};   //locations 3-6
+		f32 layer{};    //location 7, block texture array layer
+		f32 padding[3]{};
+	};
+
+	//Per-instance data of a block with non-uniform scale or shear, layout matches block_scaled.vert
+	struct ScaledBlockInstance
+	{
+		mat4 model{};   //locations 3-6
+		f32 layer{};    //location 7, block texture array layer
+		mat3 normal{};  //locations 8-10, inverse transpose of the model rotation and scale
+	};
+
+	struct RenderSnapshot;
+
+	//Draws every block type with one shared cube mesh, one texture array and one draw call
+	class BlockBatch
+	{
+	public:
+		//Creates the shared cube mesh, the instance buffer and the block shader
+		static bool Initialize();
+
+		//Game thread side, builds the instance data for one block of a render snapshot
+		static BlockInstance MakeInstance(
+			const mat4& model,
+			BlockType type);
+
+		//Game thread side, same for blocks that are not rigid, the normal matrix comes from the transform update
+		static ScaledBlockInstance MakeScaledInstance(
+			const mat4& model,
+			const mat3& normal,
+			BlockType type);
+
+		//Render thread side, uploads the snapshot blocks and draws them in one instanced call per shader
+		static void Draw(const RenderSnapshot& snapshot);
+
+		static void Shutdown();
+	};
+}
\ No newline at end of file
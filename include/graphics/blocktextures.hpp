@@ -0,0 +1,50 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/blocktype.hpp"
+
+namespace CircuitGame::Graphics
+{
+	using CircuitGame::GameObjects::BlockType;
+	using CircuitGame::GameObjects::BLOCK_TYPE_COUNT;
+
+	//One GL_TEXTURE_2D_ARRAY holding every block texture,
+	//so all block types can be drawn in a single instanced batch
+	class BlockTextures
+	{
+	public:
+		//Uploads 'files/cooked/textures/blocks/<block name>.cctx' as-is when every layer is cooked,
+		//otherwise loads 'files/textures/blocks/<block name>.png|.jpg' and generates the mips.
+		//Missing source textures fall back to a tinted copy of the cube texture.
+		static bool Initialize();
+
+		static bool IsInitialized() { return isInitialized; }
+
+		static u32 GetOpenGLID() { return openGLID; }
+
+		static vec2 GetSize() { return size; }
+		static u32 GetLayerCount() { return BLOCK_TYPE_COUNT; }
+		static u32 GetMipMapLevels() { return mipMapLevels; }
+
+		//Block type value is the layer index
+		static u32 GetLayer(BlockType type) { return static_cast<u32>(type); }
+
+		//Binds the texture array to the chosen texture unit
+		static void Bind(u32 unit);
+
+		static void Shutdown();
+	private:
+		static inline bool isInitialized = false;
+
+		static inline u32 openGLID{};
+		static inline vec2 size{};
+		static inline u32 mipMapLevels = 1;
+	};
+}
\ No newline at end of file
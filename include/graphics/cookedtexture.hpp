@@ -0,0 +1,125 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+#include <cstring>
+
+//kalawindow
+#include "core/platform.hpp"
+
+//Shared between the game and the Circuit_Chan_cook tool, must not depend on KalaWindow libraries.
+//Layout of a .cctx file:
+//  CookedTextureHeader
+//  CookedMipEntry[mipCount], largest mip first
+//  mip data, already in the final GPU block layout
+namespace CircuitGame::Graphics
+{
+	using std::vector;
+
+	inline constexpr char COOKED_TEXTURE_MAGIC[4] = { 'C', 'C', 'T', 'X' };
+	inline constexpr u32 COOKED_TEXTURE_VERSION = 1;
+	inline constexpr const char* COOKED_TEXTURE_EXTENSION = ".cctx";
+
+	enum class CookedFormat : u32
+	{
+		Cooked_RGBA8 = 0,
+		Cooked_BC1 = 1, //DXT1, 8 bytes per 4x4 block
+		Cooked_BC3 = 2  //DXT5, 16 bytes per 4x4 block
+	};
+
+	struct CookedTextureHeader
+	{
+		char magic[4]{};
+		u32 version{};
+		CookedFormat format{};
+		u32 width{};
+		u32 height{};
+		u32 mipCount{};
+	};
+
+	struct CookedMipEntry
+	{
+		u32 width{};
+		u32 height{};
+		u32 offset{}; //From the start of the file
+		u32 size{};
+	};
+
+	//Bytes needed for one mip level of the chosen format
+	inline u32 GetCookedMipSize(
+		CookedFormat format,
+		u32 width,
+		u32 height)
+	{
+		u32 blocksX = (width + 3) / 4;
+		u32 blocksY = (height + 3) / 4;
+
+		switch (format)
+		{
+		case CookedFormat::Cooked_RGBA8:
+			return width * height * 4;
+		case CookedFormat::Cooked_BC1:
+			return blocksX * blocksY * 8;
+		case CookedFormat::Cooked_BC3:
+			return blocksX * blocksY * 16;
+		}
+
+		return 0;
+	}
+
+	//Non-owning view over a loaded .cctx file
+	struct CookedTextureView
+	{
+		CookedTextureHeader header{};
+		const CookedMipEntry* mips{};
+		const u8* bytes{};
+
+		const u8* GetMipData(u32 level) const { return bytes + mips[level].offset; }
+	};
+
+	//Validates a .cctx file that was read into memory in one go,
+	//the view points straight into the file bytes so no pixel data is copied
+	inline bool ParseCookedTexture(
+		const vector<u8>& fileBytes,
+		CookedTextureView& outView)
+	{
+		if (fileBytes.size() < sizeof(CookedTextureHeader)) return false;
+
+		CookedTextureHeader header{};
+		memcpy(&header, fileBytes.data(), sizeof(CookedTextureHeader));
+
+		if (memcmp(header.magic, COOKED_TEXTURE_MAGIC, sizeof(header.magic)) != 0
+			|| header.version != COOKED_TEXTURE_VERSION
+			|| header.mipCount == 0
+			|| header.mipCount > 16)
+		{
+			return false;
+		}
+
+		size_t tableEnd = sizeof(CookedTextureHeader) + header.mipCount * sizeof(CookedMipEntry);
+		if (fileBytes.size() < tableEnd) return false;
+
+		const CookedMipEntry* mips = reinterpret_cast<const CookedMipEntry*>(
+			fileBytes.data() + sizeof(CookedTextureHeader));
+
+		for (u32 i = 0; i < header.mipCount; ++i)
+		{
+			const CookedMipEntry& mip = mips[i];
+			if (mip.size != GetCookedMipSize(header.format, mip.width, mip.height)
+				|| static_cast<size_t>(mip.offset) + mip.size > fileBytes.size())
+			{
+				return false;
+			}
+		}
+
+		outView.header = header;
+		outView.mips = mips;
+		outView.bytes = fileBytes.data();
+
+		return true;
+	}
+}
\ No newline at end of file
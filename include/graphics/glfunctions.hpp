@@ -0,0 +1,191 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "graphics/opengl/opengl_core.hpp"
+#include "graphics/window.hpp"
+
+//
+// OpenGL 3.3 functions and enums that KalaWindow does not load itself.
+// Loaded through OpenGLCore::GetGLProcAddress after the context exists.
+//
+
+using GLuint64 = uint64_t;
+
+//Texture usage
+
+inline constexpr GLenum GL_TEXTURE_2D_ARRAY = 0x8C1A; //2D array texture target
+inline constexpr GLenum GL_RGBA8            = 0x8058; //Sized 8-bit RGBA internal format
+
+//Compressed texture formats, from EXT_texture_compression_s3tc
+
+inline constexpr GLenum GL_COMPRESSED_RGB_S3TC_DXT1_EXT  = 0x83F0; //BC1, RGB
+inline constexpr GLenum GL_COMPRESSED_RGBA_S3TC_DXT5_EXT = 0x83F3; //BC3, RGBA
+
+//Buffer usage
+
+inline constexpr GLenum GL_STREAM_DRAW  = 0x88E0; //Data modified every frame, used a few times
+inline constexpr GLenum GL_DYNAMIC_DRAW = 0x88E8; //Data modified repeatedly, used many times
+
+//System queries
+
+inline constexpr GLenum GL_EXTENSIONS = 0x1F03; //Extension name, used with glGetStringi
+
+//Timer queries, core since OpenGL 3.3
+
+inline constexpr GLenum GL_TIME_ELAPSED           = 0x88BF; //Nanoseconds the GPU spent between begin and end
+inline constexpr GLenum GL_QUERY_RESULT           = 0x8866; //Query result, waits for the GPU if not available yet
+inline constexpr GLenum GL_QUERY_RESULT_AVAILABLE = 0x8867; //GL_TRUE once the result can be read without waiting
+
+//Render state
+
+inline constexpr GLenum GL_DEPTH_TEST = 0x0B71; //Depth testing
+inline constexpr GLenum GL_CULL_FACE  = 0x0B44; //Back face culling
+inline constexpr GLenum GL_BLEND      = 0x0BE2; //Blending with the framebuffer color
+
+//Blend factors
+
+inline constexpr GLenum GL_SRC_ALPHA           = 0x0302; //Source alpha
+inline constexpr GLenum GL_ONE_MINUS_SRC_ALPHA = 0x0303; //One minus source alpha
+
+//
+// TEXTURES
+//
+
+//Specifies a three-dimensional or array texture image
+extern void (K_APIENTRY* glTexImage3D)(
+	GLenum target,
+	GLint level,
+	GLint internalFormat,
+	GLsizei width,
+	GLsizei height,
+	GLsizei depth,
+	GLint border,
+	GLenum format,
+	GLenum type,
+	const void* data);
+
+//Specifies a subregion of an existing three-dimensional or array texture image
+extern void (K_APIENTRY* glTexSubImage3D)(
+	GLenum target,
+	GLint level,
+	GLint xoffset,
+	GLint yoffset,
+	GLint zoffset,
+	GLsizei width,
+	GLsizei height,
+	GLsizei depth,
+	GLenum format,
+	GLenum type,
+	const void* pixels);
+
+//Specifies a three-dimensional or array texture image in a compressed format
+extern void (K_APIENTRY* glCompressedTexImage3D)(
+	GLenum target,
+	GLint level,
+	GLenum internalFormat,
+	GLsizei width,
+	GLsizei height,
+	GLsizei depth,
+	GLint border,
+	GLsizei imageSize,
+	const void* data);
+
+//
+// INSTANCING
+//
+
+//Sets how many instances pass before a vertex attribute advances
+extern void (K_APIENTRY* glVertexAttribDivisor)(
+	GLuint index,
+	GLuint divisor);
+
+//Draws multiple instances of a range of vertices
+extern void (K_APIENTRY* glDrawArraysInstanced)(
+	GLenum mode,
+	GLint first,
+	GLsizei count,
+	GLsizei instanceCount);
+
+//Updates a subset of the currently bound buffer
+extern void (K_APIENTRY* glBufferSubData)(
+	GLenum target,
+	GLintptr offset,
+	GLsizeiptr size,
+	const void* data);
+
+//
+// RENDER STATE
+//
+
+//Sets how source and destination colors are combined while GL_BLEND is enabled
+extern void (K_APIENTRY* glBlendFunc)(
+	GLenum sfactor,
+	GLenum dfactor);
+
+//Enables or disables writing into the depth buffer
+extern void (K_APIENTRY* glDepthMask)(
+	GLboolean flag);
+
+//
+// QUERIES
+//
+
+//Returns one indexed string, used for extension names
+extern const GLubyte* (K_APIENTRY* glGetStringi)(
+	GLenum name,
+	GLuint index);
+
+//Generates query object names
+extern void (K_APIENTRY* glGenQueries)(
+	GLsizei n,
+	GLuint* ids);
+
+//Deletes named query objects
+extern void (K_APIENTRY* glDeleteQueries)(
+	GLsizei n,
+	const GLuint* ids);
+
+//Starts measuring into a query object
+extern void (K_APIENTRY* glBeginQuery)(
+	GLenum target,
+	GLuint id);
+
+//Stops measuring into the active query object of this target
+extern void (K_APIENTRY* glEndQuery)(
+	GLenum target);
+
+//Returns a query object parameter, used for GL_QUERY_RESULT_AVAILABLE
+extern void (K_APIENTRY* glGetQueryObjectuiv)(
+	GLuint id,
+	GLenum pname,
+	GLuint* params);
+
+//Returns a 64-bit query object result, used for GL_TIME_ELAPSED nanoseconds
+extern void (K_APIENTRY* glGetQueryObjectui64v)(
+	GLuint id,
+	GLenum pname,
+	GLuint64* params);
+
+namespace CircuitGame::Graphics
+{
+	using KalaWindow::Graphics::Window;
+
+	class GLFunctions
+	{
+	public:
+		//Loads all functions declared in this header, requires a current context
+		static bool Initialize();
+
+		//Returns true if the current context lists this extension
+		static bool IsExtensionSupported(const char* extension);
+
+		//Detaches the context from the calling thread so another thread can make it current,
+		//KalaWindow only exposes making a context current, not releasing it
+		static void ReleaseCurrentContext(Window* window);
+	};
+}
\ No newline at end of file
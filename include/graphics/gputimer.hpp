@@ -0,0 +1,78 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::Graphics
+{
+	//Logical passes of one drawn frame, each one is timed separately on the GPU
+	enum class GPUPass : u8
+	{
+		Pass_Clear,       //Framebuffer clear
+		Pass_Opaque,      //Block batch
+		Pass_Transparent, //Water surfaces, blended over the opaque pass
+		Pass_Debug,       //Lines and other debug drawing
+		Pass_Post,        //Full screen post processing
+		Pass_UI,          //Interface on top of everything
+		PassCount
+	};
+
+	inline constexpr u32 GPU_PASS_COUNT = static_cast<u32>(GPUPass::PassCount);
+
+	//Also the zone name on the GPU track of profiler captures
+	inline const char* GetGPUPassName(GPUPass pass)
+	{
+		switch (pass)
+		{
+		case GPUPass::Pass_Clear:       return "GPU::Clear";
+		case GPUPass::Pass_Opaque:      return "GPU::Opaque";
+		case GPUPass::Pass_Transparent: return "GPU::Transparent";
+		case GPUPass::Pass_Debug:       return "GPU::Debug";
+		case GPUPass::Pass_Post:        return "GPU::Post";
+		case GPUPass::Pass_UI:          return "GPU::UI";
+		default:                        return "GPU::Unknown";
+		}
+	}
+
+	//Render thread side. Wraps every pass of a frame in a GL_TIME_ELAPSED query
+	//and reads the results back GPU_TIMER_LATENCY frames later, so reading never waits for the GPU.
+	//Results go to FrameStats as per pass metrics and to the GPU track of profiler captures.
+	class GPUTimer
+	{
+	public:
+		//Creates the query pool, requires a current context
+		static bool Initialize();
+
+		//Reads every finished frame, then starts timing the frame of this snapshot
+		static void BeginFrame(u64 frameIndex);
+
+		//Passes do not nest, beginning a pass ends the open one
+		static void BeginPass(GPUPass pass);
+		static void EndPass();
+
+		static void EndFrame();
+
+		//Frames whose results were still not available when their queries had to be reused
+		static u64 GetDroppedFrameCount() { return droppedFrameCount; }
+
+		static void Shutdown();
+	private:
+		static inline u64 droppedFrameCount{};
+	};
+
+	//Times the enclosing scope as one pass
+	class GPUPassScope
+	{
+	public:
+		explicit GPUPassScope(GPUPass pass) { GPUTimer::BeginPass(pass); }
+		~GPUPassScope() { GPUTimer::EndPass(); }
+
+		GPUPassScope(const GPUPassScope&) = delete;
+		GPUPassScope& operator=(const GPUPassScope&) = delete;
+	};
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "graphics/rendersnapshot.hpp"
+
 namespace CircuitGame::Graphics
 {
 	class Render
@@ -13,12 +15,16 @@ namespace CircuitGame::Graphics
 		//Initializes the render loop
 		static bool Initialize();
 
-		//The full graphical render loop of this program
+		//Publishes a new render snapshot each frame the window is not idle
 		static void Update();
 
-		//What to call when we need to redraw during rescaling the window etc
+		//What to call when we need to redraw during rescaling the window etc,
+		//fills and publishes a render snapshot from the current game state
 		static void Redraw();
 
+		//Render thread side, submits one snapshot and swaps buffers
+		static void Draw(const RenderSnapshot& snapshot);
+
 		//Destroy all created textures and gameobjects
 		static void Shutdown();
 	};
@@ -0,0 +1,47 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "graphics/blockbatch.hpp"
+#include "graphics/waterbatch.hpp"
+
+namespace CircuitGame::Graphics
+{
+	using std::vector;
+
+	struct SnapshotDirLight
+	{
+		vec3 direction = vec3(-0.3f, -1.0f, -0.5f);
+		vec3 color = vec3(1.0f);
+		f32 ambientStrength = 0.35f;
+	};
+
+	//Everything the render thread needs to draw one frame.
+	//Built by the game thread, read only by the render thread,
+	//vectors keep their capacity between frames so filling one does not allocate.
+	struct RenderSnapshot
+	{
+		u64 frameIndex{};
+		u64 publishIndex{}; //Set by RenderThread::PublishSnapshot, one more for every published snapshot
+
+		vec2 framebufferSize{};
+
+		mat4 view{};
+		mat4 projection{};
+		vec3 viewPos{};
+
+		SnapshotDirLight dirLight{};
+
+		vector<BlockInstance> blocks{};
+		vector<ScaledBlockInstance> scaledBlocks{};
+		vector<WaterInstance> water{};
+	};
+}
\ No newline at end of file
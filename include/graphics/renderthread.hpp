@@ -0,0 +1,47 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <functional>
+
+#include "graphics/rendersnapshot.hpp"
+
+namespace CircuitGame::Graphics
+{
+	using std::function;
+
+	//Owns the OpenGL context after Start and draws the newest published snapshot.
+	//The game thread fills the next snapshot while the previous one is being submitted,
+	//and waits for it to be presented before going further, so the swap paces both threads.
+	class RenderThread
+	{
+	public:
+		//Hands the context from the calling thread to the render thread
+		static bool Start();
+
+		static bool IsRunning() { return isRunning; }
+
+		//Game thread side, the snapshot to fill for the next frame
+		static RenderSnapshot& GetWriteSnapshot();
+
+		//Game thread side, makes the filled snapshot the newest one to draw
+		static void PublishSnapshot();
+
+		//Game thread side, returns once every snapshot but the newest one has been presented.
+		//Keeps the game thread at most one frame ahead of the swap, so with vsync on it runs
+		//at the refresh rate instead of filling snapshots that are never drawn.
+		static void WaitForPresent();
+
+		//Runs GL work on the render thread before the next frame is drawn,
+		//or right away on the calling thread if the render thread is not running
+		static void Enqueue(function<void()> command);
+
+		//Joins the render thread and makes the context current on the calling thread again
+		static void Stop();
+	private:
+		static inline bool isRunning{};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::Graphics
+{
+	using glm::ivec3;
+
+	//Per-instance data of one water surface, layout matches water.vert
+	struct WaterInstance
+	{
+		vec3 cellMin{}; //location 1, minimum corner of the cell in meters
+		f32 height{};   //location 2, surface height above the bottom of the cell in meters
+	};
+
+	struct RenderSnapshot;
+
+	//Draws the water surfaces as flat translucent quads, one instanced draw after the opaque blocks
+	class WaterBatch
+	{
+	public:
+		//Creates the quad mesh, the instance buffer and the water shader
+		static bool Initialize();
+
+		//Game thread side, builds the instance data for one WaterSystem surface cell
+		static WaterInstance MakeInstance(
+			const ivec3& cell,
+			u8 level);
+
+		//Render thread side, blends the snapshot water over what is drawn,
+		//without writing depth so surfaces behind each other all show
+		static void Draw(const RenderSnapshot& snapshot);
+
+		static void Shutdown();
+	};
+}
\ No newline at end of file
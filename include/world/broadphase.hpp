@@ -0,0 +1,83 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <span>
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "core/handle.hpp"
+
+namespace CircuitGame::World
+{
+	using std::span;
+	using CircuitGame::Core::Handle;
+
+	struct ProxyTag {};
+	using Proxy = Handle<ProxyTag>;
+
+	//Two proxies whose boxes overlap, a.value is always the smaller
+	struct OverlapPair
+	{
+		Proxy a{};
+		Proxy b{};
+	};
+
+	//Finds which boxes of dynamic bodies like doors, platforms and debris overlap.
+	//Awake proxies are kept sorted along x and re-sorted with an insertion sort every update,
+	//which is close to linear because they barely move between steps. Sleeping proxies sit in their
+	//own sorted list that only changes when one falls asleep or wakes, awake proxies look them up
+	//there and pairs of two sleepers are carried over untouched, so an update costs about
+	//the number of awake proxies no matter how many sleep.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries. Game thread only.
+	class Broadphase
+	{
+	public:
+		//userData is handed back by GetUserData, like the index of the body that owns the box.
+		//Returns an invalid proxy once every slot is in use.
+		static Proxy Add(
+			const vec3& min,
+			const vec3& max,
+			u32 userData,
+			bool isSleeping = false);
+
+		//Pairs of the proxy are reported as removed by the next Update, the proxy is stale by then
+		static void Remove(Proxy proxy);
+
+		//New box for the next Update, moving a sleeping proxy wakes it
+		static void Move(
+			Proxy proxy,
+			const vec3& min,
+			const vec3& max);
+
+		static void SetSleeping(
+			Proxy proxy,
+			bool isSleeping);
+
+		static bool IsSleeping(Proxy proxy);
+		static bool IsAlive(Proxy proxy);
+		static u32 GetUserData(Proxy proxy);
+
+		//Re-sorts the awake proxies and finds the pairs that started or stopped overlapping
+		static void Update();
+
+		//Every pair overlapping as of the last Update, sorted by a then b
+		static span<const OverlapPair> GetPairs();
+
+		//Pairs that started overlapping in the last Update
+		static span<const OverlapPair> GetAddedPairs();
+
+		//Pairs that stopped overlapping in the last Update, or lost a proxy to Remove
+		static span<const OverlapPair> GetRemovedPairs();
+
+		static u32 GetAwakeCount();
+		static u32 GetSleepingCount();
+
+		//Removes every proxy without reporting their pairs, used when a level is unloaded
+		static void Clear();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+namespace CircuitGame::World
+{
+	//Upright box that walks on the block grid
+	struct CharacterBody
+	{
+		vec3 pos{};                                 //Center of the bottom face
+		vec3 velocity{};
+		vec3 halfExtents = vec3(0.3f, 0.9f, 0.3f);
+
+		f32 stepHeight = 0.5f;                      //One cell, ledges up to this high are walked onto
+		f32 jumpSpeed = 5.0f;
+
+		bool isGrounded{};
+		bool isFlying{};                            //No gravity, moveVelocity.y is used as is
+	};
+
+	//Moves character bodies through the cells of ChunkStore, every cell that is not empty is solid.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries.
+	class CharacterController
+	{
+	public:
+		//One fixed timestep. The box is swept up or down first and then along x and z,
+		//each sweep only reads the cells between where the box is and where it would end up.
+		//moveVelocity is what the player asks for in meters per second, y is ignored unless flying.
+		static void Step(
+			CharacterBody& body,
+			const vec3& moveVelocity,
+			bool wantsJump,
+			f32 deltaTime);
+
+		//Distance the box can move along one axis before touching a filled cell,
+		//between zero and distance with the same sign
+		static f32 SweepAxis(
+			const vec3& boxMin,
+			const vec3& boxMax,
+			u32 axis,
+			f32 distance);
+	};
+}
\ No newline at end of file
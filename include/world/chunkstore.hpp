@@ -0,0 +1,138 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <span>
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/blocktype.hpp"
+
+namespace CircuitGame::World
+{
+	using std::span;
+	using glm::ivec3;
+	using CircuitGame::GameObjects::BlockType;
+
+	//Edge length of one grid cell in meters
+	inline constexpr f32 CELL_SIZE = 0.5f;
+
+	//Cells along one edge of a chunk
+	inline constexpr i32 CHUNK_SIZE = 16;
+	inline constexpr i32 CHUNK_SHIFT = 4;
+	inline constexpr i32 CHUNK_MASK = CHUNK_SIZE - 1;
+	inline constexpr u32 CHUNK_VOLUME = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+
+	//What fills a cell, values from CELL_BLOCK_FIRST up are placed blocks
+	inline constexpr u8 CELL_EMPTY = 0;
+	inline constexpr u8 CELL_SOLID = 1; //Floors and walls of the facility
+	inline constexpr u8 CELL_BLOCK_FIRST = 2;
+
+	inline constexpr u8 MakeBlockCell(BlockType type)
+	{
+		return static_cast<u8>(CELL_BLOCK_FIRST + static_cast<u8>(type));
+	}
+	inline constexpr bool IsBlockCell(u8 cell) { return cell >= CELL_BLOCK_FIRST; }
+	inline constexpr BlockType GetCellBlockType(u8 cell)
+	{
+		return static_cast<BlockType>(cell - CELL_BLOCK_FIRST);
+	}
+
+	//Cells are stored x fastest, then z, then y, so one row along x is contiguous
+	inline constexpr u32 GetCellIndex(i32 x, i32 y, i32 z)
+	{
+		return static_cast<u32>(x + (z << CHUNK_SHIFT) + (y << (CHUNK_SHIFT * 2)));
+	}
+
+	struct Chunk
+	{
+		ivec3 coord{};        //In chunks, not cells
+		u32 filledCount{};    //Cells that are not empty, rays step over chunks where this is zero
+		u8 cells[CHUNK_VOLUME]{};
+
+		//Fill level of every empty cell from 0 to WATER_FULL, only WaterSystem writes it
+		u8 water[CHUNK_VOLUME]{};
+		bool isWaterActive{};  //Water may still flow here, WaterSystem steps this chunk
+		bool isWaterStepped{}; //Part of the current WaterSystem step
+		bool isWet{};          //Has held water, WaterSystem lists the water surface of this chunk
+		bool isSurfaceDirty{}; //Water changed since WaterSystem last listed the surface
+	};
+
+	struct RaycastHit
+	{
+		ivec3 cell{};
+		ivec3 normal{};       //Face the ray entered through, zero when the ray starts inside a filled cell
+		f32 distance{};       //Meters from the ray origin
+		u8 cellValue{};
+	};
+
+	//The 0.5m block grid of a level, split into 16x16x16 cell chunks created on first write.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries.
+	//Writes are game thread only, reads and raycasts may run on any thread between writes.
+	class ChunkStore
+	{
+	public:
+		static u8 GetCell(const ivec3& cell);
+
+		//Creates the chunk if needed, returns false only if it could not be allocated.
+		//Filling a cell removes the water in it, emptying one lists it in GetEmptiedCells.
+		static bool SetCell(
+			const ivec3& cell,
+			u8 value);
+
+		//Sets every cell that overlaps the box, given in meters
+		static bool FillBox(
+			const vec3& min,
+			const vec3& max,
+			u8 value);
+
+		//First and last cell that overlap the box given in meters, the cells FillBox sets
+		static void GetBoxCells(
+			const vec3& min,
+			const vec3& max,
+			ivec3& outFirst,
+			ivec3& outLast);
+
+		//Nullptr if nothing was ever written into the chunk
+		static const Chunk* GetChunk(const ivec3& chunkCoord);
+
+		//Writable chunk, created if needed, for systems that keep more than cells in it.
+		//Returns nullptr only if it could not be allocated. Game thread only.
+		static Chunk* CreateChunk(const ivec3& chunkCoord);
+
+		//Smallest and largest chunk coordinate ever created, false while there are no chunks
+		static bool GetChunkBounds(
+			ivec3& outMin,
+			ivec3& outMax);
+
+		static ivec3 WorldToCell(const vec3& pos);
+
+		//Minimum corner of the cell in meters
+		static vec3 CellToWorld(const ivec3& cell);
+
+		static ivec3 CellToChunk(const ivec3& cell);
+
+		//First filled cell along the ray, direction does not have to be normalized.
+		//Returns false if nothing is hit within maxDistance meters or before the ray leaves the chunk bounds,
+		//so an infinite maxDistance is allowed.
+		static bool Raycast(
+			const vec3& origin,
+			const vec3& direction,
+			f32 maxDistance,
+			RaycastHit& outHit);
+
+		static u32 GetChunkCount();
+
+		//Filled cells emptied since the last ClearEmptiedCells, a cell may be listed more than once.
+		//DebrisSystem::Step reads and clears them to wake what rested on them.
+		static span<const ivec3> GetEmptiedCells();
+		static void ClearEmptiedCells();
+
+		//Frees every chunk, used when a level is unloaded
+		static void Clear();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/componentarray.hpp"
+
+namespace CircuitGame::GameObjects
+{
+	struct DebrisComponent;
+}
+
+namespace CircuitGame::World
+{
+	using CircuitGame::GameObjects::Entity;
+	using CircuitGame::GameObjects::DebrisComponent;
+
+	//Rigid box debris like collapsed floor sections and falling panels.
+	//Bodies touching each other form islands, every island is solved as its own job
+	//and an island where everything has come to rest is put to sleep as a whole,
+	//so a settled collapse costs nothing until something hits it again.
+	//Contacts come from box corners inside filled grid cells and from the face of one box
+	//clipped against the other, which is enough for debris but lets two boxes cross edge through edge.
+	//Contacts start from the impulses of the last step, which is what keeps stacks standing.
+	//A sleeper touched by an awake box, or lying on a cell listed by ChunkStore::GetEmptiedCells,
+	//wakes with every sleeper resting on it, directly or through others,
+	//so a stack is never left hanging when only its bottom was hit and the pile beside it sleeps on.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries. Game thread only.
+	class DebrisSystem
+	{
+	public:
+		//Turns an entity with a root transform into a box body of the same size,
+		//mass follows from the volume. Returns nullptr if the entity has no transform
+		//or the broadphase is full.
+		static DebrisComponent* Add(
+			Entity entity,
+			const vec3& velocity = vec3(0),
+			f32 density = 1000.0f);
+
+		//Removes the broadphase proxy, called before the debris component is removed
+		static void Remove(Entity entity);
+
+		//Wakes the body and every sleeper resting on it at the start of the next Step
+		static void Wake(Entity entity);
+
+		//One fixed timestep: contacts, islands, solving and sleeping.
+		//Transforms of bodies that moved are updated at the end.
+		static void Step(f32 deltaTime);
+
+		static u32 GetAwakeCount();
+
+		//Islands and contacts of the last step
+		static u32 GetIslandCount();
+		static u32 GetContactCount();
+
+		//Forgets the last step, used when every entity is cleared at once
+		static void Clear();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <span>
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/componentarray.hpp"
+
+namespace CircuitGame::GameObjects
+{
+	struct SupportComponent;
+}
+
+namespace CircuitGame::World
+{
+	using std::span;
+	using glm::ivec3;
+	using CircuitGame::GameObjects::Entity;
+	using CircuitGame::GameObjects::SupportComponent;
+
+	//A block that lost its ground, its cells are already empty
+	struct CollapsedBlock
+	{
+		Entity entity{};
+		ivec3 minCell{};
+		ivec3 maxCell{}; //Inclusive
+		u8 cellValue{};  //Block type as stored in the grid
+	};
+
+	//Enforces that placed blocks need solid ground: a block stays while any cell under its bottom
+	//is a facility cell or a solid block, wires hold up nothing but layer sockets.
+	//Emptied cells go on a worklist and only the blocks right above them are checked, a block that
+	//falls empties its own cells in turn, so a whole cascade is resolved in one call and costs
+	//about as much as the blocks it removes. Blocks nothing changed under are never looked at.
+	//Removed blocks are handed out as one batch per call for the renderer and circuit simulator.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries. Game thread only.
+	class SupportSystem
+	{
+	public:
+		//Registers a block whose cells were already filled, the box is in meters like ChunkStore::FillBox.
+		//The block is not checked until a cell under it is emptied.
+		//Returns nullptr if the box holds no block cells.
+		static SupportComponent* Add(
+			Entity entity,
+			const vec3& min,
+			const vec3& max,
+			bool isAnchored = false);
+
+		//Empties the cells of the block and queues the blocks on top of it,
+		//called before the support component is removed
+		static void Remove(Entity entity);
+
+		//Empties a cell, like a floor section giving way. A cell of a block removes the whole block
+		//on the next Resolve as if it had lost its ground, even an anchored one.
+		static void ClearCell(const ivec3& cell);
+
+		//Removes every block left without ground since the last call, and everything that stood on them
+		static void Resolve();
+
+		//Blocks removed by the last Resolve, in the order they fell.
+		//Their entities are still alive, the game turns them into debris or destroys them once every system has read the batch.
+		static span<const CollapsedBlock> GetCollapsed();
+
+		//Cells checked by the last Resolve, what the cascade cost
+		static u32 GetCheckedCellCount();
+
+		//Forgets the blocks and the worklist, used when every entity is cleared at once
+		static void Clear();
+	};
+}
\ No newline at end of file
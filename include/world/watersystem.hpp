@@ -0,0 +1,85 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <span>
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "gameobjects/componentarray.hpp"
+
+namespace CircuitGame::World
+{
+	using std::span;
+	using glm::ivec3;
+	using CircuitGame::GameObjects::Entity;
+
+	//Fill level of a cell that holds all the water it can
+	inline constexpr u8 WATER_FULL = 255;
+
+	//Water at or above this level next to a circuit block shorts it
+	inline constexpr u8 WATER_SHORT_LEVEL = 32;
+
+	//Topmost water of a column, a cell with water and none in the cell above it
+	struct WaterSurface
+	{
+		ivec3 cell{};
+		u8 level{}; //Fill level, the surface sits level / WATER_FULL of a cell above the bottom of the cell
+	};
+
+	//Leaking water as a fill level per empty grid cell, kept in the chunks of the chunk store.
+	//Every step water first falls into the cell below as far as it fits, then evens out with the four
+	//cells beside it, one 16 cell row along x at a time. Flow is worked out from the levels before
+	//each pass and both cells of a pair compute the same amount, so no water is made or lost.
+	//Only chunks where water changed last step and the chunks around them are stepped, a flooded room
+	//that has evened out costs nothing until a cell or wall next to it changes.
+	//Circuit blocks are listed per chunk, so only the ones in stepped chunks are checked for shorts.
+	//Water does not rise back up under pressure and spreads no thinner than a few levels.
+	//Shared with the Circuit_Chan_bench tool, must not depend on KalaWindow libraries. Game thread only.
+	class WaterSystem
+	{
+	public:
+		//Pours water into an empty cell, returns how much of it fit
+		static u8 AddWater(
+			const ivec3& cell,
+			u8 amount);
+
+		static u8 GetLevel(const ivec3& cell);
+
+		//Wakes the chunk of the cell and the chunks around it, called after a cell was
+		//filled or cleared so water can flow into the gap or around the new block
+		static void WakeCell(const ivec3& cell);
+
+		//One step of flow through the active chunks, then shorts or restores
+		//the circuit blocks next to water that moved
+		static void Step();
+
+		//Lists a circuit block whose cells were already filled, first and last cell are inclusive
+		//like ChunkStore::GetBoxCells. Called when the block is placed in the grid.
+		static void AddCircuit(
+			Entity entity,
+			const ivec3& firstCell,
+			const ivec3& lastCell);
+
+		//Called when the block leaves the grid, falling as debris or being destroyed
+		static void RemoveCircuit(Entity entity);
+
+		//Forgets every circuit block, used when the entity store is cleared
+		static void ClearCircuits();
+
+		//Water surface of every chunk that ever held water, for the water draw.
+		//Only chunks whose water changed are listed again, valid until the next call that changes water.
+		static span<const WaterSurface> GetSurfaces();
+
+		//Chunks stepped by the last Step, including the ones around active chunks
+		static u32 GetSteppedChunkCount();
+		static u32 GetActiveChunkCount();
+
+		//Forgets the active chunks, surfaces and circuit blocks, used when the chunk store is cleared
+		static void Clear();
+	};
+}
\ No newline at end of file
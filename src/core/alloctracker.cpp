@@ -0,0 +1,282 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <algorithm>
+
+#include "core/alloctracker.hpp"
+#include "core/loglevel.hpp"
+
+using CircuitGame::Core::AllocTracker;
+using CircuitGame::Core::AllocTag;
+using CircuitGame::Core::AllocStats;
+using CircuitGame::Core::ALLOC_TAG_COUNT;
+using CircuitGame::Core::GetAllocTagName;
+
+using std::atomic;
+using std::size_t;
+using std::align_val_t;
+using std::nothrow_t;
+using std::bad_alloc;
+using std::max;
+using std::memory_order_relaxed;
+
+//written from every thread, read and reset by the game thread at frame end
+static atomic<u64> frameCounts[ALLOC_TAG_COUNT]{};
+static atomic<u64> frameBytes[ALLOC_TAG_COUNT]{};
+static atomic<u64> totalAllocations{};
+static atomic<u64> totalFrees{};
+
+//game thread only
+static AllocStats lastFrame[ALLOC_TAG_COUNT]{};
+static u64 guardWorstFrame{};
+
+namespace CircuitGame::Core
+{
+	void AllocTracker::RecordAllocation(size_t size)
+	{
+		u32 tag = static_cast<u32>(threadTag);
+
+		frameCounts[tag].fetch_add(1, memory_order_relaxed);
+		frameBytes[tag].fetch_add(size, memory_order_relaxed);
+		totalAllocations.fetch_add(1, memory_order_relaxed);
+	}
+
+	void AllocTracker::RecordFree()
+	{
+		totalFrees.fetch_add(1, memory_order_relaxed);
+	}
+
+	void AllocTracker::EndFrame(bool discard)
+	{
+		AllocStats checked{};
+		for (u32 i = 0; i < ALLOC_TAG_COUNT; ++i)
+		{
+			lastFrame[i] =
+			{
+				.count = frameCounts[i].exchange(0, memory_order_relaxed),
+				.bytes = frameBytes[i].exchange(0, memory_order_relaxed)
+			};
+
+			if (static_cast<AllocTag>(i) == AllocTag::Tag_Log) continue;
+
+			checked.count += lastFrame[i].count;
+			checked.bytes += lastFrame[i].bytes;
+		}
+
+		if (!IsGuarding()
+			|| discard)
+		{
+			return;
+		}
+
+		if (guardWarmupLeft > 0)
+		{
+			--guardWarmupLeft;
+			return;
+		}
+
+		if (checked.count > 0)
+		{
+			++guardFailureCount;
+			guardWorstFrame = max(guardWorstFrame, checked.count);
+
+			LOGF_ERROR(
+				"ALLOC_GUARD",
+				"Steady state frame allocated %llu times (%llu bytes): game %llu, window %llu, input %llu, render %llu, jobs %llu, untagged %llu",
+				static_cast<unsigned long long>(checked.count),
+				static_cast<unsigned long long>(checked.bytes),
+				static_cast<unsigned long long>(lastFrame[static_cast<u32>(AllocTag::Tag_Game)].count),
+				static_cast<unsigned long long>(lastFrame[static_cast<u32>(AllocTag::Tag_Window)].count),
+				static_cast<unsigned long long>(lastFrame[static_cast<u32>(AllocTag::Tag_Input)].count),
+				static_cast<unsigned long long>(lastFrame[static_cast<u32>(AllocTag::Tag_Render)].count),
+				static_cast<unsigned long long>(lastFrame[static_cast<u32>(AllocTag::Tag_Jobs)].count),
+				static_cast<unsigned long long>(lastFrame[static_cast<u32>(AllocTag::Tag_Untagged)].count));
+		}
+
+		if (--guardFramesLeft > 0) return;
+
+		if (guardFailureCount == 0)
+		{
+			LOGF_SUCCESS(
+				"ALLOC_GUARD",
+				"Passed, %u steady state frames did not allocate.",
+				guardFrameCount);
+		}
+		else
+		{
+			LOGF_ERROR(
+				"ALLOC_GUARD",
+				"Failed, %u of %u steady state frames allocated, the worst one %llu times.",
+				guardFailureCount,
+				guardFrameCount,
+				static_cast<unsigned long long>(guardWorstFrame));
+		}
+	}
+
+	AllocStats AllocTracker::GetFrameStats(AllocTag tag)
+	{
+		return lastFrame[static_cast<u32>(tag)];
+	}
+
+	AllocStats AllocTracker::GetFrameTotal()
+	{
+		AllocStats total{};
+		for (const auto& stats : lastFrame)
+		{
+			total.count += stats.count;
+			total.bytes += stats.bytes;
+		}
+
+		return total;
+	}
+
+	u64 AllocTracker::GetTotalAllocationCount()
+	{
+		return totalAllocations.load(memory_order_relaxed);
+	}
+
+	u64 AllocTracker::GetTotalFreeCount()
+	{
+		return totalFrees.load(memory_order_relaxed);
+	}
+
+	void AllocTracker::StartGuard(
+		u32 warmupFrames,
+		u32 frameCount)
+	{
+		if (!IsEnabled())
+		{
+			LOGF_ERROR(
+				"ALLOC_GUARD",
+				"Cannot start the allocation guard because allocation tracking was compiled out, enable CIRCUIT_ALLOC_TRACKING!");
+
+			return;
+		}
+
+		guardWarmupLeft = warmupFrames;
+		guardFramesLeft = max(frameCount, 1u);
+		guardFrameCount = guardFramesLeft;
+		guardFailureCount = 0;
+		guardWorstFrame = 0;
+
+		LOGF_INFO(
+			"ALLOC_GUARD",
+			"Checking %u frames for allocations after %u warmup frames.",
+			guardFrameCount,
+			warmupFrames);
+	}
+}
+
+#ifdef CIRCUIT_ALLOC_TRACKING
+
+//
+// GLOBAL OPERATOR NEW AND DELETE REPLACEMENTS
+//
+
+static void* TrackedAllocate(size_t size);
+static void* TrackedAllocateAligned(
+	size_t size,
+	size_t alignment);
+static void TrackedFree(void* pointer);
+static void TrackedFreeAligned(void* pointer);
+
+void* operator new(size_t size)
+{
+	void* pointer = TrackedAllocate(size);
+	if (pointer == nullptr) throw bad_alloc();
+	return pointer;
+}
+void* operator new[](size_t size)
+{
+	void* pointer = TrackedAllocate(size);
+	if (pointer == nullptr) throw bad_alloc();
+	return pointer;
+}
+void* operator new(size_t size, const nothrow_t&) noexcept { return TrackedAllocate(size); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return TrackedAllocate(size); }
+
+void* operator new(size_t size, align_val_t alignment)
+{
+	void* pointer = TrackedAllocateAligned(size, static_cast<size_t>(alignment));
+	if (pointer == nullptr) throw bad_alloc();
+	return pointer;
+}
+void* operator new[](size_t size, align_val_t alignment)
+{
+	void* pointer = TrackedAllocateAligned(size, static_cast<size_t>(alignment));
+	if (pointer == nullptr) throw bad_alloc();
+	return pointer;
+}
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept
+{
+	return TrackedAllocateAligned(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept
+{
+	return TrackedAllocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { TrackedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { TrackedFree(pointer); }
+void operator delete(void* pointer, const nothrow_t&) noexcept { TrackedFree(pointer); }
+void operator delete[](void* pointer, const nothrow_t&) noexcept { TrackedFree(pointer); }
+
+void operator delete(void* pointer, align_val_t) noexcept { TrackedFreeAligned(pointer); }
+void operator delete[](void* pointer, align_val_t) noexcept { TrackedFreeAligned(pointer); }
+void operator delete(void* pointer, size_t, align_val_t) noexcept { TrackedFreeAligned(pointer); }
+void operator delete[](void* pointer, size_t, align_val_t) noexcept { TrackedFreeAligned(pointer); }
+void operator delete(void* pointer, align_val_t, const nothrow_t&) noexcept { TrackedFreeAligned(pointer); }
+void operator delete[](void* pointer, align_val_t, const nothrow_t&) noexcept { TrackedFreeAligned(pointer); }
+
+void* TrackedAllocate(size_t size)
+{
+	AllocTracker::RecordAllocation(size);
+
+	//malloc(0) may return nullptr, new never does
+	return malloc(size == 0 ? 1 : size);
+}
+
+void* TrackedAllocateAligned(
+	size_t size,
+	size_t alignment)
+{
+	AllocTracker::RecordAllocation(size);
+
+	if (size == 0) size = 1;
+#ifdef _WIN32
+	return _aligned_malloc(size, alignment);
+#else
+	void* pointer{};
+	if (posix_memalign(&pointer, max(alignment, sizeof(void*)), size) != 0) return nullptr;
+	return pointer;
+#endif
+}
+
+void TrackedFree(void* pointer)
+{
+	if (pointer == nullptr) return;
+
+	AllocTracker::RecordFree();
+	free(pointer);
+}
+
+void TrackedFreeAligned(void* pointer)
+{
+	if (pointer == nullptr) return;
+
+	AllocTracker::RecordFree();
+#ifdef _WIN32
+	_aligned_free(pointer);
+#else
+	free(pointer);
+#endif
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,404 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <thread>
+#include <semaphore>
+#include <chrono>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <unordered_map>
+#include <algorithm>
+
+//kalawindow
+#include "core/log.hpp"
+
+#include "core/asynclog.hpp"
+#include "core/profiler.hpp"
+#include "core/alloctracker.hpp"
+
+//kalawindow
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Core::AsyncLog;
+using CircuitGame::Core::AllocTag;
+
+using std::thread;
+using std::atomic;
+using std::counting_semaphore;
+using std::string;
+using std::string_view;
+using std::to_string;
+using std::unordered_map;
+using std::min;
+using std::memcpy;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::this_thread::get_id;
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+//Records in the ring, a power of two
+static constexpr u32 ASYNC_LOG_CAPACITY = 1024;
+
+static constexpr u32 ASYNC_LOG_TARGET_SIZE = 32;
+static constexpr u32 ASYNC_LOG_MESSAGE_SIZE = 216;
+
+//Copies of one message printed per window, the rest are counted and summarized
+static constexpr u32 ASYNC_LOG_RATE_LIMIT = 10;
+static constexpr milliseconds ASYNC_LOG_WINDOW{ 1000 };
+
+struct LogRecord
+{
+	LogType type{};
+	u16 indentation{};
+	u16 targetLength{};
+	u16 messageLength{};
+	char target[ASYNC_LOG_TARGET_SIZE]{};
+	char message[ASYNC_LOG_MESSAGE_SIZE]{};
+};
+
+//Vyukov bounded queue cell, the sequence says whose turn the record is
+struct LogCell
+{
+	atomic<u32> sequence{};
+	LogRecord record{};
+};
+
+struct SeenMessage
+{
+	u32 printedCount{};
+	u32 suppressedCount{};
+	LogRecord sample{};
+};
+
+static LogCell cells[ASYNC_LOG_CAPACITY]{};
+static atomic<u32> enqueuePosition{};
+static u32 dequeuePosition{}; //writer thread only
+
+static atomic<u64> droppedCount{};
+
+//producers only release the semaphore once per writer wake up
+static counting_semaphore<> wakeSemaphore{ 0 };
+static atomic<bool> isWakePending{};
+static atomic<bool> stopRequested{};
+
+static thread writerThread{};
+
+//writer thread only, consecutive duplicates and the current rate limit window
+static u64 lastHash{};
+static bool hasLastRecord{};
+static LogRecord lastRecord{};
+static u32 repeatCount{};
+static unordered_map<u64, SeenMessage> seenMessages{};
+static steady_clock::time_point windowStart{};
+static u64 reportedDroppedCount{};
+
+static void WriterLoop();
+static void DrainRecords();
+static void ProcessRecord(const LogRecord& record);
+static void WriteRecord(
+	const LogRecord& record,
+	const string& suffix = "");
+static void FlushRepeats();
+static void EndWindow();
+static u64 HashRecord(const LogRecord& record);
+static void CopyText(
+	string_view text,
+	char* destination,
+	u32 capacity,
+	u16& length);
+
+namespace CircuitGame::Core
+{
+	bool AsyncLog::Initialize()
+	{
+		if (IsRunning()) return true;
+
+		for (u32 i = 0; i < ASYNC_LOG_CAPACITY; ++i)
+		{
+			cells[i].sequence.store(i, memory_order_relaxed);
+		}
+		enqueuePosition.store(0, memory_order_relaxed);
+		dequeuePosition = 0;
+		droppedCount.store(0, memory_order_relaxed);
+		reportedDroppedCount = 0;
+
+		stopRequested.store(false);
+		isWakePending.store(false);
+		windowStart = steady_clock::now();
+
+		writerThread = thread(WriterLoop);
+		isRunning.store(true, memory_order_release);
+
+		return true;
+	}
+
+	void AsyncLog::Print(
+		string_view message,
+		string_view target,
+		LogType type,
+		u32 indentation)
+	{
+		if (!IsRunning())
+		{
+			Logger::Print(
+				string(message),
+				string(target),
+				type,
+				indentation);
+
+			return;
+		}
+
+		u32 position = enqueuePosition.load(memory_order_relaxed);
+		LogCell* cell{};
+		while (true)
+		{
+			cell = &cells[position & (ASYNC_LOG_CAPACITY - 1)];
+			u32 sequence = cell->sequence.load(memory_order_acquire);
+			i32 difference = static_cast<i32>(sequence - position);
+
+			if (difference == 0)
+			{
+				if (enqueuePosition.compare_exchange_weak(
+					position,
+					position + 1,
+					memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				//full, the writer is far behind and this record is not worth blocking for
+				droppedCount.fetch_add(1, memory_order_relaxed);
+				return;
+			}
+			else position = enqueuePosition.load(memory_order_relaxed);
+		}
+
+		LogRecord& record = cell->record;
+		record.type = type;
+		record.indentation = static_cast<u16>(min(indentation, 0xFFFFu));
+		CopyText(target, record.target, ASYNC_LOG_TARGET_SIZE, record.targetLength);
+		CopyText(message, record.message, ASYNC_LOG_MESSAGE_SIZE, record.messageLength);
+
+		cell->sequence.store(position + 1, memory_order_release);
+
+		if (!isWakePending.exchange(true)) wakeSemaphore.release();
+	}
+
+	void AsyncLog::PrintFormatted(
+		LogType type,
+		const char* target,
+		u32 indentation,
+		const char* format,
+		...)
+	{
+		//a record holds no more than this anyway
+		char buffer[ASYNC_LOG_MESSAGE_SIZE + 1]{};
+
+		va_list arguments;
+		va_start(arguments, format);
+		i32 length = vsnprintf(buffer, sizeof(buffer), format, arguments);
+		va_end(arguments);
+
+		if (length < 0) return;
+
+		//one past the record size so Print still marks the message as cut
+		Print(
+			string_view(buffer, min(static_cast<u32>(length), ASYNC_LOG_MESSAGE_SIZE + 1)),
+			target,
+			type,
+			indentation);
+	}
+
+	u64 AsyncLog::GetDroppedCount()
+	{
+		return droppedCount.load(memory_order_relaxed);
+	}
+
+	void AsyncLog::Shutdown()
+	{
+		if (!IsRunning()) return;
+
+		stopRequested.store(true);
+		wakeSemaphore.release();
+
+		//a crash on the writer thread itself cannot join itself
+		if (get_id() == writerThread.get_id())
+		{
+			writerThread.detach();
+			isRunning.store(false, memory_order_release);
+			return;
+		}
+
+		writerThread.join();
+
+		//anything pushed between the final drain and this point
+		isRunning.store(false, memory_order_release);
+		DrainRecords();
+		FlushRepeats();
+		EndWindow();
+	}
+}
+
+void WriterLoop()
+{
+	PROFILE_THREAD_NAME("Log");
+	ALLOC_THREAD_TAG(AllocTag::Tag_Log);
+
+	while (true)
+	{
+		//wakes up at least once per window to summarize repeats
+		wakeSemaphore.try_acquire_for(ASYNC_LOG_WINDOW);
+
+		//an exchange instead of a store so the records pushed before the wake are visible
+		isWakePending.exchange(false);
+		bool isStopping = stopRequested.load();
+
+		DrainRecords();
+
+		if (steady_clock::now() - windowStart >= ASYNC_LOG_WINDOW)
+		{
+			FlushRepeats();
+			EndWindow();
+		}
+
+		if (isStopping) break;
+	}
+}
+
+void DrainRecords()
+{
+	while (true)
+	{
+		LogCell& cell = cells[dequeuePosition & (ASYNC_LOG_CAPACITY - 1)];
+		u32 sequence = cell.sequence.load(memory_order_acquire);
+		if (static_cast<i32>(sequence - (dequeuePosition + 1)) < 0) break;
+
+		ProcessRecord(cell.record);
+
+		cell.sequence.store(dequeuePosition + ASYNC_LOG_CAPACITY, memory_order_release);
+		++dequeuePosition;
+	}
+}
+
+void ProcessRecord(const LogRecord& record)
+{
+	u64 hash = HashRecord(record);
+
+	if (hasLastRecord
+		&& hash == lastHash)
+	{
+		++repeatCount;
+		return;
+	}
+
+	SeenMessage& seen = seenMessages[hash];
+	if (seen.printedCount >= ASYNC_LOG_RATE_LIMIT)
+	{
+		if (seen.suppressedCount++ == 0) seen.sample = record;
+		return;
+	}
+	++seen.printedCount;
+
+	FlushRepeats();
+	WriteRecord(record);
+
+	lastHash = hash;
+	lastRecord = record;
+	hasLastRecord = true;
+}
+
+void WriteRecord(
+	const LogRecord& record,
+	const string& suffix)
+{
+	Logger::Print(
+		string(record.message, record.messageLength) + suffix,
+		string(record.target, record.targetLength),
+		record.type,
+		record.indentation);
+}
+
+void FlushRepeats()
+{
+	if (repeatCount == 0) return;
+
+	WriteRecord(lastRecord, " (repeated " + to_string(repeatCount) + " more times)");
+	repeatCount = 0;
+}
+
+void EndWindow()
+{
+	for (const auto& [hash, seen] : seenMessages)
+	{
+		if (seen.suppressedCount == 0) continue;
+
+		WriteRecord(seen.sample, " (suppressed " + to_string(seen.suppressedCount) + " more times)");
+	}
+	seenMessages.clear();
+
+	//the next copy of the last message starts a new line instead of a repeat count
+	hasLastRecord = false;
+
+	u64 dropped = droppedCount.load(memory_order_relaxed);
+	if (dropped != reportedDroppedCount)
+	{
+		Logger::Print(
+			"Dropped " + to_string(dropped - reportedDroppedCount) + " log messages because the log queue was full!",
+			"ASYNC_LOG",
+			LogType::LOG_WARNING);
+
+		reportedDroppedCount = dropped;
+	}
+
+	windowStart = steady_clock::now();
+}
+
+u64 HashRecord(const LogRecord& record)
+{
+	//FNV-1a over the type, target and message
+	u64 hash = 14695981039346656037ull;
+	auto mix = [&hash](const char* data, u32 size)
+	{
+		for (u32 i = 0; i < size; ++i)
+		{
+			hash ^= static_cast<u8>(data[i]);
+			hash *= 1099511628211ull;
+		}
+	};
+
+	char type = static_cast<char>(record.type);
+	mix(&type, 1);
+	mix(record.target, record.targetLength);
+	mix(record.message, record.messageLength);
+
+	return hash;
+}
+
+void CopyText(
+	string_view text,
+	char* destination,
+	u32 capacity,
+	u16& length)
+{
+	u32 size = min(static_cast<u32>(text.size()), capacity);
+	memcpy(destination, text.data(), size);
+
+	//marks a cut message
+	if (size < text.size()
+		&& size >= 3)
+	{
+		memcpy(destination + size - 3, "...", 3);
+	}
+
+	length = static_cast<u16>(size);
+}
\ No newline at end of file
@@ -0,0 +1,728 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <cmath>
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#define CIRCUIT_BATCHMATH_X86
+#endif
+
+#include "core/batchmath.hpp"
+
+using CircuitGame::Core::BatchMath;
+using CircuitGame::Core::SIMDLevel;
+using CircuitGame::Core::TRSArrays;
+using CircuitGame::Core::Vec4Arrays;
+using CircuitGame::Core::AABBArrays;
+
+using std::abs;
+
+//AVX kernels are compiled for AVX on their own and only called after the CPU check,
+//the rest of the program keeps the default instruction set
+#if defined(__GNUC__) || defined(__clang__)
+#define CIRCUIT_TARGET_AVX __attribute__((target("avx")))
+#else
+#define CIRCUIT_TARGET_AVX
+#endif
+
+//every kernel handles [begin, end), wide kernels hand the last few objects to the scalar one
+struct KernelTable
+{
+	void (*composeTRS)(const TRSArrays&, mat4*, u32, u32);
+	void (*multiplyMat4)(const mat4*, u32, const mat4*, mat4*, u32, u32);
+	void (*transformVec4)(const mat4&, const Vec4Arrays&, const Vec4Arrays&, u32, u32);
+	void (*transformAABB)(const mat4&, const AABBArrays&, const AABBArrays&, u32, u32);
+};
+
+static SIMDLevel DetectSIMDLevel();
+static const KernelTable& GetKernelTable(SIMDLevel level);
+
+static void ComposeTRSScalar(const TRSArrays& trs, mat4* out, u32 begin, u32 end);
+static void MultiplyMat4Scalar(const mat4* left, u32 leftStep, const mat4* right, mat4* out, u32 begin, u32 end);
+static void TransformVec4Scalar(const mat4& matrix, const Vec4Arrays& in, const Vec4Arrays& out, u32 begin, u32 end);
+static void TransformAABBScalar(const mat4& matrix, const AABBArrays& in, const AABBArrays& out, u32 begin, u32 end);
+
+#ifdef CIRCUIT_BATCHMATH_X86
+static void ComposeTRSSSE(const TRSArrays& trs, mat4* out, u32 begin, u32 end);
+static void MultiplyMat4SSE(const mat4* left, u32 leftStep, const mat4* right, mat4* out, u32 begin, u32 end);
+static void TransformVec4SSE(const mat4& matrix, const Vec4Arrays& in, const Vec4Arrays& out, u32 begin, u32 end);
+static void TransformAABBSSE(const mat4& matrix, const AABBArrays& in, const AABBArrays& out, u32 begin, u32 end);
+static void StoreColumnSSE(mat4* out, u32 column, __m128 row0, __m128 row1, __m128 row2, __m128 row3);
+
+CIRCUIT_TARGET_AVX static void ComposeTRSAVX(const TRSArrays& trs, mat4* out, u32 begin, u32 end);
+CIRCUIT_TARGET_AVX static void MultiplyMat4AVX(const mat4* left, u32 leftStep, const mat4* right, mat4* out, u32 begin, u32 end);
+CIRCUIT_TARGET_AVX static void TransformVec4AVX(const mat4& matrix, const Vec4Arrays& in, const Vec4Arrays& out, u32 begin, u32 end);
+CIRCUIT_TARGET_AVX static void TransformAABBAVX(const mat4& matrix, const AABBArrays& in, const AABBArrays& out, u32 begin, u32 end);
+CIRCUIT_TARGET_AVX static void StoreColumnAVX(mat4* out, u32 column, __m256 row0, __m256 row1, __m256 row2, __m256 row3);
+#endif
+
+static const SIMDLevel supportedLevel = DetectSIMDLevel();
+static SIMDLevel activeLevel = supportedLevel;
+static const KernelTable* activeKernels = &GetKernelTable(supportedLevel);
+
+namespace CircuitGame::Core
+{
+	SIMDLevel BatchMath::GetSIMDLevel()
+	{
+		return activeLevel;
+	}
+
+	SIMDLevel BatchMath::GetSupportedSIMDLevel()
+	{
+		return supportedLevel;
+	}
+
+	bool BatchMath::SetSIMDLevel(SIMDLevel level)
+	{
+		if (level > supportedLevel) return false;
+
+		activeLevel = level;
+		activeKernels = &GetKernelTable(level);
+
+		return true;
+	}
+
+	void BatchMath::ComposeTRS(
+		const TRSArrays& trs,
+		mat4* out,
+		u32 count)
+	{
+		activeKernels->composeTRS(trs, out, 0, count);
+	}
+
+	void BatchMath::MultiplyMat4(
+		const mat4& left,
+		const mat4* right,
+		mat4* out,
+		u32 count)
+	{
+		activeKernels->multiplyMat4(&left, 0, right, out, 0, count);
+	}
+
+	void BatchMath::MultiplyMat4(
+		const mat4* left,
+		const mat4* right,
+		mat4* out,
+		u32 count)
+	{
+		activeKernels->multiplyMat4(left, 1, right, out, 0, count);
+	}
+
+	void BatchMath::TransformVec4(
+		const mat4& matrix,
+		const Vec4Arrays& in,
+		const Vec4Arrays& out,
+		u32 count)
+	{
+		activeKernels->transformVec4(matrix, in, out, 0, count);
+	}
+
+	void BatchMath::TransformAABB(
+		const mat4& matrix,
+		const AABBArrays& in,
+		const AABBArrays& out,
+		u32 count)
+	{
+		activeKernels->transformAABB(matrix, in, out, 0, count);
+	}
+}
+
+SIMDLevel DetectSIMDLevel()
+{
+#ifdef CIRCUIT_BATCHMATH_X86
+	//AVX needs the CPU flag and the OS saving the upper register halves on context switches
+	bool hasAVX = false;
+
+#ifdef _MSC_VER
+	int info[4]{};
+	__cpuid(info, 1);
+
+	bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+	bool hasCPUAVX = (info[2] & (1 << 28)) != 0;
+	if (hasOSXSave
+		&& hasCPUAVX)
+	{
+		hasAVX = (_xgetbv(0) & 0x6) == 0x6;
+	}
+#else
+	unsigned int eax{};
+	unsigned int ebx{};
+	unsigned int ecx{};
+	unsigned int edx{};
+	if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+	{
+		bool hasOSXSave = (ecx & (1u << 27)) != 0;
+		bool hasCPUAVX = (ecx & (1u << 28)) != 0;
+		if (hasOSXSave
+			&& hasCPUAVX)
+		{
+			u32 low{};
+			u32 high{};
+			__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+			hasAVX = (low & 0x6) == 0x6;
+		}
+	}
+#endif
+
+	return hasAVX ? SIMDLevel::SIMD_AVX : SIMDLevel::SIMD_SSE;
+#else
+	return SIMDLevel::SIMD_Scalar;
+#endif
+}
+
+const KernelTable& GetKernelTable(SIMDLevel level)
+{
+	static const KernelTable scalarKernels =
+	{
+		ComposeTRSScalar,
+		MultiplyMat4Scalar,
+		TransformVec4Scalar,
+		TransformAABBScalar
+	};
+
+#ifdef CIRCUIT_BATCHMATH_X86
+	static const KernelTable sseKernels =
+	{
+		ComposeTRSSSE,
+		MultiplyMat4SSE,
+		TransformVec4SSE,
+		TransformAABBSSE
+	};
+	static const KernelTable avxKernels =
+	{
+		ComposeTRSAVX,
+		MultiplyMat4AVX,
+		TransformVec4AVX,
+		TransformAABBAVX
+	};
+
+	if (level == SIMDLevel::SIMD_AVX) return avxKernels;
+	if (level == SIMDLevel::SIMD_SSE) return sseKernels;
+#endif
+
+	return scalarKernels;
+}
+
+//
+// SCALAR
+//
+
+void ComposeTRSScalar(const TRSArrays& trs, mat4* out, u32 begin, u32 end)
+{
+	for (u32 i = begin; i < end; ++i)
+	{
+		f32 x = trs.rotX[i];
+		f32 y = trs.rotY[i];
+		f32 z = trs.rotZ[i];
+		f32 w = trs.rotW[i];
+
+		f32 xx = x * x;
+		f32 yy = y * y;
+		f32 zz = z * z;
+		f32 xy = x * y;
+		f32 xz = x * z;
+		f32 yz = y * z;
+		f32 wx = w * x;
+		f32 wy = w * y;
+		f32 wz = w * z;
+
+		f32 sx = trs.scaleX[i];
+		f32 sy = trs.scaleY[i];
+		f32 sz = trs.scaleZ[i];
+
+		f32* m = &out[i][0][0];
+
+		m[0] = (1.0f - 2.0f * (yy + zz)) * sx;
+		m[1] = 2.0f * (xy + wz) * sx;
+		m[2] = 2.0f * (xz - wy) * sx;
+		m[3] = 0.0f;
+
+		m[4] = 2.0f * (xy - wz) * sy;
+		m[5] = (1.0f - 2.0f * (xx + zz)) * sy;
+		m[6] = 2.0f * (yz + wx) * sy;
+		m[7] = 0.0f;
+
+		m[8] = 2.0f * (xz + wy) * sz;
+		m[9] = 2.0f * (yz - wx) * sz;
+		m[10] = (1.0f - 2.0f * (xx + yy)) * sz;
+		m[11] = 0.0f;
+
+		m[12] = trs.posX[i];
+		m[13] = trs.posY[i];
+		m[14] = trs.posZ[i];
+		m[15] = 1.0f;
+	}
+}
+
+void MultiplyMat4Scalar(const mat4* left, u32 leftStep, const mat4* right, mat4* out, u32 begin, u32 end)
+{
+	for (u32 i = begin; i < end; ++i)
+	{
+		//copies, out may be either input
+		mat4 a = left[i * leftStep];
+		mat4 b = right[i];
+
+		for (u32 column = 0; column < 4; ++column)
+		{
+			for (u32 row = 0; row < 4; ++row)
+			{
+				out[i][column][row] =
+					a[0][row] * b[column][0]
+					+ a[1][row] * b[column][1]
+					+ a[2][row] * b[column][2]
+					+ a[3][row] * b[column][3];
+			}
+		}
+	}
+}
+
+void TransformVec4Scalar(const mat4& matrix, const Vec4Arrays& in, const Vec4Arrays& out, u32 begin, u32 end)
+{
+	const mat4& m = matrix;
+
+	for (u32 i = begin; i < end; ++i)
+	{
+		f32 x = in.x[i];
+		f32 y = in.y[i];
+		f32 z = in.z[i];
+		f32 w = in.w[i];
+
+		out.x[i] = m[0][0] * x + m[1][0] * y + m[2][0] * z + m[3][0] * w;
+		out.y[i] = m[0][1] * x + m[1][1] * y + m[2][1] * z + m[3][1] * w;
+		out.z[i] = m[0][2] * x + m[1][2] * y + m[2][2] * z + m[3][2] * w;
+		out.w[i] = m[0][3] * x + m[1][3] * y + m[2][3] * z + m[3][3] * w;
+	}
+}
+
+void TransformAABBScalar(const mat4& matrix, const AABBArrays& in, const AABBArrays& out, u32 begin, u32 end)
+{
+	const mat4& m = matrix;
+
+	//the new half extent on each axis is the old one projected through the absolute rotation and scale
+	for (u32 i = begin; i < end; ++i)
+	{
+		f32 centerX = (in.minX[i] + in.maxX[i]) * 0.5f;
+		f32 centerY = (in.minY[i] + in.maxY[i]) * 0.5f;
+		f32 centerZ = (in.minZ[i] + in.maxZ[i]) * 0.5f;
+		f32 extentX = (in.maxX[i] - in.minX[i]) * 0.5f;
+		f32 extentY = (in.maxY[i] - in.minY[i]) * 0.5f;
+		f32 extentZ = (in.maxZ[i] - in.minZ[i]) * 0.5f;
+
+		f32 newCenter[3]{};
+		f32 newExtent[3]{};
+		for (u32 axis = 0; axis < 3; ++axis)
+		{
+			newCenter[axis] = m[0][axis] * centerX + m[1][axis] * centerY + m[2][axis] * centerZ + m[3][axis];
+			newExtent[axis] = abs(m[0][axis]) * extentX + abs(m[1][axis]) * extentY + abs(m[2][axis]) * extentZ;
+		}
+
+		out.minX[i] = newCenter[0] - newExtent[0];
+		out.minY[i] = newCenter[1] - newExtent[1];
+		out.minZ[i] = newCenter[2] - newExtent[2];
+		out.maxX[i] = newCenter[0] + newExtent[0];
+		out.maxY[i] = newCenter[1] + newExtent[1];
+		out.maxZ[i] = newCenter[2] + newExtent[2];
+	}
+}
+
+#ifdef CIRCUIT_BATCHMATH_X86
+
+//
+// SSE
+//
+
+void ComposeTRSSSE(const TRSArrays& trs, mat4* out, u32 begin, u32 end)
+{
+	__m128 one = _mm_set1_ps(1.0f);
+	__m128 two = _mm_set1_ps(2.0f);
+	__m128 zero = _mm_setzero_ps();
+
+	u32 i = begin;
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(trs.rotX + i);
+		__m128 y = _mm_loadu_ps(trs.rotY + i);
+		__m128 z = _mm_loadu_ps(trs.rotZ + i);
+		__m128 w = _mm_loadu_ps(trs.rotW + i);
+
+		__m128 xx = _mm_mul_ps(x, x);
+		__m128 yy = _mm_mul_ps(y, y);
+		__m128 zz = _mm_mul_ps(z, z);
+		__m128 xy = _mm_mul_ps(x, y);
+		__m128 xz = _mm_mul_ps(x, z);
+		__m128 yz = _mm_mul_ps(y, z);
+		__m128 wx = _mm_mul_ps(w, x);
+		__m128 wy = _mm_mul_ps(w, y);
+		__m128 wz = _mm_mul_ps(w, z);
+
+		__m128 sx = _mm_loadu_ps(trs.scaleX + i);
+		__m128 sy = _mm_loadu_ps(trs.scaleY + i);
+		__m128 sz = _mm_loadu_ps(trs.scaleZ + i);
+
+		StoreColumnSSE(out + i, 0,
+			_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+			_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+			_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+			zero);
+		StoreColumnSSE(out + i, 1,
+			_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+			_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+			_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+			zero);
+		StoreColumnSSE(out + i, 2,
+			_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+			_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+			_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+			zero);
+		StoreColumnSSE(out + i, 3,
+			_mm_loadu_ps(trs.posX + i),
+			_mm_loadu_ps(trs.posY + i),
+			_mm_loadu_ps(trs.posZ + i),
+			one);
+	}
+
+	ComposeTRSScalar(trs, out, i, end);
+}
+
+void MultiplyMat4SSE(const mat4* left, u32 leftStep, const mat4* right, mat4* out, u32 begin, u32 end)
+{
+	for (u32 i = begin; i < end; ++i)
+	{
+		const f32* a = &left[i * leftStep][0][0];
+		__m128 a0 = _mm_loadu_ps(a);
+		__m128 a1 = _mm_loadu_ps(a + 4);
+		__m128 a2 = _mm_loadu_ps(a + 8);
+		__m128 a3 = _mm_loadu_ps(a + 12);
+
+		const f32* b = &right[i][0][0];
+		f32* result = &out[i][0][0];
+
+		//each result column only reads the same column of right, so writing it back is safe
+		for (u32 column = 0; column < 4; ++column)
+		{
+			__m128 bColumn = _mm_loadu_ps(b + column * 4);
+
+			__m128 sum = _mm_mul_ps(a0, _mm_shuffle_ps(bColumn, bColumn, 0x00));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a1, _mm_shuffle_ps(bColumn, bColumn, 0x55)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a2, _mm_shuffle_ps(bColumn, bColumn, 0xAA)));
+			sum = _mm_add_ps(sum, _mm_mul_ps(a3, _mm_shuffle_ps(bColumn, bColumn, 0xFF)));
+
+			_mm_storeu_ps(result + column * 4, sum);
+		}
+	}
+}
+
+void TransformVec4SSE(const mat4& matrix, const Vec4Arrays& in, const Vec4Arrays& out, u32 begin, u32 end)
+{
+	__m128 m[4][4]{};
+	for (u32 column = 0; column < 4; ++column)
+	{
+		for (u32 row = 0; row < 4; ++row) m[column][row] = _mm_set1_ps(matrix[column][row]);
+	}
+
+	u32 i = begin;
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(in.x + i);
+		__m128 y = _mm_loadu_ps(in.y + i);
+		__m128 z = _mm_loadu_ps(in.z + i);
+		__m128 w = _mm_loadu_ps(in.w + i);
+
+		__m128 result[4]{};
+		for (u32 row = 0; row < 4; ++row)
+		{
+			__m128 sum = _mm_mul_ps(m[0][row], x);
+			sum = _mm_add_ps(sum, _mm_mul_ps(m[1][row], y));
+			sum = _mm_add_ps(sum, _mm_mul_ps(m[2][row], z));
+			result[row] = _mm_add_ps(sum, _mm_mul_ps(m[3][row], w));
+		}
+
+		_mm_storeu_ps(out.x + i, result[0]);
+		_mm_storeu_ps(out.y + i, result[1]);
+		_mm_storeu_ps(out.z + i, result[2]);
+		_mm_storeu_ps(out.w + i, result[3]);
+	}
+
+	TransformVec4Scalar(matrix, in, out, i, end);
+}
+
+void TransformAABBSSE(const mat4& matrix, const AABBArrays& in, const AABBArrays& out, u32 begin, u32 end)
+{
+	__m128 m[4][3]{};
+	__m128 absolute[3][3]{};
+	for (u32 column = 0; column < 4; ++column)
+	{
+		for (u32 row = 0; row < 3; ++row)
+		{
+			m[column][row] = _mm_set1_ps(matrix[column][row]);
+			if (column < 3) absolute[column][row] = _mm_set1_ps(abs(matrix[column][row]));
+		}
+	}
+
+	__m128 half = _mm_set1_ps(0.5f);
+
+	u32 i = begin;
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 minX = _mm_loadu_ps(in.minX + i);
+		__m128 minY = _mm_loadu_ps(in.minY + i);
+		__m128 minZ = _mm_loadu_ps(in.minZ + i);
+		__m128 maxX = _mm_loadu_ps(in.maxX + i);
+		__m128 maxY = _mm_loadu_ps(in.maxY + i);
+		__m128 maxZ = _mm_loadu_ps(in.maxZ + i);
+
+		__m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+		__m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+		__m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+		__m128 extentX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+		__m128 extentY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+		__m128 extentZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+		__m128 newMin[3]{};
+		__m128 newMax[3]{};
+		for (u32 axis = 0; axis < 3; ++axis)
+		{
+			__m128 center = _mm_mul_ps(m[0][axis], centerX);
+			center = _mm_add_ps(center, _mm_mul_ps(m[1][axis], centerY));
+			center = _mm_add_ps(center, _mm_mul_ps(m[2][axis], centerZ));
+			center = _mm_add_ps(center, m[3][axis]);
+
+			__m128 extent = _mm_mul_ps(absolute[0][axis], extentX);
+			extent = _mm_add_ps(extent, _mm_mul_ps(absolute[1][axis], extentY));
+			extent = _mm_add_ps(extent, _mm_mul_ps(absolute[2][axis], extentZ));
+
+			newMin[axis] = _mm_sub_ps(center, extent);
+			newMax[axis] = _mm_add_ps(center, extent);
+		}
+
+		_mm_storeu_ps(out.minX + i, newMin[0]);
+		_mm_storeu_ps(out.minY + i, newMin[1]);
+		_mm_storeu_ps(out.minZ + i, newMin[2]);
+		_mm_storeu_ps(out.maxX + i, newMax[0]);
+		_mm_storeu_ps(out.maxY + i, newMax[1]);
+		_mm_storeu_ps(out.maxZ + i, newMax[2]);
+	}
+
+	TransformAABBScalar(matrix, in, out, i, end);
+}
+
+void StoreColumnSSE(mat4* out, u32 column, __m128 row0, __m128 row1, __m128 row2, __m128 row3)
+{
+	//lane k of every row belongs to matrix k, after the transpose register k is its column
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+	_mm_storeu_ps(&out[0][column][0], row0);
+	_mm_storeu_ps(&out[1][column][0], row1);
+	_mm_storeu_ps(&out[2][column][0], row2);
+	_mm_storeu_ps(&out[3][column][0], row3);
+}
+
+//
+// AVX
+//
+
+void ComposeTRSAVX(const TRSArrays& trs, mat4* out, u32 begin, u32 end)
+{
+	__m256 one = _mm256_set1_ps(1.0f);
+	__m256 two = _mm256_set1_ps(2.0f);
+	__m256 zero = _mm256_setzero_ps();
+
+	u32 i = begin;
+	for (; i + 8 <= end; i += 8)
+	{
+		__m256 x = _mm256_loadu_ps(trs.rotX + i);
+		__m256 y = _mm256_loadu_ps(trs.rotY + i);
+		__m256 z = _mm256_loadu_ps(trs.rotZ + i);
+		__m256 w = _mm256_loadu_ps(trs.rotW + i);
+
+		__m256 xx = _mm256_mul_ps(x, x);
+		__m256 yy = _mm256_mul_ps(y, y);
+		__m256 zz = _mm256_mul_ps(z, z);
+		__m256 xy = _mm256_mul_ps(x, y);
+		__m256 xz = _mm256_mul_ps(x, z);
+		__m256 yz = _mm256_mul_ps(y, z);
+		__m256 wx = _mm256_mul_ps(w, x);
+		__m256 wy = _mm256_mul_ps(w, y);
+		__m256 wz = _mm256_mul_ps(w, z);
+
+		__m256 sx = _mm256_loadu_ps(trs.scaleX + i);
+		__m256 sy = _mm256_loadu_ps(trs.scaleY + i);
+		__m256 sz = _mm256_loadu_ps(trs.scaleZ + i);
+
+		StoreColumnAVX(out + i, 0,
+			_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx),
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx),
+			zero);
+		StoreColumnAVX(out + i, 1,
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+			_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy),
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy),
+			zero);
+		StoreColumnAVX(out + i, 2,
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+			_mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+			_mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz),
+			zero);
+		StoreColumnAVX(out + i, 3,
+			_mm256_loadu_ps(trs.posX + i),
+			_mm256_loadu_ps(trs.posY + i),
+			_mm256_loadu_ps(trs.posZ + i),
+			one);
+	}
+
+	ComposeTRSScalar(trs, out, i, end);
+}
+
+void MultiplyMat4AVX(const mat4* left, u32 leftStep, const mat4* right, mat4* out, u32 begin, u32 end)
+{
+	for (u32 i = begin; i < end; ++i)
+	{
+		//every left column in both halves, two result columns per step
+		const f32* a = &left[i * leftStep][0][0];
+		__m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+		__m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+		__m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+		__m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+
+		const f32* b = &right[i][0][0];
+		f32* result = &out[i][0][0];
+
+		for (u32 column = 0; column < 4; column += 2)
+		{
+			__m256 bColumns = _mm256_loadu_ps(b + column * 4);
+
+			__m256 sum = _mm256_mul_ps(a0, _mm256_permute_ps(bColumns, 0x00));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(a1, _mm256_permute_ps(bColumns, 0x55)));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(a2, _mm256_permute_ps(bColumns, 0xAA)));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(a3, _mm256_permute_ps(bColumns, 0xFF)));
+
+			_mm256_storeu_ps(result + column * 4, sum);
+		}
+	}
+}
+
+void TransformVec4AVX(const mat4& matrix, const Vec4Arrays& in, const Vec4Arrays& out, u32 begin, u32 end)
+{
+	__m256 m[4][4]{};
+	for (u32 column = 0; column < 4; ++column)
+	{
+		for (u32 row = 0; row < 4; ++row) m[column][row] = _mm256_set1_ps(matrix[column][row]);
+	}
+
+	u32 i = begin;
+	for (; i + 8 <= end; i += 8)
+	{
+		__m256 x = _mm256_loadu_ps(in.x + i);
+		__m256 y = _mm256_loadu_ps(in.y + i);
+		__m256 z = _mm256_loadu_ps(in.z + i);
+		__m256 w = _mm256_loadu_ps(in.w + i);
+
+		__m256 result[4]{};
+		for (u32 row = 0; row < 4; ++row)
+		{
+			__m256 sum = _mm256_mul_ps(m[0][row], x);
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(m[1][row], y));
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(m[2][row], z));
+			result[row] = _mm256_add_ps(sum, _mm256_mul_ps(m[3][row], w));
+		}
+
+		_mm256_storeu_ps(out.x + i, result[0]);
+		_mm256_storeu_ps(out.y + i, result[1]);
+		_mm256_storeu_ps(out.z + i, result[2]);
+		_mm256_storeu_ps(out.w + i, result[3]);
+	}
+
+	TransformVec4Scalar(matrix, in, out, i, end);
+}
+
+void TransformAABBAVX(const mat4& matrix, const AABBArrays& in, const AABBArrays& out, u32 begin, u32 end)
+{
+	__m256 m[4][3]{};
+	__m256 absolute[3][3]{};
+	for (u32 column = 0; column < 4; ++column)
+	{
+		for (u32 row = 0; row < 3; ++row)
+		{
+			m[column][row] = _mm256_set1_ps(matrix[column][row]);
+			if (column < 3) absolute[column][row] = _mm256_set1_ps(abs(matrix[column][row]));
+		}
+	}
+
+	__m256 half = _mm256_set1_ps(0.5f);
+
+	u32 i = begin;
+	for (; i + 8 <= end; i += 8)
+	{
+		__m256 minX = _mm256_loadu_ps(in.minX + i);
+		__m256 minY = _mm256_loadu_ps(in.minY + i);
+		__m256 minZ = _mm256_loadu_ps(in.minZ + i);
+		__m256 maxX = _mm256_loadu_ps(in.maxX + i);
+		__m256 maxY = _mm256_loadu_ps(in.maxY + i);
+		__m256 maxZ = _mm256_loadu_ps(in.maxZ + i);
+
+		__m256 centerX = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+		__m256 centerY = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+		__m256 centerZ = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+		__m256 extentX = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+		__m256 extentY = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+		__m256 extentZ = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+		__m256 newMin[3]{};
+		__m256 newMax[3]{};
+		for (u32 axis = 0; axis < 3; ++axis)
+		{
+			__m256 center = _mm256_mul_ps(m[0][axis], centerX);
+			center = _mm256_add_ps(center, _mm256_mul_ps(m[1][axis], centerY));
+			center = _mm256_add_ps(center, _mm256_mul_ps(m[2][axis], centerZ));
+			center = _mm256_add_ps(center, m[3][axis]);
+
+			__m256 extent = _mm256_mul_ps(absolute[0][axis], extentX);
+			extent = _mm256_add_ps(extent, _mm256_mul_ps(absolute[1][axis], extentY));
+			extent = _mm256_add_ps(extent, _mm256_mul_ps(absolute[2][axis], extentZ));
+
+			newMin[axis] = _mm256_sub_ps(center, extent);
+			newMax[axis] = _mm256_add_ps(center, extent);
+		}
+
+		_mm256_storeu_ps(out.minX + i, newMin[0]);
+		_mm256_storeu_ps(out.minY + i, newMin[1]);
+		_mm256_storeu_ps(out.minZ + i, newMin[2]);
+		_mm256_storeu_ps(out.maxX + i, newMax[0]);
+		_mm256_storeu_ps(out.maxY + i, newMax[1]);
+		_mm256_storeu_ps(out.maxZ + i, newMax[2]);
+	}
+
+	TransformAABBScalar(matrix, in, out, i, end);
+}
+
+void StoreColumnAVX(mat4* out, u32 column, __m256 row0, __m256 row1, __m256 row2, __m256 row3)
+{
+	//transposes within each 128-bit half, the low half holds matrices 0-3 and the high half 4-7
+	__m256 low01 = _mm256_unpacklo_ps(row0, row1);
+	__m256 high01 = _mm256_unpackhi_ps(row0, row1);
+	__m256 low23 = _mm256_unpacklo_ps(row2, row3);
+	__m256 high23 = _mm256_unpackhi_ps(row2, row3);
+
+	__m256 column0 = _mm256_shuffle_ps(low01, low23, 0x44);
+	__m256 column1 = _mm256_shuffle_ps(low01, low23, 0xEE);
+	__m256 column2 = _mm256_shuffle_ps(high01, high23, 0x44);
+	__m256 column3 = _mm256_shuffle_ps(high01, high23, 0xEE);
+
+	_mm_storeu_ps(&out[0][column][0], _mm256_castps256_ps128(column0));
+	_mm_storeu_ps(&out[1][column][0], _mm256_castps256_ps128(column1));
+	_mm_storeu_ps(&out[2][column][0], _mm256_castps256_ps128(column2));
+	_mm_storeu_ps(&out[3][column][0], _mm256_castps256_ps128(column3));
+	_mm_storeu_ps(&out[4][column][0], _mm256_extractf128_ps(column0, 1));
+	_mm_storeu_ps(&out[5][column][0], _mm256_extractf128_ps(column1, 1));
+	_mm_storeu_ps(&out[6][column][0], _mm256_extractf128_ps(column2, 1));
+	_mm_storeu_ps(&out[7][column][0], _mm256_extractf128_ps(column3, 1));
+}
+#endif
\ No newline at end of file
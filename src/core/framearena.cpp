@@ -0,0 +1,201 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <atomic>
+#include <vector>
+#include <new>
+#include <algorithm>
+#include <cstdint>
+
+#include "core/framearena.hpp"
+
+using CircuitGame::Core::FrameArena;
+
+using std::atomic;
+using std::vector;
+using std::size_t;
+using std::uintptr_t;
+using std::align_val_t;
+using std::nothrow;
+using std::min;
+using std::max;
+using std::memory_order_relaxed;
+
+//Threads that can allocate, every worker, the game, render and log threads
+static constexpr u32 FRAME_ARENA_MAX_THREADS = 64;
+
+//Size of the first block of a sub-arena, later blocks grow with the usage
+static constexpr size_t FRAME_ARENA_BLOCK_SIZE = 64 * 1024;
+static constexpr size_t FRAME_ARENA_BLOCK_ALIGNMENT = 64;
+
+static constexpr u32 NO_SLOT = 0xFFFFFFFF;
+
+struct ArenaBlock
+{
+	u8* memory{};
+	size_t size{};
+};
+
+struct SubArena
+{
+	vector<ArenaBlock> blocks{};
+	u32 blockIndex{};
+	size_t offset{};
+	size_t used{};
+};
+
+//[frame parity][thread slot], each thread only ever touches its own slot
+static SubArena subArenas[2][FRAME_ARENA_MAX_THREADS]{};
+static atomic<u32> slotCount{};
+static atomic<u32> currentSet{};
+
+static thread_local u32 threadSlot = NO_SLOT;
+
+static bool AddBlock(
+	SubArena& arena,
+	size_t minimumSize);
+static void ResetSubArena(SubArena& arena);
+static void FreeSubArena(SubArena& arena);
+
+namespace CircuitGame::Core
+{
+	void* FrameArena::Allocate(
+		size_t size,
+		size_t alignment)
+	{
+		if (threadSlot == NO_SLOT)
+		{
+			u32 slot = slotCount.fetch_add(1, memory_order_relaxed);
+			if (slot >= FRAME_ARENA_MAX_THREADS) return nullptr;
+
+			threadSlot = slot;
+		}
+
+		SubArena& arena = subArenas[currentSet.load(memory_order_relaxed)][threadSlot];
+
+		while (true)
+		{
+			if (arena.blockIndex < arena.blocks.size())
+			{
+				ArenaBlock& block = arena.blocks[arena.blockIndex];
+
+				uintptr_t base = reinterpret_cast<uintptr_t>(block.memory);
+				uintptr_t aligned = (base + arena.offset + alignment - 1) & ~(alignment - 1);
+				size_t start = static_cast<size_t>(aligned - base);
+				if (start + size <= block.size)
+				{
+					arena.offset = start + size;
+					arena.used += size;
+
+					return block.memory + start;
+				}
+
+				//the rest of this block is wasted until the reset
+				if (arena.blockIndex + 1 < arena.blocks.size())
+				{
+					++arena.blockIndex;
+					arena.offset = 0;
+					continue;
+				}
+			}
+
+			if (!AddBlock(arena, size + alignment)) return nullptr;
+		}
+	}
+
+	void FrameArena::EndFrame()
+	{
+		u32 finishedSet = currentSet.load(memory_order_relaxed);
+		u32 nextSet = finishedSet ^ 1;
+		u32 slots = min(slotCount.load(memory_order_relaxed), FRAME_ARENA_MAX_THREADS);
+
+		lastFrameBytes = 0;
+		for (u32 i = 0; i < slots; ++i)
+		{
+			lastFrameBytes += subArenas[finishedSet][i].used;
+			ResetSubArena(subArenas[nextSet][i]);
+		}
+
+		currentSet.store(nextSet, memory_order_relaxed);
+		++frameIndex;
+	}
+
+	size_t FrameArena::GetCapacity()
+	{
+		size_t capacity = 0;
+		for (auto& set : subArenas)
+		{
+			for (auto& arena : set)
+			{
+				for (const auto& block : arena.blocks) capacity += block.size;
+			}
+		}
+
+		return capacity;
+	}
+
+	void FrameArena::Shutdown()
+	{
+		for (auto& set : subArenas)
+		{
+			for (auto& arena : set) FreeSubArena(arena);
+		}
+
+		lastFrameBytes = 0;
+	}
+}
+
+bool AddBlock(
+	SubArena& arena,
+	size_t minimumSize)
+{
+	//doubles so a growing frame needs few blocks
+	size_t size = arena.blocks.empty()
+		? FRAME_ARENA_BLOCK_SIZE
+		: arena.blocks.back().size * 2;
+	size = max(size, minimumSize);
+
+	void* memory = ::operator new(size, align_val_t{ FRAME_ARENA_BLOCK_ALIGNMENT }, nothrow);
+	if (memory == nullptr) return false;
+
+	arena.blocks.push_back({ static_cast<u8*>(memory), size });
+	arena.blockIndex = static_cast<u32>(arena.blocks.size() - 1);
+	arena.offset = 0;
+
+	return true;
+}
+
+void ResetSubArena(SubArena& arena)
+{
+	//a frame that needed several blocks gets one block of the whole size,
+	//so the same usage next time is a single bump pointer again
+	if (arena.blocks.size() > 1)
+	{
+		size_t total = 0;
+		for (const auto& block : arena.blocks) total += block.size;
+
+		FreeSubArena(arena);
+
+		void* memory = ::operator new(total, align_val_t{ FRAME_ARENA_BLOCK_ALIGNMENT }, nothrow);
+		if (memory != nullptr) arena.blocks.push_back({ static_cast<u8*>(memory), total });
+	}
+
+	arena.blockIndex = 0;
+	arena.offset = 0;
+	arena.used = 0;
+}
+
+void FreeSubArena(SubArena& arena)
+{
+	for (const auto& block : arena.blocks)
+	{
+		::operator delete(block.memory, align_val_t{ FRAME_ARENA_BLOCK_ALIGNMENT });
+	}
+
+	arena.blocks.clear();
+	arena.blockIndex = 0;
+	arena.offset = 0;
+	arena.used = 0;
+}
\ No newline at end of file
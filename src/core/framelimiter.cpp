@@ -0,0 +1,245 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <string>
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+//kalawindow
+#include "core/log.hpp"
+
+#include "core/framelimiter.hpp"
+
+//kalawindow
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Core::FrameLimiter;
+
+using std::string;
+using std::to_string;
+using std::abs;
+using std::sqrt;
+using std::this_thread::sleep_for;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::chrono::duration_cast;
+
+static constexpr f64 TARGET_RATES[] = { 60.0, 144.0, 240.0, 0.0 };
+static constexpr u32 TARGET_RATE_COUNT = sizeof(TARGET_RATES) / sizeof(TARGET_RATES[0]);
+
+//how fast the sleep and jitter averages follow new samples
+static constexpr f64 SMOOTHING = 0.05;
+
+static steady_clock::time_point nextFrameStart{};
+static steady_clock::time_point lastFrameStart{};
+static bool hasLastFrame{};
+
+//how late sleeps wake up on this machine, the spin covers anything below mean + deviation
+static f64 oversleepMean = 0.001;
+static f64 oversleepVariance{};
+
+#ifdef _WIN32
+static HANDLE sleepTimer{};
+static bool hasTimerPeriod{};
+#endif
+
+//a sleep preempted for longer than a frame says nothing about the timer,
+//anything shorter is what sleeps really cost here and is learned as it is
+static void UpdateOversleepEstimate(
+	f64 observed,
+	f64 targetInterval);
+static void SleepFor(f64 seconds);
+static void SpinPause();
+
+namespace CircuitGame::Core
+{
+	void FrameLimiter::Initialize()
+	{
+#ifdef _WIN32
+		//Windows 10 1803 and newer, waits on this are not rounded to the system tick
+		sleepTimer = CreateWaitableTimerExW(
+			nullptr,
+			nullptr,
+			CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+			TIMER_ALL_ACCESS);
+
+		if (sleepTimer == nullptr)
+		{
+			hasTimerPeriod = timeBeginPeriod(1) == TIMERR_NOERROR;
+
+			Logger::Print(
+				"High resolution timer is not available, using a 1ms timer period.",
+				"FRAME_LIMITER",
+				LogType::LOG_DEBUG);
+		}
+#endif
+	}
+
+	void FrameLimiter::Shutdown()
+	{
+#ifdef _WIN32
+		if (sleepTimer != nullptr)
+		{
+			CloseHandle(sleepTimer);
+			sleepTimer = nullptr;
+		}
+		if (hasTimerPeriod)
+		{
+			timeEndPeriod(1);
+			hasTimerPeriod = false;
+		}
+#endif
+	}
+
+	void FrameLimiter::SetEnabled(bool newEnabled)
+	{
+		isEnabled = newEnabled;
+		hasLastFrame = false;
+	}
+
+	void FrameLimiter::SetTargetRate(f64 newTargetRate)
+	{
+		targetRate = newTargetRate;
+		hasLastFrame = false;
+	}
+
+	void FrameLimiter::CycleTargetRate()
+	{
+		u32 next = 0;
+		for (u32 i = 0; i < TARGET_RATE_COUNT; ++i)
+		{
+			if (TARGET_RATES[i] == targetRate)
+			{
+				next = (i + 1) % TARGET_RATE_COUNT;
+				break;
+			}
+		}
+		SetTargetRate(TARGET_RATES[next]);
+
+		string rate = targetRate > 0.0
+			? to_string(static_cast<u32>(targetRate)) + " FPS"
+			: "uncapped";
+
+		Logger::Print(
+			"Set 'frame limit' to '" + rate + "'",
+			"FRAME_LIMITER",
+			LogType::LOG_DEBUG);
+	}
+
+	void FrameLimiter::Wait()
+	{
+		auto now = steady_clock::now();
+
+		if (!isEnabled
+			|| targetRate <= 0.0)
+		{
+			hasLastFrame = false;
+			return;
+		}
+
+		f64 targetInterval = 1.0 / targetRate;
+		auto interval = duration_cast<steady_clock::duration>(duration<f64>(targetInterval));
+
+		if (!hasLastFrame)
+		{
+			lastFrameStart = now;
+			nextFrameStart = now + interval;
+			hasLastFrame = true;
+			return;
+		}
+
+		//coarse part, sleep until the expected oversleep would just end at the frame start
+
+		while (true)
+		{
+			f64 margin = oversleepMean + sqrt(oversleepVariance);
+			f64 request = duration<f64>(nextFrameStart - now).count() - margin;
+			if (request <= 0.0) break;
+
+			SleepFor(request);
+
+			auto afterSleep = steady_clock::now();
+			UpdateOversleepEstimate(
+				duration<f64>(afterSleep - now).count() - request,
+				targetInterval);
+			now = afterSleep;
+		}
+
+		//fine part, spin out the last fraction of a millisecond
+
+		while (now < nextFrameStart)
+		{
+			SpinPause();
+			now = steady_clock::now();
+		}
+
+		f64 measured = duration<f64>(now - lastFrameStart).count();
+		jitter += (abs(measured - targetInterval) * 1000.0 - jitter) * SMOOTHING;
+
+		lastFrameStart = now;
+
+		//stay on the fixed grid so small late wakeups do not add up,
+		//unless a frame ran long enough to miss its slot completely
+		nextFrameStart += interval;
+		if (nextFrameStart < now) nextFrameStart = now + interval;
+	}
+}
+
+void UpdateOversleepEstimate(
+	f64 observed,
+	f64 targetInterval)
+{
+	if (observed > targetInterval) return;
+	if (observed < 0.0) observed = 0.0;
+
+	f64 delta = observed - oversleepMean;
+	oversleepMean += delta * SMOOTHING;
+	oversleepVariance += (delta * delta - oversleepVariance) * SMOOTHING;
+}
+
+void SleepFor(f64 seconds)
+{
+#ifdef _WIN32
+	if (sleepTimer != nullptr)
+	{
+		//relative due time in 100 nanosecond units
+		LARGE_INTEGER dueTime{};
+		dueTime.QuadPart = -static_cast<LONGLONG>(seconds * 1e7);
+
+		if (SetWaitableTimerEx(
+			sleepTimer,
+			&dueTime,
+			0,
+			nullptr,
+			nullptr,
+			nullptr,
+			0))
+		{
+			WaitForSingleObject(sleepTimer, INFINITE);
+			return;
+		}
+	}
+#endif
+	sleep_for(duration<f64>(seconds));
+}
+
+void SpinPause()
+{
+#if defined(_M_X64) || defined(__x86_64__)
+	_mm_pause();
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,365 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+//kalawindow
+#include "core/log.hpp"
+
+#include "core/framestats.hpp"
+
+//kalawindow
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Core::FrameStats;
+using CircuitGame::Core::FrameMetric;
+using CircuitGame::Core::FrameMetricSummary;
+using CircuitGame::Core::FRAME_METRIC_COUNT;
+using CircuitGame::Core::GetFrameMetricName;
+
+using std::atomic;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::vector;
+using std::string;
+using std::to_string;
+using std::ofstream;
+using std::min;
+using std::max;
+using std::ceil;
+using std::filesystem::path;
+using std::filesystem::current_path;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+//Frames the histograms cover
+static constexpr u32 FRAME_STATS_WINDOW = 1024;
+
+//0.1ms buckets up to 100ms, the last bucket holds everything slower
+static constexpr f32 BUCKET_WIDTH = 0.1f;
+static constexpr u32 BUCKET_COUNT = 1000;
+
+//Frames needed before the median is trusted for hitch detection
+static constexpr u32 HITCH_MIN_SAMPLES = 60;
+
+static constexpr u32 REPORT_QUEUE_SIZE = 256;
+
+struct FrameRecord
+{
+	u64 frameIndex{};
+	f32 values[FRAME_METRIC_COUNT]{}; //negative if never reported
+	bool isHitch{};
+	bool isValid{};
+};
+
+struct StageReport
+{
+	u64 frameIndex{};
+	FrameMetric metric{};
+	f32 milliseconds{};
+};
+
+static FrameRecord frameWindow[FRAME_STATS_WINDOW]{};
+static u32 histograms[FRAME_METRIC_COUNT][BUCKET_COUNT]{};
+static u32 sampleCounts[FRAME_METRIC_COUNT]{};
+
+static steady_clock::time_point frameStart{};
+static steady_clock::time_point stageStart{};
+static f32 stageTimes[FRAME_METRIC_COUNT]{};
+
+//single producer, single consumer ring, the render thread only writes reportHead
+static StageReport reports[REPORT_QUEUE_SIZE]{};
+static atomic<u32> reportHead{};
+static atomic<u32> reportTail{};
+
+static u64 captureStart{};
+static vector<FrameRecord> capturedFrames{};
+
+static void AddValue(
+	FrameRecord& record,
+	FrameMetric metric,
+	f32 milliseconds);
+static bool EvictRecord(FrameRecord& record);
+static void DrainReports();
+static void WriteCapture();
+static u32 GetBucket(f32 milliseconds);
+
+namespace CircuitGame::Core
+{
+	void FrameStats::BeginFrame()
+	{
+		frameStart = steady_clock::now();
+		stageStart = frameStart;
+
+		for (auto& time : stageTimes) time = -1.0f;
+	}
+
+	void FrameStats::EndStage(FrameMetric metric)
+	{
+		auto now = steady_clock::now();
+		duration<f32, std::milli> elapsed = now - stageStart;
+		stageStart = now;
+
+		f32& time = stageTimes[static_cast<u32>(metric)];
+		time = max(time, 0.0f) + elapsed.count();
+	}
+
+	void FrameStats::EndFrame(bool discard)
+	{
+		if (discard)
+		{
+			++frameIndex;
+			DrainReports();
+			return;
+		}
+
+		duration<f32, std::milli> frameTime = steady_clock::now() - frameStart;
+
+		FrameRecord& record = frameWindow[frameIndex % FRAME_STATS_WINDOW];
+		if (record.isValid
+			&& EvictRecord(record))
+		{
+			--hitchCount;
+		}
+
+		record.frameIndex = frameIndex;
+		record.isValid = true;
+		record.isHitch = false;
+		for (auto& value : record.values) value = -1.0f;
+
+		//compare against the median before this frame is part of it
+		FrameMetricSummary cpu = GetSummary(FrameMetric::Metric_CPUFrame);
+		if (cpu.sampleCount >= HITCH_MIN_SAMPLES
+			&& frameTime.count() > cpu.p50 * 2.0f)
+		{
+			record.isHitch = true;
+			++hitchCount;
+			++totalHitchCount;
+		}
+
+		AddValue(record, FrameMetric::Metric_CPUFrame, frameTime.count());
+		for (u32 i = 0; i < FRAME_METRIC_COUNT; ++i)
+		{
+			if (stageTimes[i] >= 0.0f) AddValue(record, static_cast<FrameMetric>(i), stageTimes[i]);
+		}
+
+		++frameIndex;
+
+		//after the record exists, the render thread may already have reported this frame
+		DrainReports();
+	}
+
+	FrameMetricSummary FrameStats::GetSummary(FrameMetric metric)
+	{
+		u32 index = static_cast<u32>(metric);
+
+		FrameMetricSummary summary{};
+		summary.sampleCount = sampleCounts[index];
+		if (summary.sampleCount == 0) return summary;
+
+		u32 p50Target = static_cast<u32>(ceil(summary.sampleCount * 0.50f));
+		u32 p95Target = static_cast<u32>(ceil(summary.sampleCount * 0.95f));
+		u32 p99Target = static_cast<u32>(ceil(summary.sampleCount * 0.99f));
+
+		//upper edge of the bucket, percentiles never read lower than the real value
+		u32 cumulative = 0;
+		for (u32 bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+		{
+			u32 count = histograms[index][bucket];
+			if (count == 0) continue;
+
+			u32 previous = cumulative;
+			cumulative += count;
+			f32 edge = static_cast<f32>(bucket + 1) * BUCKET_WIDTH;
+
+			if (previous < p50Target && cumulative >= p50Target) summary.p50 = edge;
+			if (previous < p95Target && cumulative >= p95Target) summary.p95 = edge;
+			if (previous < p99Target && cumulative >= p99Target)
+			{
+				summary.p99 = edge;
+				break;
+			}
+		}
+
+		//exact max, the last bucket is open ended
+		for (const auto& record : frameWindow)
+		{
+			if (record.isValid) summary.max = max(summary.max, record.values[index]);
+		}
+
+		return summary;
+	}
+
+	void FrameStats::ToggleCapture()
+	{
+		if (!isCapturing)
+		{
+			captureStart = frameIndex;
+			capturedFrames.clear();
+			capturedFrames.reserve(FRAME_STATS_WINDOW * 16);
+			isCapturing = true;
+
+			Logger::Print(
+				"Started frame stats capture.",
+				"FRAME_STATS",
+				LogType::LOG_DEBUG);
+
+			return;
+		}
+
+		//frames still in the window were never evicted, oldest first
+		for (u32 i = 0; i < FRAME_STATS_WINDOW; ++i)
+		{
+			const FrameRecord& record = frameWindow[(frameIndex + i) % FRAME_STATS_WINDOW];
+			if (record.isValid
+				&& record.frameIndex >= captureStart)
+			{
+				capturedFrames.push_back(record);
+			}
+		}
+
+		isCapturing = false;
+		WriteCapture();
+	}
+
+	void FrameStats::Report(
+		u64 reportFrameIndex,
+		FrameMetric metric,
+		f32 milliseconds)
+	{
+		u32 head = reportHead.load(memory_order_relaxed);
+		u32 next = (head + 1) % REPORT_QUEUE_SIZE;
+
+		//full, the game thread is far behind and this sample is not worth blocking for
+		if (next == reportTail.load(memory_order_acquire)) return;
+
+		reports[head] =
+		{
+			.frameIndex = reportFrameIndex,
+			.metric = metric,
+			.milliseconds = milliseconds
+		};
+		reportHead.store(next, memory_order_release);
+	}
+}
+
+void AddValue(
+	FrameRecord& record,
+	FrameMetric metric,
+	f32 milliseconds)
+{
+	u32 index = static_cast<u32>(metric);
+
+	record.values[index] = milliseconds;
+	++histograms[index][GetBucket(milliseconds)];
+	++sampleCounts[index];
+}
+
+bool EvictRecord(FrameRecord& record)
+{
+	for (u32 i = 0; i < FRAME_METRIC_COUNT; ++i)
+	{
+		if (record.values[i] < 0.0f) continue;
+
+		--histograms[i][GetBucket(record.values[i])];
+		--sampleCounts[i];
+	}
+
+	if (FrameStats::IsCapturing()
+		&& record.frameIndex >= captureStart)
+	{
+		capturedFrames.push_back(record);
+	}
+
+	record.isValid = false;
+	return record.isHitch;
+}
+
+void DrainReports()
+{
+	u32 tail = reportTail.load(memory_order_relaxed);
+	u32 head = reportHead.load(memory_order_acquire);
+
+	while (tail != head)
+	{
+		const StageReport& report = reports[tail];
+
+		FrameRecord& record = frameWindow[report.frameIndex % FRAME_STATS_WINDOW];
+		u32 metric = static_cast<u32>(report.metric);
+		if (record.isValid
+			&& record.frameIndex == report.frameIndex
+			&& record.values[metric] < 0.0f)
+		{
+			AddValue(record, report.metric, report.milliseconds);
+		}
+
+		tail = (tail + 1) % REPORT_QUEUE_SIZE;
+	}
+
+	reportTail.store(tail, memory_order_release);
+}
+
+void WriteCapture()
+{
+	path filePath = current_path() / ("framestats_" + to_string(time(nullptr)) + ".csv");
+
+	ofstream file(filePath);
+	if (!file.is_open())
+	{
+		Logger::Print(
+			"Failed to open '" + filePath.string() + "' for writing frame stats!",
+			"FRAME_STATS",
+			LogType::LOG_ERROR,
+			2);
+
+		return;
+	}
+
+	file << "frame";
+	for (u32 i = 0; i < FRAME_METRIC_COUNT; ++i)
+	{
+		file << "," << GetFrameMetricName(static_cast<FrameMetric>(i)) << "_ms";
+	}
+	file << ",hitch\n";
+
+	char buffer[32]{};
+	for (const auto& record : capturedFrames)
+	{
+		file << record.frameIndex;
+		for (const auto& value : record.values)
+		{
+			file << ",";
+			if (value < 0.0f) continue;
+
+			snprintf(buffer, sizeof(buffer), "%.4f", value);
+			file << buffer;
+		}
+		file << "," << (record.isHitch ? 1 : 0) << "\n";
+	}
+
+	Logger::Print(
+		"Wrote " + to_string(capturedFrames.size()) + " frames to '" + filePath.string() + "'.",
+		"FRAME_STATS",
+		LogType::LOG_SUCCESS);
+
+	capturedFrames.clear();
+	capturedFrames.shrink_to_fit();
+}
+
+u32 GetBucket(f32 milliseconds)
+{
+	u32 bucket = static_cast<u32>(max(milliseconds, 0.0f) / BUCKET_WIDTH);
+	return min(bucket, BUCKET_COUNT - 1);
+}
\ No newline at end of file
@@ -7,7 +7,12 @@
 #include <chrono>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <sstream>
+#include <filesystem>
+#include <ctime>
+#include <algorithm>
+#include <cmath>
 
 //kalacrashhandler
 #include "crashHandler.hpp"
@@ -22,7 +27,22 @@
 
 #include "core/gamecore.hpp"
 #include "core/playerinput.hpp"
+#include "core/jobsystem.hpp"
+#include "core/idlemode.hpp"
+#include "core/framelimiter.hpp"
+#include "core/framestats.hpp"
+#include "core/profiler.hpp"
+#include "core/asynclog.hpp"
+#include "core/alloctracker.hpp"
+#include "core/framearena.hpp"
+#include "core/levelarena.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "gameobjects/transformsystem.hpp"
+#include "world/debrissystem.hpp"
+#include "world/watersystem.hpp"
+#include "world/supportsystem.hpp"
 #include "graphics/render.hpp"
+#include "graphics/renderthread.hpp"
 
 //kalacrashhandler
 using KalaKit::KalaCrashHandler;
@@ -42,7 +62,28 @@ using KalaWindow::Core::createdWindows;
 using KalaWindow::Core::runtimeWindows;
 
 using CircuitGame::Core::Game;
+using CircuitGame::Core::JobSystem;
+using CircuitGame::Core::IdleMode;
+using CircuitGame::Core::FrameLimiter;
+using CircuitGame::Core::FrameStats;
+using CircuitGame::Core::FrameMetric;
+using CircuitGame::Core::FrameMetricSummary;
+using CircuitGame::Core::Profiler;
+using CircuitGame::Core::AsyncLog;
+using CircuitGame::Core::AllocTracker;
+using CircuitGame::Core::AllocTag;
+using CircuitGame::Core::AllocStats;
+using CircuitGame::Core::FrameArena;
+using CircuitGame::Core::LevelArena;
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::TransformSystem;
+using CircuitGame::World::DebrisSystem;
+using CircuitGame::World::WaterSystem;
+using CircuitGame::World::SupportSystem;
+using CircuitGame::World::CollapsedBlock;
+using CircuitGame::GameObjects::RenderComponent;
 using CircuitGame::Graphics::Render;
+using CircuitGame::Graphics::RenderThread;
 using CircuitGame::Core::mainWindow;
 
 using std::thread;
@@ -55,9 +96,12 @@ using std::chrono::duration;
 using std::unique_ptr;
 using std::make_unique;
 using std::string;
+using std::string_view;
 using std::to_string;
 using std::stringstream;
 using std::clamp;
+using std::fmod;
+using std::filesystem::current_path;
 
 static string title = "Circuit Chan 0.0.3 Alpha";
 
@@ -69,8 +113,24 @@ static void DisplayTitleData();
 
 static void UpdateDeltaTime();
 
+static void ShutdownSystems();
+
+//frames recorded by one profiler capture
+static constexpr u32 PROFILER_CAPTURE_FRAMES = 120;
+static void WriteProfilerCapture();
+
+//memory reserved up front for the objects of one level
+static constexpr size_t LEVEL_ARENA_CAPACITY = 4 * 1024 * 1024;
+
+//frames skipped and then checked by one allocation guard run
+static constexpr u32 ALLOC_GUARD_WARMUP_FRAMES = 120;
+static constexpr u32 ALLOC_GUARD_FRAMES = 600;
+
 static vec2 lastSize{};
 
+//fixed steps run by one frame at most, a longer hitch drops the time it could not catch up on
+static constexpr u32 MAX_FIXED_STEPS = 5;
+
 static f64 accumulator = 0.0;
 
 namespace CircuitGame::Core
@@ -79,19 +139,56 @@ namespace CircuitGame::Core
 	// DEFINE INIT AND RUNTIME STAGE DATA
 	//
 
-	unordered_map<u32, unique_ptr<Cube>> createdCubes{};
 	unique_ptr<Camera> createdCamera{};
 	Window* mainWindow{};
-	vector<Cube*> runtimeCubes{};
 
-	void Game::Initialize()
+	void Game::Initialize(
+		int argc,
+		char* argv[])
 	{
 		KalaCrashHandler::SetShutdownCallback(Shutdown_Crash);
 		KalaCrashHandler::SetProgramName("Circuit Chan");
 
 		KalaCrashHandler::Initialize();
 
-		KalaWindowCore::SetUserShutdownFunction(Render::Shutdown);
+		KalaWindowCore::SetUserShutdownFunction(ShutdownSystems);
+
+		PROFILE_THREAD_NAME("Game");
+		ALLOC_THREAD_TAG(AllocTag::Tag_Game);
+
+		//loading only shows up in a capture that is already running when it starts,
+		//the capture then ends PROFILER_CAPTURE_FRAMES frames into the game
+		bool isProfilingStartup = false;
+		for (int i = 1; i < argc; i++)
+		{
+			if (string_view(argv[i]) == "--profile-startup") isProfilingStartup = true;
+		}
+#ifdef CIRCUIT_PROFILER_ENABLED
+		if (isProfilingStartup) Profiler::BeginCapture(PROFILER_CAPTURE_FRAMES);
+#endif
+
+		//first so everything after it can log from hot paths
+		AsyncLog::Initialize();
+
+#ifndef CIRCUIT_PROFILER_ENABLED
+		if (isProfilingStartup)
+		{
+			Logger::Print(
+				"Cannot profile startup because the profiler was compiled out, enable CIRCUIT_PROFILER!",
+				"CORE",
+				LogType::LOG_ERROR,
+				2);
+		}
+#endif
+
+		JobSystem::Initialize();
+		LevelArena::Initialize(LEVEL_ARENA_CAPACITY);
+		FrameLimiter::Initialize();
+
+		Logger::Print(
+			"Started job system with " + to_string(JobSystem::GetWorkerCount()) + " workers!",
+			"TEST_PROJECT",
+			LogType::LOG_SUCCESS);
 
 		f32 width = 800;
 		f32 height = 600;
@@ -115,7 +212,7 @@ namespace CircuitGame::Core
 			LogType::LOG_INFO);
 
 		if (!Render::Initialize()) return;
-		Renderer_OpenGL::SetVSyncState(GLVState::VSYNC_ON);
+		RenderThread::Enqueue([]() { Renderer_OpenGL::SetVSyncState(GLVState::VSYNC_ON); });
 
 		mainWindow->SetMinSize(vec2{ 800, 600 });
 		mainWindow->SetMaxSize(vec2{ 3840, 2160 });
@@ -126,7 +223,14 @@ namespace CircuitGame::Core
 			<< "1: set vsync on\n"
 			<< "2: set vsync off\n"
 			<< "3: set vsync to triple buffering (vulkan only)\n"
-			<< "4: toggle fps and resolution in title\n"
+			<< "4: toggle frame time percentiles and resolution in title\n"
+			<< "5: cycle frame limit (60, 144, 240, uncapped), only used while vsync is off\n"
+			<< "6: start or stop recording every frame to a frame stats csv\n"
+			<< "7: capture the next " << PROFILER_CAPTURE_FRAMES << " frames to a chrome trace json\n"
+			<< "8: check that the next " << ALLOC_GUARD_FRAMES << " frames do not allocate\n"
+			<< "F: toggle between flying and walking, the player starts flying\n"
+			<< "left mouse: knock out the block looked at, whatever it held up falls with it\n"
+			<< "right mouse: pour water onto the face looked at\n"
 			<< "====================";
 
 		Logger::Print(
@@ -144,32 +248,78 @@ namespace CircuitGame::Core
 	{
 		while (isRunning)
 		{
-			UpdateDeltaTime();
-
-			/*
-			* 
-			* //Physics should run on its own thread to not slow down the render thread!
-			* 
-			* i32 maxSteps = 5;
-			* i32 steps = 0;
-			* 
-			while (accumulator >= GetFixedDelta()
-				   && steps < maxSteps)
+			//sleep on window events instead of spinning while unfocused or minimized,
+			//anything else only runs at the idle rate until the window is active again
+			if (mainWindow->IsIdle()
+				&& !IdleMode::Wait(mainWindow))
 			{
-				//<<<< physics logic here
-				accumulator -= GetFixedDelta();
-				steps++;
+				mainWindow->Update();
+				continue;
 			}
-			*/
 
+			//counted before the frame zone opens so the last captured frame is complete
+			if (Profiler::EndFrame()) WriteProfilerCapture();
+
+			PROFILE_ZONE("Game::Frame");
+
+			FrameStats::BeginFrame();
+
+			UpdateDeltaTime();
+
+			ALLOC_THREAD_TAG(AllocTag::Tag_Window);
 			mainWindow->Update();
+			FrameStats::EndStage(FrameMetric::Metric_Events);
+
+			if (IdleMode::IsActive()
+				&& !mainWindow->IsIdle())
+			{
+				IdleMode::Exit();
+			}
 
 			//handle input AFTER processing windows message loop events
+			ALLOC_THREAD_TAG(AllocTag::Tag_Input);
 			PlayerInput::HandleInput();
 
+			//player movement, collapses, debris and water run at the fixed timestep so they
+			//behave the same at every frame rate
+			accumulator += GetDeltaTime();
+			u32 fixedSteps = 0;
+			while (accumulator >= GetFixedDelta()
+				&& fixedSteps < MAX_FIXED_STEPS)
+			{
+				PlayerInput::FixedUpdate(static_cast<f32>(GetFixedDelta()));
+
+				//blocks that lost their ground fall on as debris from where they stood
+				//and are no longer part of a circuit.
+				//One the broadphase has no room for is hidden right away, this frame's snapshot
+				//is taken before its destruction at the end of the frame
+				SupportSystem::Resolve();
+				for (const CollapsedBlock& block : SupportSystem::GetCollapsed())
+				{
+					WaterSystem::RemoveCircuit(block.entity);
+					EntityStore::GetCircuits().Remove(block.entity);
+
+					if (DebrisSystem::Add(block.entity) != nullptr) continue;
+
+					if (RenderComponent* render = EntityStore::GetRenders().Get(block.entity)) render->isVisible = false;
+					EntityStore::Destroy(block.entity);
+				}
+
+				DebrisSystem::Step(static_cast<f32>(GetFixedDelta()));
+				WaterSystem::Step();
+				accumulator -= GetFixedDelta();
+				fixedSteps++;
+			}
+			//a long frame drops the steps it could not run instead of carrying them into the next one,
+			//only the part of a step left over is kept for the blend
+			if (fixedSteps == MAX_FIXED_STEPS) accumulator = fmod(accumulator, GetFixedDelta());
+
+			PlayerInput::UpdateCamera(static_cast<f32>(accumulator / GetFixedDelta()));
+
 			if (Input::IsKeyPressed(Key::Num1))
 			{
-				Renderer_OpenGL::SetVSyncState(GLVState::VSYNC_ON);
+				RenderThread::Enqueue([]() { Renderer_OpenGL::SetVSyncState(GLVState::VSYNC_ON); });
+				FrameLimiter::SetEnabled(false);
 				
 				Logger::Print(
 					"Set 'vsync state' to 'ON'",
@@ -178,7 +328,8 @@ namespace CircuitGame::Core
 			}
 			if (Input::IsKeyPressed(Key::Num2))
 			{
-				Renderer_OpenGL::SetVSyncState(GLVState::VSYNC_OFF);
+				RenderThread::Enqueue([]() { Renderer_OpenGL::SetVSyncState(GLVState::VSYNC_OFF); });
+				FrameLimiter::SetEnabled(true);
 
 				Logger::Print(
 					"Set 'vsync state' to 'OFF'",
@@ -213,17 +364,64 @@ namespace CircuitGame::Core
 					"TEST_PROJECT",
 					LogType::LOG_DEBUG);
 			}
+			if (Input::IsKeyPressed(Key::Num5)) FrameLimiter::CycleTargetRate();
+			if (Input::IsKeyPressed(Key::Num6)) FrameStats::ToggleCapture();
+			if (Input::IsKeyPressed(Key::Num7))
+			{
+#ifdef CIRCUIT_PROFILER_ENABLED
+				Profiler::BeginCapture(PROFILER_CAPTURE_FRAMES);
+#else
+				Logger::Print(
+					"Cannot capture a profile because the profiler was compiled out, enable CIRCUIT_PROFILER!",
+					"CORE",
+					LogType::LOG_ERROR,
+					2);
+#endif
+			}
+
+			if (Input::IsKeyPressed(Key::Num8))
+			{
+				AllocTracker::StartGuard(
+					ALLOC_GUARD_WARMUP_FRAMES,
+					ALLOC_GUARD_FRAMES);
+			}
+
+			ALLOC_THREAD_TAG(AllocTag::Tag_Window);
 			DisplayTitleData();
+			FrameStats::EndStage(FrameMetric::Metric_Input);
 
+			//only publishes a snapshot, the render thread submits it
+			//while this thread moves on to the next frame
+			ALLOC_THREAD_TAG(AllocTag::Tag_Render);
+			TransformSystem::Update();
 			Render::Update();
+			FrameStats::EndStage(FrameMetric::Metric_Snapshot);
+
+			ALLOC_THREAD_TAG(AllocTag::Tag_Game);
 
 			Input::EndFrameUpdate(mainWindow);
+
+			//the swap paces the game thread, the limiter is an extra cap on top while vsync is off
+			RenderThread::WaitForPresent();
+			{
+				PROFILE_ZONE("FrameLimiter::Wait");
+				FrameLimiter::Wait();
+			}
+			FrameStats::EndStage(FrameMetric::Metric_Limiter);
+
+			//idle ticks would read as hitches
+			FrameStats::EndFrame(IdleMode::IsActive());
+			AllocTracker::EndFrame(IdleMode::IsActive());
+
+			//every job of this frame has been waited for
+			FrameArena::EndFrame();
+			EntityStore::EndFrame();
 		}
 	}
 
 	void Game::Shutdown_Crash()
 	{
-		Render::Shutdown();
+		ShutdownSystems();
 
 		KalaWindowCore::Shutdown(
 			ShutdownState::SHUTDOWN_CRITICAL,
@@ -231,6 +429,39 @@ namespace CircuitGame::Core
 	}
 }
 
+void ShutdownSystems()
+{
+	Render::Shutdown();
+	JobSystem::Shutdown();
+	FrameArena::Shutdown();
+	LevelArena::Shutdown();
+	FrameLimiter::Shutdown();
+
+	//last, destroyed gameobjects still log
+	AsyncLog::Shutdown();
+}
+
+void WriteProfilerCapture()
+{
+	string filePath = (current_path() / ("trace_" + to_string(time(nullptr)) + ".json")).string();
+
+	if (!Profiler::WriteCapture(filePath))
+	{
+		Logger::Print(
+			"Failed to write profiler capture to '" + filePath + "'!",
+			"CORE",
+			LogType::LOG_ERROR,
+			2);
+
+		return;
+	}
+
+	Logger::Print(
+		"Wrote profiler capture to '" + filePath + "', open it in chrome://tracing or ui.perfetto.dev.",
+		"CORE",
+		LogType::LOG_SUCCESS);
+}
+
 void UpdateDeltaTime()
 {
 	auto now = steady_clock::now();
@@ -253,67 +484,101 @@ void DisplayTitleData()
 {
 	if (!isDisplayingTitleData) return;
 
-	static auto startTime = steady_clock::now();
-	static auto lastLogTime = startTime;
+	static auto lastLogTime = steady_clock::now();
 
-	static f64 accumFrameTime = 0.0;
-	static unsigned int frameCount = 0;
-	static f64 fps = 0.0;
-	static f64 deltaTime = 0.0;
+	//reused every update so building the title does not allocate
+	static string fullTitle{};
+	static char titleBuffer[512]{};
 
 	auto now = steady_clock::now();
-	duration<f64> totalElapsed = now - startTime;
 	duration<f64> logElapsed = now - lastLogTime;
+	if (logElapsed.count() < 0.1) return;
 
-	accumFrameTime += Game::GetFrameTime();
-	++frameCount;
+	lastLogTime = now;
 
-	if (accumFrameTime > 0.0
-		&& frameCount > 0)
-	{
-		fps = static_cast<f64>(frameCount) / accumFrameTime;
-		deltaTime = (accumFrameTime * 1000.0) / static_cast<f64>(frameCount);
-	}
+	lastSize = mainWindow->GetSize();
 
-	if (logElapsed.count() >= 0.1)
-	{
-		//window size
+	FrameMetricSummary cpu = FrameStats::GetSummary(FrameMetric::Metric_CPUFrame);
+	FrameMetricSummary gpu = FrameStats::GetSummary(FrameMetric::Metric_GPUFrame);
 
-		vec2 winSize = mainWindow->GetSize();
-		if (lastSize.x != winSize.x
-			|| lastSize.y != winSize.y)
-		{
-			lastSize = winSize;
-		}
-		string resolution =
-			to_string(static_cast<int>(lastSize.x)) + "x" +
-			to_string(static_cast<int>(lastSize.y));
+	f64 fps = cpu.p50 > 0.0f ? 1000.0 / cpu.p50 : 0.0;
 
-		//fps
+	//snprintf returns what it would have written, so every append is clamped
+	//to the terminator or the next one would start past the end of the buffer
+	constexpr i32 maxLength = static_cast<i32>(sizeof(titleBuffer)) - 1;
 
-		char fpsBuffer[32];
-		snprintf(fpsBuffer, sizeof(fpsBuffer), "%.8f", fps);
-		char* fpsDot = strchr(fpsBuffer, '.');
-		if (fpsDot && *(fpsDot + 3)) *(fpsDot + 3) = '\0';
+	//resolution and cpu frame time percentiles
 
-		string fpsStr(fpsBuffer);
+	i32 length = snprintf(
+		titleBuffer,
+		sizeof(titleBuffer),
+		"%s [ %dx%d ] [ %.1f FPS | cpu p50 %.1f p95 %.1f p99 %.1f max %.1f ms",
+		title.c_str(),
+		static_cast<i32>(lastSize.x),
+		static_cast<i32>(lastSize.y),
+		fps,
+		cpu.p50,
+		cpu.p95,
+		cpu.p99,
+		cpu.max);
+	length = clamp(length, 0, maxLength);
 
-		//deltatime
+	//gpu frame time, only once the render thread reports it
 
-		char dtBuffer[32];
-		snprintf(dtBuffer, sizeof(dtBuffer), "%.8f", deltaTime);
-		char* dtDot = strchr(dtBuffer, '.');
-		if (dtDot && *(dtDot + 3)) *(dtDot + 3) = '\0';
+	if (gpu.sampleCount > 0)
+	{
+		length += snprintf(
+			titleBuffer + length,
+			sizeof(titleBuffer) - length,
+			" | gpu p50 %.1f p99 %.1f ms",
+			gpu.p50,
+			gpu.p99);
+		length = clamp(length, 0, maxLength);
+	}
+
+	length += snprintf(
+		titleBuffer + length,
+		sizeof(titleBuffer) - length,
+		" | %u hitches ]",
+		FrameStats::GetHitchCount());
+	length = clamp(length, 0, maxLength);
 
-		string dtStr(dtBuffer);
+	//frame limit
+
+	if (FrameLimiter::IsEnabled()
+		&& FrameLimiter::GetTargetRate() > 0.0)
+	{
+		length += snprintf(
+			titleBuffer + length,
+			sizeof(titleBuffer) - length,
+			" [ %.0f FPS cap, %.3fms jitter ]",
+			FrameLimiter::GetTargetRate(),
+			FrameLimiter::GetJitter());
+		length = clamp(length, 0, maxLength);
+	}
 
-		//display data
+	//heap allocations of the last frame, only while they are counted
 
-		string fullTitle = title + " [ " + resolution + " ] [ " + fpsStr + " FPS (" + dtStr + "ms) ]";
-		mainWindow->SetTitle(fullTitle);
+	if constexpr (AllocTracker::IsEnabled())
+	{
+		AllocStats allocations = AllocTracker::GetFrameTotal();
+		length += snprintf(
+			titleBuffer + length,
+			sizeof(titleBuffer) - length,
+			" [ %llu allocs, %.1f KB ]",
+			static_cast<unsigned long long>(allocations.count),
+			static_cast<f64>(allocations.bytes) / 1024.0);
+		length = clamp(length, 0, maxLength);
+	}
 
-		lastLogTime = now;
-		accumFrameTime = 0.0;
-		frameCount = 0;
+	if (FrameStats::IsCapturing())
+	{
+		snprintf(
+			titleBuffer + length,
+			sizeof(titleBuffer) - length,
+			" [ capturing ]");
 	}
+
+	fullTitle.assign(titleBuffer);
+	mainWindow->SetTitle(fullTitle);
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <chrono>
+#include <cstdio>
+#ifdef _WIN32
+#include <windows.h>
+#elif __linux__
+#include <time.h>
+#include <poll.h>
+#endif
+
+//kalawindow
+#include "core/log.hpp"
+
+#include "core/idlemode.hpp"
+
+//kalawindow
+using KalaWindow::Graphics::Window;
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Core::IdleMode;
+
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+
+#ifdef __linux__
+//declared here instead of including Xlib.h, its Window type clashes with the KalaWindow one
+extern "C" int XPending(void* display);
+extern "C" int XConnectionNumber(void* display);
+#endif
+
+static steady_clock::time_point idleStartTime{};
+static steady_clock::time_point nextIdleTick{};
+static f64 idleStartCPUTime{};
+
+static void WaitForWindowEvents(
+	Window* window,
+	u32 timeoutMS);
+static f64 GetProcessCPUTime();
+
+namespace CircuitGame::Core
+{
+	bool IdleMode::Wait(Window* window)
+	{
+		auto now = steady_clock::now();
+
+		if (!isActive)
+		{
+			isActive = true;
+			idleStartTime = now;
+			idleStartCPUTime = GetProcessCPUTime();
+			nextIdleTick = now;
+
+			Logger::Print(
+				"Window is idle, entering idle mode.",
+				"IDLE_MODE",
+				LogType::LOG_DEBUG);
+		}
+
+		if (now < nextIdleTick)
+		{
+			//round up so the wait never ends just short of the tick
+			auto remaining = duration_cast<milliseconds>(nextIdleTick - now) + milliseconds(1);
+			WaitForWindowEvents(window, static_cast<u32>(remaining.count()));
+
+			now = steady_clock::now();
+			if (now < nextIdleTick) return false;
+		}
+
+		nextIdleTick = now + duration_cast<steady_clock::duration>(duration<f64>(1.0 / idleRate));
+		return true;
+	}
+
+	void IdleMode::Exit()
+	{
+		if (!isActive) return;
+		isActive = false;
+
+		duration<f64> idleTime = steady_clock::now() - idleStartTime;
+		f64 cpuTime = GetProcessCPUTime() - idleStartCPUTime;
+
+		idleCPUUsage = idleTime.count() > 0.0
+			? cpuTime / idleTime.count() * 100.0
+			: 0.0;
+
+		char buffer[128]{};
+		snprintf(
+			buffer,
+			sizeof(buffer),
+			"Left idle mode after %.2fs, used %.2f%% of one core while idle.",
+			idleTime.count(),
+			idleCPUUsage);
+
+		Logger::Print(
+			buffer,
+			"IDLE_MODE",
+			LogType::LOG_INFO);
+	}
+}
+
+void WaitForWindowEvents(
+	Window* window,
+	u32 timeoutMS)
+{
+#ifdef _WIN32
+	//returns as soon as anything is in the message queue, including input that was already peeked
+	MsgWaitForMultipleObjectsEx(
+		0,
+		nullptr,
+		timeoutMS,
+		QS_ALLINPUT,
+		MWMO_INPUTAVAILABLE);
+#elif __linux__
+	void* display = reinterpret_cast<void*>(window->GetWindowData().display);
+
+	//events Xlib already read from the socket would not wake poll
+	if (XPending(display) > 0) return;
+
+	pollfd connection
+	{
+		.fd = XConnectionNumber(display),
+		.events = POLLIN,
+		.revents = 0
+	};
+	poll(&connection, 1, static_cast<int>(timeoutMS));
+#endif
+}
+
+f64 GetProcessCPUTime()
+{
+#ifdef _WIN32
+	FILETIME creationTime{};
+	FILETIME exitTime{};
+	FILETIME kernelTime{};
+	FILETIME userTime{};
+	if (!GetProcessTimes(
+		GetCurrentProcess(),
+		&creationTime,
+		&exitTime,
+		&kernelTime,
+		&userTime))
+	{
+		return 0.0;
+	}
+
+	//100 nanosecond units
+	u64 kernel = (static_cast<u64>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime;
+	u64 user = (static_cast<u64>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+
+	return static_cast<f64>(kernel + user) / 1e7;
+#elif __linux__
+	timespec time{};
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+
+	return static_cast<f64>(time.tv_sec) + static_cast<f64>(time.tv_nsec) / 1e9;
+#else
+	return 0.0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,414 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <string>
+
+#include "core/jobsystem.hpp"
+#include "core/alloctracker.hpp"
+
+using CircuitGame::Core::JobSystem;
+using CircuitGame::Core::JobDesc;
+using CircuitGame::Core::JobCounter;
+using CircuitGame::Core::JobFunction;
+using CircuitGame::Core::AllocTag;
+
+using std::thread;
+using std::mutex;
+using std::lock_guard;
+using std::vector;
+using std::deque;
+using std::unique_ptr;
+using std::make_unique;
+using std::atomic;
+using std::atomic_thread_fence;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::memory_order_seq_cst;
+using std::max;
+using std::min;
+using std::this_thread::yield;
+using std::to_string;
+
+//Job slots per submitting thread, also the deque capacity.
+//A thread that wraps around onto a slot still in flight runs jobs until it is free.
+static constexpr u32 JOB_CAPACITY = 4096;
+static constexpr u32 NOT_A_WORKER = 0xFFFFFFFF;
+
+//Failed lookups before an idle worker goes to sleep
+static constexpr u32 IDLE_SPIN_COUNT = 64;
+
+struct Job
+{
+	JobDesc desc{};
+	JobCounter* counter{};
+	atomic<bool> isInFlight{}; //Set when submitted, cleared once the job has run
+};
+
+//Chase-Lev deque, the owner pushes and pops at the bottom, thieves take from the top
+class WorkDeque
+{
+public:
+	bool Push(Job* job)
+	{
+		i64 b = bottom.load(memory_order_relaxed);
+		i64 t = top.load(memory_order_acquire);
+		if (b - t >= static_cast<i64>(JOB_CAPACITY)) return false;
+
+		slots[b & (JOB_CAPACITY - 1)].store(job, memory_order_relaxed);
+		bottom.store(b + 1, memory_order_release);
+
+		return true;
+	}
+
+	Job* Pop()
+	{
+		i64 b = bottom.load(memory_order_relaxed) - 1;
+		bottom.store(b, memory_order_relaxed);
+		atomic_thread_fence(memory_order_seq_cst);
+		i64 t = top.load(memory_order_relaxed);
+
+		if (t > b)
+		{
+			bottom.store(b + 1, memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* job = slots[b & (JOB_CAPACITY - 1)].load(memory_order_relaxed);
+		if (t == b)
+		{
+			//last item, race the thieves for it
+			if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+			{
+				job = nullptr;
+			}
+			bottom.store(b + 1, memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	Job* Steal()
+	{
+		i64 t = top.load(memory_order_acquire);
+		atomic_thread_fence(memory_order_seq_cst);
+		i64 b = bottom.load(memory_order_acquire);
+
+		if (t >= b) return nullptr;
+
+		Job* job = slots[t & (JOB_CAPACITY - 1)].load(memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed))
+		{
+			return nullptr;
+		}
+
+		return job;
+	}
+private:
+	alignas(64) atomic<i64> top{};
+	alignas(64) atomic<i64> bottom{};
+	alignas(64) atomic<Job*> slots[JOB_CAPACITY]{};
+};
+
+struct Worker
+{
+	WorkDeque deque{};
+	thread handle{};
+};
+
+static vector<unique_ptr<Worker>> workers{};
+
+//jobs from threads that are not workers and jobs whose dependency was not done yet
+static mutex injectedMutex{};
+static deque<Job*> injectedJobs{};
+static atomic<u32> injectedCount{};
+
+static atomic<u32> wakeSignal{};
+static atomic<bool> stopRequested{};
+
+static thread_local u32 currentWorker = NOT_A_WORKER;
+static thread_local u32 stealSeed = 0x9E3779B9;
+
+//ring of job storage per submitting thread, a slot is reused JOB_CAPACITY submits later
+//once the job that had it has run
+static thread_local unique_ptr<Job[]> jobPool{};
+static thread_local u32 jobPoolNext{};
+
+static Job* AllocateJob();
+static void PushJob(Job* job);
+static void InjectJob(Job* job);
+static Job* FindJob();
+static bool RunOneJob();
+static void Execute(Job* job);
+static void WakeWorkers(u32 count);
+static void WorkerLoop(u32 index);
+
+namespace CircuitGame::Core
+{
+	bool JobSystem::Initialize(u32 newWorkerCount)
+	{
+		if (isInitialized) return false;
+
+		if (newWorkerCount == 0) newWorkerCount = max(thread::hardware_concurrency(), 1u);
+		workerCount = newWorkerCount;
+
+		stopRequested.store(false);
+
+		workers.clear();
+		for (u32 i = 0; i < workerCount; ++i)
+		{
+			workers.push_back(make_unique<Worker>());
+		}
+
+		currentWorker = 0;
+		for (u32 i = 1; i < workerCount; ++i)
+		{
+			workers[i]->handle = thread(WorkerLoop, i);
+		}
+
+		isInitialized = true;
+
+		return true;
+	}
+
+	void JobSystem::Submit(
+		const JobDesc& job,
+		JobCounter* counter)
+	{
+		if (counter != nullptr) counter->pending.fetch_add(1);
+
+		if (!isInitialized)
+		{
+			//nothing to hand it to, run it here
+			job.function(job.data, job.begin, job.end);
+			if (counter != nullptr) counter->pending.fetch_sub(1);
+			return;
+		}
+
+		Job* storedJob = AllocateJob();
+		storedJob->desc = job;
+		storedJob->counter = counter;
+
+		PushJob(storedJob);
+		WakeWorkers(1);
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!RunOneJob()) yield();
+		}
+	}
+
+	void JobSystem::ParallelFor(
+		u32 count,
+		u32 grainSize,
+		JobFunction function,
+		void* data,
+		const char* name)
+	{
+		if (count == 0) return;
+
+		grainSize = max(grainSize, 1u);
+		if (!isInitialized
+			|| workerCount == 1
+			|| count <= grainSize)
+		{
+			PROFILE_ZONE(name);
+			function(data, 0, count);
+			return;
+		}
+
+		JobCounter counter{};
+		u32 jobCount = (count + grainSize - 1) / grainSize;
+		counter.pending.fetch_add(jobCount);
+
+		for (u32 begin = 0; begin < count; begin += grainSize)
+		{
+			Job* job = AllocateJob();
+			job->desc =
+			{
+				.function = function,
+				.data = data,
+				.begin = begin,
+				.end = min(begin + grainSize, count),
+				.name = name
+			};
+			job->counter = &counter;
+
+			PushJob(job);
+		}
+		WakeWorkers(jobCount);
+
+		Wait(counter);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!isInitialized) return;
+
+		//drain what is left so no counter is waited on forever
+		while (RunOneJob()) {}
+
+		stopRequested.store(true);
+		WakeWorkers(workerCount);
+
+		for (u32 i = 1; i < workerCount; ++i)
+		{
+			if (workers[i]->handle.joinable()) workers[i]->handle.join();
+		}
+		workers.clear();
+
+		currentWorker = NOT_A_WORKER;
+		workerCount = 0;
+		isInitialized = false;
+	}
+}
+
+Job* AllocateJob()
+{
+	if (jobPool == nullptr) jobPool = make_unique<Job[]>(JOB_CAPACITY);
+
+	Job* job = &jobPool[jobPoolNext & (JOB_CAPACITY - 1)];
+	++jobPoolNext;
+
+	//more jobs in flight than slots, help until the oldest one is done
+	while (job->isInFlight.load(memory_order_acquire))
+	{
+		if (!RunOneJob()) yield();
+	}
+
+	job->isInFlight.store(true, memory_order_relaxed);
+
+	return job;
+}
+
+void PushJob(Job* job)
+{
+	if (currentWorker == NOT_A_WORKER
+		|| !workers[currentWorker]->deque.Push(job))
+	{
+		InjectJob(job);
+	}
+}
+
+void InjectJob(Job* job)
+{
+	lock_guard<mutex> lock(injectedMutex);
+	injectedJobs.push_back(job);
+	injectedCount.fetch_add(1);
+}
+
+Job* FindJob()
+{
+	//own deque first, newest job is the one most likely still in cache
+	if (currentWorker != NOT_A_WORKER)
+	{
+		if (Job* job = workers[currentWorker]->deque.Pop()) return job;
+	}
+
+	if (injectedCount.load(memory_order_relaxed) > 0)
+	{
+		lock_guard<mutex> lock(injectedMutex);
+		if (!injectedJobs.empty())
+		{
+			Job* job = injectedJobs.front();
+			injectedJobs.pop_front();
+			injectedCount.fetch_sub(1);
+			return job;
+		}
+	}
+
+	//steal starting from a random victim so thieves spread out
+	u32 count = static_cast<u32>(workers.size());
+	stealSeed ^= stealSeed << 13;
+	stealSeed ^= stealSeed >> 17;
+	stealSeed ^= stealSeed << 5;
+
+	for (u32 i = 0; i < count; ++i)
+	{
+		u32 victim = (stealSeed + i) % count;
+		if (victim == currentWorker) continue;
+
+		if (Job* job = workers[victim]->deque.Steal()) return job;
+	}
+
+	return nullptr;
+}
+
+bool RunOneJob()
+{
+	Job* job = FindJob();
+	if (job == nullptr) return false;
+
+	Execute(job);
+	return true;
+}
+
+void Execute(Job* job)
+{
+	if (job->desc.dependency != nullptr
+		&& !job->desc.dependency->IsDone())
+	{
+		//back of the shared queue so the dependency gets a chance to run first
+		InjectJob(job);
+		return;
+	}
+
+	PROFILE_ZONE(job->desc.name);
+	job->desc.function(job->desc.data, job->desc.begin, job->desc.end);
+
+	if (job->counter != nullptr) job->counter->pending.fetch_sub(1);
+
+	//the submitting thread may reuse the slot from here on
+	job->isInFlight.store(false, memory_order_release);
+}
+
+void WakeWorkers(u32 count)
+{
+	wakeSignal.fetch_add(1);
+	if (count > 1) wakeSignal.notify_all();
+	else wakeSignal.notify_one();
+}
+
+void WorkerLoop(u32 index)
+{
+	currentWorker = index;
+	stealSeed ^= index * 0x85EBCA6B;
+
+	PROFILE_THREAD_NAME(("Worker " + to_string(index)).c_str());
+	ALLOC_THREAD_TAG(AllocTag::Tag_Jobs);
+
+	u32 idleCount = 0;
+	while (true)
+	{
+		//read before looking for work so a submit in between is never missed
+		u32 signal = wakeSignal.load();
+
+		if (RunOneJob())
+		{
+			idleCount = 0;
+			continue;
+		}
+
+		if (stopRequested.load()) break;
+
+		if (++idleCount < IDLE_SPIN_COUNT)
+		{
+			yield();
+			continue;
+		}
+
+		idleCount = 0;
+		wakeSignal.wait(signal);
+	}
+}
\ No newline at end of file
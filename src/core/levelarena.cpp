@@ -0,0 +1,159 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <new>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include "core/levelarena.hpp"
+
+using CircuitGame::Core::LevelArena;
+
+using std::vector;
+using std::size_t;
+using std::uintptr_t;
+using std::string_view;
+using std::align_val_t;
+using std::nothrow;
+using std::max;
+using std::memcpy;
+
+static constexpr size_t LEVEL_ARENA_BLOCK_ALIGNMENT = 64;
+
+//Smallest block added when a level outgrows the arena
+static constexpr size_t LEVEL_ARENA_MIN_BLOCK_SIZE = 64 * 1024;
+
+struct LevelBlock
+{
+	u8* memory{};
+	size_t size{};
+};
+
+static vector<LevelBlock> blocks{};
+static u32 blockIndex{};
+static size_t blockOffset{};
+
+static size_t usedBytes{};
+static size_t capacity{};
+
+static bool AddBlock(size_t minimumSize);
+static void FreeBlocks();
+
+namespace CircuitGame::Core
+{
+	bool LevelArena::Initialize(size_t newCapacity)
+	{
+		if (!blocks.empty()) return true;
+
+		return AddBlock(newCapacity);
+	}
+
+	void* LevelArena::Allocate(
+		size_t size,
+		size_t alignment)
+	{
+		while (true)
+		{
+			if (blockIndex < blocks.size())
+			{
+				LevelBlock& block = blocks[blockIndex];
+
+				uintptr_t base = reinterpret_cast<uintptr_t>(block.memory);
+				uintptr_t aligned = (base + blockOffset + alignment - 1) & ~(alignment - 1);
+				size_t start = static_cast<size_t>(aligned - base);
+				if (start + size <= block.size)
+				{
+					blockOffset = start + size;
+					usedBytes += size;
+
+					return block.memory + start;
+				}
+
+				if (blockIndex + 1 < blocks.size())
+				{
+					++blockIndex;
+					blockOffset = 0;
+					continue;
+				}
+			}
+
+			//a level bigger than the arena, the next reset merges the blocks
+			if (!AddBlock(max({ size + alignment, capacity, LEVEL_ARENA_MIN_BLOCK_SIZE }))) return nullptr;
+		}
+	}
+
+	const char* LevelArena::CopyString(string_view text)
+	{
+		char* copy = static_cast<char*>(Allocate(text.size() + 1, alignof(char)));
+		if (copy == nullptr) return nullptr;
+
+		memcpy(copy, text.data(), text.size());
+		copy[text.size()] = '\0';
+
+		return copy;
+	}
+
+	void LevelArena::Reset()
+	{
+		//one block of the whole size, so the next level of the same size fits without growing
+		if (blocks.size() > 1)
+		{
+			size_t total = capacity;
+			FreeBlocks();
+
+			//keeps working with nothing reserved, the next allocation adds a block
+			AddBlock(total);
+		}
+
+		blockIndex = 0;
+		blockOffset = 0;
+		usedBytes = 0;
+	}
+
+	size_t LevelArena::GetUsedBytes()
+	{
+		return usedBytes;
+	}
+
+	size_t LevelArena::GetCapacity()
+	{
+		return capacity;
+	}
+
+	void LevelArena::Shutdown()
+	{
+		FreeBlocks();
+	}
+}
+
+bool AddBlock(size_t minimumSize)
+{
+	void* memory = ::operator new(minimumSize, align_val_t{ LEVEL_ARENA_BLOCK_ALIGNMENT }, nothrow);
+	if (memory == nullptr) return false;
+
+	blocks.push_back({ static_cast<u8*>(memory), minimumSize });
+	blockIndex = static_cast<u32>(blocks.size() - 1);
+	blockOffset = 0;
+
+	capacity += minimumSize;
+
+	return true;
+}
+
+void FreeBlocks()
+{
+	for (const auto& block : blocks)
+	{
+		::operator delete(block.memory, align_val_t{ LEVEL_ARENA_BLOCK_ALIGNMENT });
+	}
+
+	blocks.clear();
+	blockIndex = 0;
+	blockOffset = 0;
+	usedBytes = 0;
+	capacity = 0;
+}
\ No newline at end of file
@@ -12,6 +12,12 @@
 #include "core/playerinput.hpp"
 #include "graphics/camera.hpp"
 #include "core/gamecore.hpp"
+#include "core/profiler.hpp"
+#include "core/loglevel.hpp"
+#include "world/chunkstore.hpp"
+#include "world/charactercontroller.hpp"
+#include "world/watersystem.hpp"
+#include "world/supportsystem.hpp"
 
 using KalaWindow::Core::Input;
 using KalaWindow::Core::Key;
@@ -21,10 +27,20 @@ using KalaWindow::Core::Logger;
 using CircuitGame::Core::Game;
 using CircuitGame::Graphics::Camera;
 using CircuitGame::Core::createdCamera;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::RaycastHit;
+using CircuitGame::World::CharacterController;
+using CircuitGame::World::CharacterBody;
+using CircuitGame::World::WaterSystem;
+using CircuitGame::World::SupportSystem;
+using CircuitGame::World::IsBlockCell;
+using CircuitGame::World::GetCellBlockType;
+using CircuitGame::GameObjects::GetBlockTypeName;
 
 using std::to_string;
 using std::string;
 using glm::radians;
+using glm::ivec3;
 
 enum class Action
 {
@@ -38,14 +54,43 @@ enum class Direction
 	DIR_Z
 };
 
+//how far away blocks can be picked and placed, in meters
+static constexpr f32 INTERACT_DISTANCE = 6.0f;
+
+static RaycastHit target{};
+static bool hasTarget{};
+
+//holding the right button leaks water onto the face looked at, to test flooding puzzles
+static constexpr u8 POUR_PER_STEP = 64;
+static ivec3 pourCell{};
+static bool isPouring{};
+
+static constexpr f32 WALK_SPEED = 4.0f;
+
+//camera height above the feet
+static constexpr f32 EYE_HEIGHT = 1.6f;
+
+//the test level has no floor cells yet, so the player starts flying, F toggles walking.
+//Flying still collides with every filled cell, it only turns off gravity and stepping up ledges
+static CharacterBody player{ .isFlying = true };
+static vec3 previousPlayerPos{};
+static bool isPlayerPlaced{};
+
+//what the keys asked for this frame, used by every fixed step until the next frame
+static vec3 moveVelocity{};
+static bool wantsJump{};
+
 namespace CircuitGame::Core
 {
 	void PlayerInput::HandleInput()
 	{
+		PROFILE_ZONE("PlayerInput::HandleInput");
+
 		if (mainWindow == nullptr
 			|| !mainWindow->IsFocused()
 			|| createdCamera == nullptr)
 		{
+			moveVelocity = vec3(0);
 			return;
 		}
 
@@ -63,6 +108,9 @@ namespace CircuitGame::Core
 
 		if (!createdCamera->CanMove())
 		{
+			hasTarget = false;
+			moveVelocity = vec3(0);
+
 			if (Input::GetKeepMouseDeltaState())
 			{
 				Input::SetMouseLockState(false);
@@ -86,20 +134,119 @@ namespace CircuitGame::Core
 		const vec3& right = createdCamera->GetRight();
 		const vec3& up = createdCamera->GetUp();
 
-		float velocity = createdCamera->GetSpeed() * static_cast<f32>(Game::GetDeltaTime());
-		vec3 pos = createdCamera->GetPos();
+		if (Input::IsKeyPressed(Key::F))
+		{
+			player.isFlying = !player.isFlying;
+			player.velocity = vec3(0);
 
-		if (Input::IsKeyDown(Key::W)) pos += front * velocity;
-		if (Input::IsKeyDown(Key::S)) pos -= front * velocity;
-		if (Input::IsKeyDown(Key::A)) pos -= right * velocity;
-		if (Input::IsKeyDown(Key::D)) pos += right * velocity;
+			string state = player.isFlying ? "true" : "false";
+			Logger::Print("Set player fly state to '" + state + "'!");
+		}
+
+		//walking ignores where the camera pitches, flying goes where it looks,
+		//right is always level and pitch is clamped short of straight up or down
+		vec3 forward = front;
+		f32 speed = createdCamera->GetSpeed();
+		if (!player.isFlying)
+		{
+			forward = glm::normalize(vec3(front.x, 0.0f, front.z));
+			speed = WALK_SPEED;
+		}
+
+		vec3 direction{};
+		if (Input::IsKeyDown(Key::W)) direction += forward;
+		if (Input::IsKeyDown(Key::S)) direction -= forward;
+		if (Input::IsKeyDown(Key::A)) direction -= right;
+		if (Input::IsKeyDown(Key::D)) direction += right;
 
 		//TODO: INVESTIGATE WHY LEFT MOUSE BUTTON ALSO MOVES CAMERA UP
 
 		//Q/E always goes up and down relative to world Y
-		if (Input::IsKeyDown(Key::Q)) pos -= up * velocity;
-		if (Input::IsKeyDown(Key::E)) pos += up * velocity;
+		if (player.isFlying)
+		{
+			if (Input::IsKeyDown(Key::Q)) direction -= up;
+			if (Input::IsKeyDown(Key::E)) direction += up;
+		}
+
+		//two keys at once must not move faster than one
+		if (glm::dot(direction, direction) > 0.0f) direction = glm::normalize(direction);
+
+		moveVelocity = direction * speed;
+
+		//kept until a fixed step consumes it, a frame may run none
+		if (Input::IsKeyPressed(Key::Space)) wantsJump = true;
+
+		//a grid walk on the CPU, so placement previews never wait on a GPU readback
+		hasTarget = ChunkStore::Raycast(
+			createdCamera->GetPos(),
+			front,
+			INTERACT_DISTANCE,
+			target);
+
+		if (hasTarget
+			&& Input::IsMousePressed(MouseButton::Left))
+		{
+			string blockName = IsBlockCell(target.cellValue)
+				? GetBlockTypeName(GetCellBlockType(target.cellValue))
+				: "solid";
+
+			LOGF_DEBUG("INPUT", "Picked %s cell (%d, %d, %d) at %.2fm, face (%d, %d, %d).",
+				blockName.c_str(),
+				target.cell.x, target.cell.y, target.cell.z,
+				target.distance,
+				target.normal.x, target.normal.y, target.normal.z);
+
+			//the whole block goes on the next fixed step and falls as debris,
+			//facility cells stay so the player cannot dig through floors
+			if (IsBlockCell(target.cellValue)) SupportSystem::ClearCell(target.cell);
+		}
+
+		isPouring = hasTarget && Input::IsMouseDown(MouseButton::Right);
+		if (isPouring) pourCell = target.cell + target.normal;
+	}
+
+	void PlayerInput::FixedUpdate(f32 fixedDelta)
+	{
+		if (createdCamera == nullptr) return;
+
+		PROFILE_ZONE("PlayerInput::FixedUpdate");
+
+		if (!isPlayerPlaced)
+		{
+			player.pos = createdCamera->GetPos() - vec3(0.0f, EYE_HEIGHT, 0.0f);
+			isPlayerPlaced = true;
+		}
+
+		previousPlayerPos = player.pos;
+
+		CharacterController::Step(
+			player,
+			moveVelocity,
+			wantsJump,
+			fixedDelta);
+
+		wantsJump = false;
+
+		if (isPouring) WaterSystem::AddWater(pourCell, POUR_PER_STEP);
+	}
+
+	void PlayerInput::UpdateCamera(f32 blend)
+	{
+		if (createdCamera == nullptr
+			|| !isPlayerPlaced)
+		{
+			return;
+		}
+
+		vec3 feet = glm::mix(previousPlayerPos, player.pos, glm::clamp(blend, 0.0f, 1.0f));
+		createdCamera->SetPos(feet + vec3(0.0f, EYE_HEIGHT, 0.0f));
+	}
+
+	bool PlayerInput::GetTarget(RaycastHit& outHit)
+	{
+		if (!hasTarget) return false;
 
-		createdCamera->SetPos(pos);
+		outHit = target;
+		return true;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,274 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+
+#include "core/profiler.hpp"
+
+using CircuitGame::Core::Profiler;
+using CircuitGame::Core::ReadProfilerTimestamp;
+
+using std::mutex;
+using std::lock_guard;
+using std::vector;
+using std::unique_ptr;
+using std::make_unique;
+using std::string;
+using std::to_string;
+using std::move;
+using std::ofstream;
+using std::atomic;
+using std::min;
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::memory_order_seq_cst;
+using std::atomic_thread_fence;
+using std::this_thread::yield;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+//Zones one thread keeps, older ones are overwritten once a thread records more in one capture
+static constexpr u32 ZONE_CAPACITY = 1 << 15;
+
+struct ZoneEvent
+{
+	const char* name{};
+	u64 begin{};
+	u64 end{};
+};
+
+struct ThreadBuffer
+{
+	unique_ptr<ZoneEvent[]> events{};
+	atomic<u32> head{};
+	atomic<bool> isWriting{}; //Raised around every append, WriteCapture waits for it to drop
+	u32 threadID{};
+	string name{};
+};
+
+static mutex registryMutex{};
+static vector<unique_ptr<ThreadBuffer>> threadBuffers{};
+static thread_local ThreadBuffer* threadBuffer{};
+
+static u32 framesLeft{};
+
+//timestamps and clock at both ends of the capture, used to convert timestamps to microseconds
+static u64 captureStartTimestamp{};
+static u64 captureEndTimestamp{};
+static steady_clock::time_point captureStartTime{};
+static steady_clock::time_point captureEndTime{};
+
+static ThreadBuffer* RegisterThread();
+static ThreadBuffer* CreateBuffer(const string& name);
+static void AppendEvent(
+	ThreadBuffer* buffer,
+	const char* name,
+	u64 begin,
+	u64 end);
+
+namespace CircuitGame::Core
+{
+	void Profiler::BeginCapture(u32 frameCount)
+	{
+		if (IsCapturing()) return;
+
+		framesLeft = frameCount;
+		captureStartTime = steady_clock::now();
+		captureStartTimestamp = ReadProfilerTimestamp();
+
+		isCapturing.store(true);
+	}
+
+	bool Profiler::EndFrame()
+	{
+		if (!IsCapturing()) return false;
+
+		if (framesLeft > 1)
+		{
+			--framesLeft;
+			return false;
+		}
+
+		isCapturing.store(false);
+		framesLeft = 0;
+
+		captureEndTimestamp = ReadProfilerTimestamp();
+		captureEndTime = steady_clock::now();
+
+		return true;
+	}
+
+	bool Profiler::WriteCapture(const string& filePath)
+	{
+		ofstream file(filePath);
+		if (!file.is_open()) return false;
+
+		duration<f64, std::micro> captureTime = captureEndTime - captureStartTime;
+		f64 ticks = static_cast<f64>(captureEndTimestamp - captureStartTimestamp);
+		f64 microsecondsPerTick = ticks > 0.0 ? captureTime.count() / ticks : 0.0;
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		char buffer[256]{};
+		bool isFirst = true;
+
+		//pairs with the fence in AppendEvent, a writer either finishes before the wait below
+		//or sees that the capture has ended and leaves the ring alone
+		atomic_thread_fence(memory_order_seq_cst);
+
+		lock_guard<mutex> lock(registryMutex);
+		for (const auto& thread : threadBuffers)
+		{
+			while (thread->isWriting.load(memory_order_acquire)) yield();
+
+			snprintf(
+				buffer,
+				sizeof(buffer),
+				"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+				isFirst ? "" : ",\n",
+				thread->threadID,
+				thread->name.c_str());
+			file << buffer;
+			isFirst = false;
+
+			u32 head = thread->head.load(memory_order_acquire);
+			u32 count = min(head, ZONE_CAPACITY);
+
+			for (u32 i = head - count; i != head; ++i)
+			{
+				const ZoneEvent& zone = thread->events[i & (ZONE_CAPACITY - 1)];
+
+				//left over from an earlier capture
+				if (zone.begin < captureStartTimestamp
+					|| zone.end > captureEndTimestamp)
+				{
+					continue;
+				}
+
+				snprintf(
+					buffer,
+					sizeof(buffer),
+					",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+					zone.name,
+					thread->threadID,
+					static_cast<f64>(zone.begin - captureStartTimestamp) * microsecondsPerTick,
+					static_cast<f64>(zone.end - zone.begin) * microsecondsPerTick);
+				file << buffer;
+			}
+		}
+
+		file << "\n]}\n";
+
+		return file.good();
+	}
+
+	void Profiler::SetThreadName(const char* name)
+	{
+		ThreadBuffer* buffer = threadBuffer != nullptr
+			? threadBuffer
+			: RegisterThread();
+
+		lock_guard<mutex> lock(registryMutex);
+		buffer->name = name;
+	}
+
+	void Profiler::Record(
+		const char* name,
+		u64 begin,
+		u64 end)
+	{
+		ThreadBuffer* buffer = threadBuffer;
+		if (buffer == nullptr) buffer = RegisterThread();
+
+		AppendEvent(buffer, name, begin, end);
+	}
+
+	u32 Profiler::CreateTrack(const char* name)
+	{
+		return CreateBuffer(name)->threadID;
+	}
+
+	void Profiler::RecordOnTrack(
+		u32 track,
+		const char* name,
+		u64 begin,
+		u64 end)
+	{
+		ThreadBuffer* buffer{};
+		{
+			lock_guard<mutex> lock(registryMutex);
+			if (track >= threadBuffers.size()) return;
+			buffer = threadBuffers[track].get();
+		}
+
+		AppendEvent(buffer, name, begin, end);
+	}
+
+	u64 Profiler::NanosecondsToTicks(u64 nanoseconds)
+	{
+		//the capture start is written before the capture flag
+		if (!isCapturing.load(memory_order_acquire)) return 0;
+
+		//measured over the capture so far, the same way WriteCapture converts back
+		duration<f64, std::nano> elapsedTime = steady_clock::now() - captureStartTime;
+		f64 elapsedTicks = static_cast<f64>(ReadProfilerTimestamp() - captureStartTimestamp);
+		if (elapsedTime.count() <= 0.0) return 0;
+
+		return static_cast<u64>(static_cast<f64>(nanoseconds) * elapsedTicks / elapsedTime.count());
+	}
+}
+
+ThreadBuffer* RegisterThread()
+{
+	threadBuffer = CreateBuffer("");
+	return threadBuffer;
+}
+
+ThreadBuffer* CreateBuffer(const string& name)
+{
+	auto buffer = make_unique<ThreadBuffer>();
+	buffer->events = make_unique<ZoneEvent[]>(ZONE_CAPACITY);
+
+	lock_guard<mutex> lock(registryMutex);
+
+	buffer->threadID = static_cast<u32>(threadBuffers.size());
+	buffer->name = name.empty()
+		? "Thread " + to_string(buffer->threadID)
+		: name;
+
+	ThreadBuffer* created = buffer.get();
+	threadBuffers.push_back(move(buffer));
+
+	return created;
+}
+
+void AppendEvent(
+	ThreadBuffer* buffer,
+	const char* name,
+	u64 begin,
+	u64 end)
+{
+	buffer->isWriting.store(true, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+
+	//a zone still open when the capture ended would land in a ring that is being written out
+	if (Profiler::IsCapturing())
+	{
+		u32 head = buffer->head.load(memory_order_relaxed);
+		buffer->events[head & (ZONE_CAPACITY - 1)] = { name, begin, end };
+		buffer->head.store(head + 1, memory_order_release);
+	}
+
+	buffer->isWriting.store(false, memory_order_release);
+}
\ No newline at end of file
@@ -3,242 +3,99 @@
 //This is free software, and you are welcome to redistribute it under certain conditions.
 //Read LICENSE.md for more information.
 
-#include <filesystem>
 #include <string>
-#include <fstream>
-#include <memory>
-#include <vector>
-
-#include "glm/gtc/matrix_transform.hpp"
-#include "glm/gtc/quaternion.hpp"
 
 //kalawindow
-#include "graphics/window.hpp"
 #include "core/log.hpp"
-#include "graphics/opengl/shader_opengl.hpp"
-#include "graphics/opengl/opengl_core.hpp"
-#include "graphics/texture.hpp"
-#include "core/containers.hpp"
 
 #include "gameobjects/cube.hpp"
-#include "core/gamecore.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "gameobjects/transformsystem.hpp"
+#include "core/loglevel.hpp"
+#include "core/levelarena.hpp"
+#include "world/chunkstore.hpp"
+#include "world/supportsystem.hpp"
+#include "world/watersystem.hpp"
 
-using KalaWindow::Graphics::Window;
-using KalaWindow::Core::Logger;
 using KalaWindow::Core::LogType;
-using KalaWindow::Graphics::OpenGL::Shader_OpenGL;
-using KalaWindow::Graphics::Texture;
-using KalaWindow::Core::globalID;
 
-using CircuitGame::Core::createdCubes;
-using CircuitGame::Core::runtimeCubes;
 using CircuitGame::GameObjects::Cube;
+using CircuitGame::GameObjects::Entity;
+using CircuitGame::GameObjects::INVALID_ENTITY;
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::NameComponent;
+using CircuitGame::GameObjects::TransformSystem;
+using CircuitGame::GameObjects::RenderComponent;
+using CircuitGame::GameObjects::CircuitComponent;
+using CircuitGame::GameObjects::MAX_POWER_LEVEL;
+using CircuitGame::Core::LevelArena;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::MakeBlockCell;
+using CircuitGame::World::SupportSystem;
+using CircuitGame::World::WaterSystem;
 
-using std::filesystem::path;
-using std::filesystem::current_path;
-using std::filesystem::exists;
 using std::string;
-using std::to_string;
-using std::ofstream;
-using std::unique_ptr;
-using std::make_unique;
-using std::vector;
-using glm::translate;
-using glm::radians;
-using glm::quat;
-using glm::mat4_cast;
-using glm::scale;
-
-static void CreateCube(Cube* cube);
+using glm::ivec3;
 
 namespace CircuitGame::GameObjects
 {
-	Cube* Cube::Initialize(
+	Entity Cube::Initialize(
 		const string& name,
 		const vec3& pos,
 		const vec3& rot,
-		const vec3& scale)
+		const vec3& scale,
+		BlockType blockType,
+		bool isAnchored)
 	{
-		Logger::Print(
-			"Creating gameobject '" + name + "'.",
-			"GAMEOBJECT",
-			LogType::LOG_DEBUG);
-
-		u32 newID = globalID++;
-		unique_ptr<Cube> newCube = make_unique<Cube>();
-		Cube* cubePtr = newCube.get();
-
-		CreateCube(cubePtr);
-
-		newCube->SetName(name);
-		newCube->SetID(newID);
-		newCube->SetPos(pos);
-		newCube->SetRot(rot);
-		newCube->SetScale(scale);
-		newCube->SetUpdate(true);
-
-		createdCubes[newID] = move(newCube);
-		runtimeCubes.push_back(cubePtr);
-
-		Logger::Print(
-			"Created gameobject '" + name + "'!",
-			"GAMEOBJECT",
-			LogType::LOG_SUCCESS);
+		LOGF_DEBUG("GAMEOBJECT", "Creating gameobject '%s'.", name.c_str());
 
-		return cubePtr;
-	}
-
-	bool Cube::Render(
-		const mat4& view,
-		const mat4& projection)
-	{
-		if (!CanUpdate()) return false;
-
-		string name = GetName();
-		
-		const Shader_OpenGL* shader = GetShader();
-		if (shader == nullptr)
+		const char* newName = LevelArena::CopyString(name);
+		if (newName == nullptr)
 		{
-			Logger::Print(
-				"Cannot render gameobject '" + name + "' because its shader is nullptr!",
-				"GAMEOBJECT",
-				LogType::LOG_ERROR,
-				2);
+			LOGF_ERROR("GAMEOBJECT", "Failed to allocate the name of gameobject '%s' in the level arena!", name.c_str());
 
-			return false;
+			return INVALID_ENTITY;
 		}
 
-		if (!shader->Bind())
+		Entity entity = EntityStore::Create();
+		if (entity == INVALID_ENTITY)
 		{
-			Logger::Print(
-				"Failed to bind shader '" + shader->GetName() + "'!",
-				"GAMEOBJECT_CUBE",
-				LogType::LOG_ERROR,
-				2);
+			LOGF_ERROR("GAMEOBJECT", "Failed to create gameobject '%s' because every entity slot is in use!", name.c_str());
 
-			return false;
+			return INVALID_ENTITY;
 		}
 
-		u32 programID = shader->GetProgramID();
-
-		shader->SetMat4(programID, "projection", projection);
-		shader->SetMat4(programID, "view", view);
+		EntityStore::GetNames().Add(entity, NameComponent{ .name = newName });
+		TransformSystem::Add(entity, pos, rot, scale);
+		EntityStore::GetRenders().Add(entity, RenderComponent{ .blockType = blockType });
 
-		mat4 model = mat4(1.0f);
-		model = translate(model, GetPos());
-		quat newRot = quat(radians(GetRot()));
-		model *= mat4_cast(newRot);
-		model = glm::scale(model, vec3(1));
-
-		shader->SetMat4(programID, "model", model);
-
-		u32 vao = GetVAO();
-		glBindVertexArray(vao);
-		glDrawArrays(GL_LINES, 0, 24);
-
-		return true;
-	}
-
-	Cube::~Cube()
-	{
-		u32 vao = GetVAO();
-		u32 vbo = GetVBO();
-		u32 ebo = GetEBO();
-
-		if (vao != 0)
+		//switches start on, water next to them turns them off
+		bool isSource = blockType == BlockType::PowerSwitch;
+		EntityStore::GetCircuits().Add(entity, CircuitComponent
 		{
-			glDeleteVertexArrays(1, &vao);
-			SetVAO(0);
-		}
-		if (vbo != 0)
+			.powerLevel = isSource ? MAX_POWER_LEVEL : static_cast<u8>(0),
+			.isPowered = isSource,
+			.isSource = isSource
+		});
+
+		//picking and collision see the grid cells, blocks are never rotated off the grid axes
+		vec3 halfExtents = scale * 0.5f;
+		if (!ChunkStore::FillBox(pos - halfExtents, pos + halfExtents, MakeBlockCell(blockType)))
 		{
-			glDeleteBuffers(1, &vbo);
-			SetVBO(0);
+			LOGF_ERROR("GAMEOBJECT", "Failed to allocate the grid chunk of gameobject '%s'!", name.c_str());
 		}
-		if (ebo != 0)
+		else
 		{
-			glDeleteBuffers(1, &ebo);
-			SetEBO(0);
-		}
-
-		Logger::Print(
-			"Destroyed gameobject '" + GetName() + "'!",
-			"GAMEOBJECT",
-			LogType::LOG_SUCCESS);
-	}
-}
-
-void CreateCube(Cube* cube)
-{
-	f32 vertices[] =
-	{
-		//edges of the cube
-		-0.5f, -0.5f, -0.5f,
-		 0.5f, -0.5f, -0.5f,
-
-		 0.5f, -0.5f, -0.5f,
-		 0.5f,  0.5f, -0.5f,
-
-		 0.5f,  0.5f, -0.5f,
-		-0.5f,  0.5f, -0.5f,
-
-		-0.5f,  0.5f, -0.5f,
-		-0.5f, -0.5f, -0.5f,
-
-		-0.5f, -0.5f,  0.5f,
-		 0.5f, -0.5f,  0.5f,
-
-		 0.5f, -0.5f,  0.5f,
-		 0.5f,  0.5f,  0.5f,
-
-		 0.5f,  0.5f,  0.5f,
-		-0.5f,  0.5f,  0.5f,
-
-		-0.5f,  0.5f,  0.5f,
-		-0.5f, -0.5f,  0.5f,
+			SupportSystem::Add(entity, pos - halfExtents, pos + halfExtents, isAnchored);
 
-		//connecting edges
-		-0.5f, -0.5f, -0.5f,
-		-0.5f, -0.5f,  0.5f,
-
-		 0.5f, -0.5f, -0.5f,
-		 0.5f, -0.5f,  0.5f,
-
-		 0.5f,  0.5f, -0.5f,
-		 0.5f,  0.5f,  0.5f,
-
-		-0.5f,  0.5f, -0.5f,
-		-0.5f,  0.5f,  0.5f,
-	};
-
-	u32 vao{};
-	u32 vbo{};
-
-	glGenVertexArrays(1, &vao);
-	glGenBuffers(1, &vbo);
-
-	glBindVertexArray(vao);
-
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-	glBufferData(
-		GL_ARRAY_BUFFER,
-		sizeof(vertices),
-		vertices,
-		GL_STATIC_DRAW);
-
-	//position
-	glVertexAttribPointer(
-		0,
-		3,
-		GL_FLOAT,
-		GL_FALSE,
-		3 * sizeof(f32),
-		(void*)0);
+			ivec3 firstCell{};
+			ivec3 lastCell{};
+			ChunkStore::GetBoxCells(pos - halfExtents, pos + halfExtents, firstCell, lastCell);
+			WaterSystem::AddCircuit(entity, firstCell, lastCell);
+		}
 
-	glEnableVertexAttribArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+		LOGF_SUCCESS("GAMEOBJECT", "Created gameobject '%s'!", name.c_str());
 
-	cube->SetVAO(vao);
-	cube->SetVBO(vbo);
+		return entity;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+
+#include "gameobjects/entitystore.hpp"
+#include "gameobjects/transformsystem.hpp"
+#include "core/handle.hpp"
+#include "world/debrissystem.hpp"
+#include "world/supportsystem.hpp"
+#include "world/watersystem.hpp"
+
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::Entity;
+using CircuitGame::GameObjects::EntityTag;
+using CircuitGame::GameObjects::TransformSystem;
+using CircuitGame::Core::HandleSlots;
+using CircuitGame::World::DebrisSystem;
+using CircuitGame::World::SupportSystem;
+using CircuitGame::World::WaterSystem;
+
+using std::vector;
+
+static HandleSlots<EntityTag> entitySlots{};
+static vector<Entity> pendingDestroys{};
+
+static void RemoveComponents(Entity entity);
+
+namespace CircuitGame::GameObjects
+{
+	Entity EntityStore::Create()
+	{
+		return entitySlots.Create();
+	}
+
+	void EntityStore::Destroy(Entity entity)
+	{
+		if (!IsAlive(entity)) return;
+
+		pendingDestroys.push_back(entity);
+	}
+
+	void EntityStore::EndFrame()
+	{
+		for (Entity entity : pendingDestroys)
+		{
+			//destroyed twice in one frame
+			if (!IsAlive(entity)) continue;
+
+			RemoveComponents(entity);
+			entitySlots.Destroy(entity);
+		}
+
+		pendingDestroys.clear();
+	}
+
+	bool EntityStore::IsAlive(Entity entity)
+	{
+		return entitySlots.IsAlive(entity);
+	}
+
+	u32 EntityStore::GetCount()
+	{
+		return entitySlots.GetAliveCount();
+	}
+
+	void EntityStore::Clear()
+	{
+		names.Clear();
+		transforms.Clear();
+		renders.Clear();
+		circuits.Clear();
+		triggers.Clear();
+		debris.Clear();
+		supports.Clear();
+		TransformSystem::Clear();
+		DebrisSystem::Clear();
+		SupportSystem::Clear();
+		WaterSystem::ClearCircuits();
+
+		entitySlots.Clear();
+		pendingDestroys.clear();
+	}
+}
+
+void RemoveComponents(Entity entity)
+{
+	EntityStore::GetNames().Remove(entity);
+
+	//children become roots instead of pointing at a removed parent
+	TransformSystem::Remove(entity);
+	EntityStore::GetTransforms().Remove(entity);
+	EntityStore::GetRenders().Remove(entity);
+	WaterSystem::RemoveCircuit(entity);
+	EntityStore::GetCircuits().Remove(entity);
+	EntityStore::GetTriggers().Remove(entity);
+
+	//the broadphase proxy goes with the body
+	DebrisSystem::Remove(entity);
+	EntityStore::GetDebris().Remove(entity);
+
+	//the cells of the block are emptied and whatever stood on it is checked
+	SupportSystem::Remove(entity);
+	EntityStore::GetSupports().Remove(entity);
+}
\ No newline at end of file
@@ -0,0 +1,456 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "gameobjects/transformsystem.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "core/profiler.hpp"
+
+using CircuitGame::GameObjects::TransformSystem;
+using CircuitGame::GameObjects::TransformComponent;
+using CircuitGame::GameObjects::TransformMatrices;
+using CircuitGame::GameObjects::ComponentArray;
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::Entity;
+using CircuitGame::GameObjects::INVALID_ENTITY;
+using CircuitGame::GameObjects::GetModelMatrix;
+
+using std::vector;
+using std::span;
+using std::sort;
+using std::abs;
+using std::memcpy;
+
+//relative tolerance for axes counting as the same length and perpendicular
+static constexpr f32 RIGID_TOLERANCE = 1e-4f;
+
+//parallel to the dense transform array, TransformSystem mirrors every add and swap removal
+static vector<TransformMatrices> matrices{};
+static vector<Entity> dirtyEntities{};
+
+//reused by every subtree walk so Update does not allocate once warmed up
+static vector<Entity> subtreeStack{};
+
+static u32 GetDenseIndex(const TransformComponent& transform);
+static void MarkDirty(
+	Entity entity,
+	TransformComponent& transform);
+static void Unlink(
+	Entity entity,
+	TransformComponent& transform);
+static void SetSubtreeDepth(
+	Entity root,
+	u16 depth);
+static void UpdateSubtree(
+	Entity root,
+	const mat4& parentWorld);
+static void UpdateNormalMatrix(TransformMatrices& transform);
+#if defined(_M_X64) || defined(__x86_64__)
+static f32 Dot(__m128 a, __m128 b);
+static __m128 Cross(__m128 a, __m128 b);
+#endif
+
+namespace CircuitGame::GameObjects
+{
+	TransformComponent* TransformSystem::Add(
+		Entity entity,
+		const vec3& pos,
+		const vec3& rot,
+		const vec3& scale)
+	{
+		TransformComponent& transform = EntityStore::GetTransforms().Add(entity, TransformComponent
+		{
+			.pos = pos,
+			.rot = rot,
+			.scale = scale
+		});
+
+		//an entity that already had a transform keeps its slot
+		u32 index = GetDenseIndex(transform);
+		if (index == matrices.size()) matrices.push_back({});
+		else matrices[index] = {};
+
+		MarkDirty(entity, transform);
+
+		return &transform;
+	}
+
+	const TransformMatrices* TransformSystem::GetMatrices(Entity entity)
+	{
+		const TransformComponent* transform = EntityStore::GetTransforms().Get(entity);
+		return transform != nullptr ? &matrices[GetDenseIndex(*transform)] : nullptr;
+	}
+
+	span<const TransformMatrices> TransformSystem::GetAllMatrices()
+	{
+		return matrices;
+	}
+
+	void TransformSystem::SetPos(Entity entity, const vec3& pos)
+	{
+		TransformComponent* transform = EntityStore::GetTransforms().Get(entity);
+		if (transform == nullptr
+			|| transform->pos == pos)
+		{
+			return;
+		}
+
+		transform->pos = pos;
+		MarkDirty(entity, *transform);
+	}
+
+	void TransformSystem::SetRot(Entity entity, const vec3& rot)
+	{
+		TransformComponent* transform = EntityStore::GetTransforms().Get(entity);
+		if (transform == nullptr
+			|| transform->rot == rot)
+		{
+			return;
+		}
+
+		transform->rot = rot;
+		MarkDirty(entity, *transform);
+	}
+
+	void TransformSystem::SetScale(Entity entity, const vec3& scale)
+	{
+		TransformComponent* transform = EntityStore::GetTransforms().Get(entity);
+		if (transform == nullptr
+			|| transform->scale == scale)
+		{
+			return;
+		}
+
+		transform->scale = scale;
+		MarkDirty(entity, *transform);
+	}
+
+	bool TransformSystem::SetParent(Entity child, Entity parent)
+	{
+		ComponentArray<TransformComponent>& transforms = EntityStore::GetTransforms();
+
+		TransformComponent* childTransform = transforms.Get(child);
+		if (childTransform == nullptr) return false;
+
+		TransformComponent* parentTransform{};
+		if (parent != INVALID_ENTITY)
+		{
+			parentTransform = transforms.Get(parent);
+			if (parentTransform == nullptr) return false;
+
+			//would make a loop
+			for (Entity ancestor = parent; ancestor != INVALID_ENTITY; ancestor = transforms.Get(ancestor)->parent)
+			{
+				if (ancestor == child) return false;
+			}
+		}
+
+		Unlink(child, *childTransform);
+
+		u16 depth = 0;
+		if (parentTransform != nullptr)
+		{
+			childTransform->parent = parent;
+			childTransform->nextSibling = parentTransform->firstChild;
+			if (parentTransform->firstChild != INVALID_ENTITY)
+			{
+				transforms.Get(parentTransform->firstChild)->previousSibling = child;
+			}
+			parentTransform->firstChild = child;
+
+			depth = parentTransform->depth + 1;
+		}
+
+		SetSubtreeDepth(child, depth);
+		MarkDirty(child, *childTransform);
+
+		return true;
+	}
+
+	void TransformSystem::Remove(Entity entity)
+	{
+		ComponentArray<TransformComponent>& transforms = EntityStore::GetTransforms();
+
+		TransformComponent* transform = transforms.Get(entity);
+		if (transform == nullptr) return;
+
+		Unlink(entity, *transform);
+
+		Entity child = transform->firstChild;
+		while (child != INVALID_ENTITY)
+		{
+			TransformComponent& childTransform = *transforms.Get(child);
+			Entity next = childTransform.nextSibling;
+
+			childTransform.parent = INVALID_ENTITY;
+			childTransform.previousSibling = INVALID_ENTITY;
+			childTransform.nextSibling = INVALID_ENTITY;
+
+			SetSubtreeDepth(child, 0);
+			MarkDirty(child, childTransform);
+
+			child = next;
+		}
+		transform->firstChild = INVALID_ENTITY;
+
+		//the same swap the transform array does right after this
+		matrices[GetDenseIndex(*transform)] = matrices.back();
+		matrices.pop_back();
+	}
+
+	void TransformSystem::Update()
+	{
+		if (dirtyEntities.empty()) return;
+
+		PROFILE_ZONE("TransformSystem::Update");
+
+		ComponentArray<TransformComponent>& transforms = EntityStore::GetTransforms();
+
+		//removed entities sort last and are skipped below
+		sort(
+			dirtyEntities.begin(),
+			dirtyEntities.end(),
+			[&transforms](Entity a, Entity b)
+			{
+				const TransformComponent* transformA = transforms.Get(a);
+				const TransformComponent* transformB = transforms.Get(b);
+				u32 depthA = transformA != nullptr ? transformA->depth : 0xFFFFu + 1;
+				u32 depthB = transformB != nullptr ? transformB->depth : 0xFFFFu + 1;
+
+				return depthA < depthB;
+			});
+
+		const mat4 identity = mat4(1.0f);
+
+		//parents come first, so a transform below an already rebuilt one has lost its flag
+		for (Entity entity : dirtyEntities)
+		{
+			const TransformComponent* transform = transforms.Get(entity);
+			if (transform == nullptr
+				|| !transform->isDirty)
+			{
+				continue;
+			}
+
+			const TransformComponent* parent = transforms.Get(transform->parent);
+			UpdateSubtree(entity, parent != nullptr ? matrices[GetDenseIndex(*parent)].world : identity);
+		}
+
+		dirtyEntities.clear();
+	}
+
+	u32 TransformSystem::GetDirtyCount()
+	{
+		return static_cast<u32>(dirtyEntities.size());
+	}
+
+	void TransformSystem::Clear()
+	{
+		matrices.clear();
+		dirtyEntities.clear();
+	}
+}
+
+u32 GetDenseIndex(const TransformComponent& transform)
+{
+	return static_cast<u32>(&transform - EntityStore::GetTransforms().GetComponents().data());
+}
+
+void MarkDirty(
+	Entity entity,
+	TransformComponent& transform)
+{
+	if (transform.isDirty) return;
+
+	transform.isDirty = true;
+	dirtyEntities.push_back(entity);
+}
+
+void Unlink(
+	Entity entity,
+	TransformComponent& transform)
+{
+	ComponentArray<TransformComponent>& transforms = EntityStore::GetTransforms();
+
+	TransformComponent* parent = transforms.Get(transform.parent);
+	if (parent != nullptr
+		&& parent->firstChild == entity)
+	{
+		parent->firstChild = transform.nextSibling;
+	}
+
+	TransformComponent* previous = transforms.Get(transform.previousSibling);
+	if (previous != nullptr) previous->nextSibling = transform.nextSibling;
+
+	TransformComponent* next = transforms.Get(transform.nextSibling);
+	if (next != nullptr) next->previousSibling = transform.previousSibling;
+
+	transform.parent = INVALID_ENTITY;
+	transform.previousSibling = INVALID_ENTITY;
+	transform.nextSibling = INVALID_ENTITY;
+}
+
+void SetSubtreeDepth(
+	Entity root,
+	u16 depth)
+{
+	ComponentArray<TransformComponent>& transforms = EntityStore::GetTransforms();
+
+	transforms.Get(root)->depth = depth;
+
+	subtreeStack.clear();
+	subtreeStack.push_back(root);
+	while (!subtreeStack.empty())
+	{
+		const TransformComponent& transform = *transforms.Get(subtreeStack.back());
+		subtreeStack.pop_back();
+
+		for (Entity child = transform.firstChild; child != INVALID_ENTITY; )
+		{
+			TransformComponent& childTransform = *transforms.Get(child);
+			childTransform.depth = transform.depth + 1;
+
+			subtreeStack.push_back(child);
+			child = childTransform.nextSibling;
+		}
+	}
+}
+
+void UpdateSubtree(
+	Entity root,
+	const mat4& parentWorld)
+{
+	ComponentArray<TransformComponent>& transforms = EntityStore::GetTransforms();
+
+	TransformComponent& rootTransform = *transforms.Get(root);
+	rootTransform.local = GetModelMatrix(rootTransform.pos, rootTransform.rot, rootTransform.scale);
+	rootTransform.isDirty = false;
+
+	TransformMatrices& rootMatrices = matrices[GetDenseIndex(rootTransform)];
+	rootMatrices.world = parentWorld * rootTransform.local;
+	UpdateNormalMatrix(rootMatrices);
+
+	//children keep their local matrix unless they were flagged themselves
+	subtreeStack.clear();
+	subtreeStack.push_back(root);
+	while (!subtreeStack.empty())
+	{
+		const TransformComponent& parent = *transforms.Get(subtreeStack.back());
+		subtreeStack.pop_back();
+
+		const mat4 parentWorldMatrix = matrices[GetDenseIndex(parent)].world;
+
+		for (Entity child = parent.firstChild; child != INVALID_ENTITY; )
+		{
+			TransformComponent& transform = *transforms.Get(child);
+			if (transform.isDirty)
+			{
+				transform.local = GetModelMatrix(transform.pos, transform.rot, transform.scale);
+				transform.isDirty = false;
+			}
+
+			TransformMatrices& childMatrices = matrices[GetDenseIndex(transform)];
+			childMatrices.world = parentWorldMatrix * transform.local;
+			UpdateNormalMatrix(childMatrices);
+
+			subtreeStack.push_back(child);
+			child = transform.nextSibling;
+		}
+	}
+}
+
+void UpdateNormalMatrix(TransformMatrices& transform)
+{
+	const mat4& world = transform.world;
+
+#if defined(_M_X64) || defined(__x86_64__)
+	//the w of the first three columns is zero in an affine matrix, so four wide dots are three wide
+	__m128 column0 = _mm_loadu_ps(&world[0][0]);
+	__m128 column1 = _mm_loadu_ps(&world[1][0]);
+	__m128 column2 = _mm_loadu_ps(&world[2][0]);
+
+	f32 length0 = Dot(column0, column0);
+	f32 length1 = Dot(column1, column1);
+	f32 length2 = Dot(column2, column2);
+	f32 tolerance = RIGID_TOLERANCE * length0;
+
+	transform.isRigid =
+		abs(length0 - length1) <= tolerance
+		&& abs(length0 - length2) <= tolerance
+		&& abs(Dot(column0, column1)) <= tolerance
+		&& abs(Dot(column0, column2)) <= tolerance
+		&& abs(Dot(column1, column2)) <= tolerance;
+
+	if (transform.isRigid) return;
+
+	//columns of the inverse transpose are the cofactor columns over the determinant
+	__m128 cofactor0 = Cross(column1, column2);
+	__m128 cofactor1 = Cross(column2, column0);
+	__m128 cofactor2 = Cross(column0, column1);
+
+	f32 determinant = Dot(column0, cofactor0);
+	if (abs(determinant) < 1e-12f)
+	{
+		transform.normal = mat3(1.0f);
+		return;
+	}
+
+	__m128 inverseDeterminant = _mm_set1_ps(1.0f / determinant);
+
+	alignas(16) f32 columns[3][4]{};
+	_mm_store_ps(columns[0], _mm_mul_ps(cofactor0, inverseDeterminant));
+	_mm_store_ps(columns[1], _mm_mul_ps(cofactor1, inverseDeterminant));
+	_mm_store_ps(columns[2], _mm_mul_ps(cofactor2, inverseDeterminant));
+
+	for (u32 i = 0; i < 3; ++i) memcpy(&transform.normal[i][0], columns[i], 3 * sizeof(f32));
+#else
+	mat3 basis = mat3(world);
+
+	f32 length0 = glm::dot(basis[0], basis[0]);
+	f32 tolerance = RIGID_TOLERANCE * length0;
+
+	transform.isRigid =
+		abs(length0 - glm::dot(basis[1], basis[1])) <= tolerance
+		&& abs(length0 - glm::dot(basis[2], basis[2])) <= tolerance
+		&& abs(glm::dot(basis[0], basis[1])) <= tolerance
+		&& abs(glm::dot(basis[0], basis[2])) <= tolerance
+		&& abs(glm::dot(basis[1], basis[2])) <= tolerance;
+
+	if (transform.isRigid) return;
+
+	f32 determinant = glm::determinant(basis);
+	transform.normal = abs(determinant) < 1e-12f
+		? mat3(1.0f)
+		: glm::transpose(glm::inverse(basis));
+#endif
+}
+
+#if defined(_M_X64) || defined(__x86_64__)
+f32 Dot(__m128 a, __m128 b)
+{
+	__m128 product = _mm_mul_ps(a, b);
+	__m128 shuffled = _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1));
+	__m128 sums = _mm_add_ps(product, shuffled);
+	shuffled = _mm_movehl_ps(shuffled, sums);
+
+	return _mm_cvtss_f32(_mm_add_ss(sums, shuffled));
+}
+
+__m128 Cross(__m128 a, __m128 b)
+{
+	__m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 result = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+
+	return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+}
+#endif
\ No newline at end of file
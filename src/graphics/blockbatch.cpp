@@ -0,0 +1,411 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+//kalawindow
+#include "graphics/opengl/opengl_core.hpp"
+#include "graphics/opengl/shader_opengl.hpp"
+#include "core/log.hpp"
+
+#include "graphics/blockbatch.hpp"
+#include "graphics/rendersnapshot.hpp"
+#include "graphics/blocktextures.hpp"
+#include "graphics/glfunctions.hpp"
+#include "core/gamecore.hpp"
+#include "core/profiler.hpp"
+
+//kalawindow
+using KalaWindow::Graphics::OpenGL::Shader_OpenGL;
+using KalaWindow::Graphics::OpenGL::ShaderStage;
+using KalaWindow::Graphics::OpenGL::ShaderType;
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Graphics::BlockBatch;
+using CircuitGame::Graphics::BlockInstance;
+using CircuitGame::Graphics::ScaledBlockInstance;
+using CircuitGame::Graphics::RenderSnapshot;
+using CircuitGame::Graphics::BlockTextures;
+using CircuitGame::Core::mainWindow;
+
+using std::string;
+using std::vector;
+using std::filesystem::path;
+using std::filesystem::current_path;
+
+static constexpr u32 CUBE_VERTEX_COUNT = 36;
+static constexpr u32 INSTANCE_ATTRIBUTE_START = 3;
+
+//both instance layouts start the same way, only scaled blocks carry a normal matrix after the layer
+static_assert(offsetof(BlockInstance, model) == offsetof(ScaledBlockInstance, model));
+static_assert(offsetof(BlockInstance, layer) == offsetof(ScaledBlockInstance, layer));
+
+//one shader, vertex array and instance buffer per instance layout, all sharing the cube mesh
+struct InstanceStream
+{
+	u32 VAO{};
+	u32 instanceVBO{};
+	size_t capacity{};
+	Shader_OpenGL* shader{};
+};
+
+static u32 meshVBO{};
+static InstanceStream rigidStream{};
+static InstanceStream scaledStream{};
+
+static Shader_OpenGL* CreateBlockShader(
+	const string& shaderName,
+	const string& vertName);
+static void CreateCubeMesh();
+static void CreateInstanceStream(
+	InstanceStream& stream,
+	GLsizei instanceStride,
+	bool hasNormalMatrix);
+static void DrawInstances(
+	InstanceStream& stream,
+	const void* instances,
+	size_t instanceCount,
+	size_t instanceSize,
+	const RenderSnapshot& snapshot);
+static void DeleteInstanceStream(InstanceStream& stream);
+
+namespace CircuitGame::Graphics
+{
+	bool BlockBatch::Initialize()
+	{
+		PROFILE_ZONE("BlockBatch::Initialize");
+
+		//rigid blocks are lit with their model matrix,
+		//the others get the normal matrix the transform update already computed
+		rigidStream.shader = CreateBlockShader("shader_block", "block.vert");
+		scaledStream.shader = CreateBlockShader("shader_block_scaled", "block_scaled.vert");
+
+		if (rigidStream.shader == nullptr
+			|| scaledStream.shader == nullptr)
+		{
+			Logger::Print(
+				"Failed to create block shaders!",
+				"BLOCK_BATCH",
+				LogType::LOG_ERROR,
+				2);
+
+			return false;
+		}
+
+		CreateCubeMesh();
+		CreateInstanceStream(rigidStream, sizeof(BlockInstance), false);
+		CreateInstanceStream(scaledStream, sizeof(ScaledBlockInstance), true);
+
+		Logger::Print(
+			"Created block batch!",
+			"BLOCK_BATCH",
+			LogType::LOG_SUCCESS);
+
+		return true;
+	}
+
+	BlockInstance BlockBatch::MakeInstance(
+		const mat4& model,
+		BlockType type)
+	{
+		BlockInstance instance{};
+		instance.model = model;
+		instance.layer = static_cast<f32>(BlockTextures::GetLayer(type));
+
+		return instance;
+	}
+
+	ScaledBlockInstance BlockBatch::MakeScaledInstance(
+		const mat4& model,
+		const mat3& normal,
+		BlockType type)
+	{
+		ScaledBlockInstance instance{};
+		instance.model = model;
+		instance.layer = static_cast<f32>(BlockTextures::GetLayer(type));
+		instance.normal = normal;
+
+		return instance;
+	}
+
+	void BlockBatch::Draw(const RenderSnapshot& snapshot)
+	{
+		DrawInstances(
+			rigidStream,
+			snapshot.blocks.data(),
+			snapshot.blocks.size(),
+			sizeof(BlockInstance),
+			snapshot);
+		DrawInstances(
+			scaledStream,
+			snapshot.scaledBlocks.data(),
+			snapshot.scaledBlocks.size(),
+			sizeof(ScaledBlockInstance),
+			snapshot);
+	}
+
+	void BlockBatch::Shutdown()
+	{
+		DeleteInstanceStream(rigidStream);
+		DeleteInstanceStream(scaledStream);
+
+		if (meshVBO != 0)
+		{
+			glDeleteBuffers(1, &meshVBO);
+			meshVBO = 0;
+		}
+	}
+}
+
+Shader_OpenGL* CreateBlockShader(
+	const string& shaderName,
+	const string& vertName)
+{
+	string vertPath = path(current_path() / "files" / "shaders" / vertName).string();
+	string fragPath = path(current_path() / "files" / "shaders" / "block.frag").string();
+
+	vector<ShaderStage> stages
+	{
+		ShaderStage
+		{
+			.shaderType = ShaderType::Shader_Vertex,
+			.shaderPath = vertPath,
+			.shaderID = 0
+		},
+		ShaderStage
+		{
+			.shaderType = ShaderType::Shader_Fragment,
+			.shaderPath = fragPath,
+			.shaderID = 0
+		}
+	};
+
+	return Shader_OpenGL::CreateShader(
+		shaderName,
+		stages,
+		mainWindow);
+}
+
+void CreateCubeMesh()
+{
+	//position, normal, texture coordinates, counter-clockwise front faces
+	f32 vertices[] =
+	{
+		//back
+		 0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+		-0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 0.0f,
+		-0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f, 1.0f,
+		 0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 1.0f,
+		 0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f, 0.0f,
+
+		//front
+		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+		 0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 0.0f,
+		 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+		 0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f, 1.0f,
+		-0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f, 0.0f,
+
+		//left
+		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+		-0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+		-0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+
+		//right
+		 0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+		 0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 0.0f,
+		 0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+		 0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f, 1.0f,
+		 0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 1.0f,
+		 0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f, 0.0f,
+
+		//bottom
+		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+		 0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 0.0f,
+		 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+		 0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f, 1.0f,
+		-0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 1.0f,
+		-0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f, 0.0f,
+
+		//top
+		-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+		 0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 0.0f,
+		 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+		 0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f, 1.0f,
+		-0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 1.0f,
+		-0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f, 0.0f,
+	};
+
+	glGenBuffers(1, &meshVBO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		sizeof(vertices),
+		vertices,
+		GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CreateInstanceStream(
+	InstanceStream& stream,
+	GLsizei instanceStride,
+	bool hasNormalMatrix)
+{
+	glGenVertexArrays(1, &stream.VAO);
+	glGenBuffers(1, &stream.instanceVBO);
+
+	glBindVertexArray(stream.VAO);
+
+	//per-vertex data
+
+	glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+
+	GLsizei vertexStride = 8 * sizeof(f32);
+
+	//position
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, vertexStride, (void*)0);
+	glEnableVertexAttribArray(0);
+
+	//normal
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, vertexStride, (void*)(3 * sizeof(f32)));
+	glEnableVertexAttribArray(1);
+
+	//texture coordinates
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, vertexStride, (void*)(6 * sizeof(f32)));
+	glEnableVertexAttribArray(2);
+
+	//per-instance data
+
+	glBindBuffer(GL_ARRAY_BUFFER, stream.instanceVBO);
+
+	//model matrix, one column per attribute
+	for (u32 column = 0; column < 4; ++column)
+	{
+		u32 location = INSTANCE_ATTRIBUTE_START + column;
+		glVertexAttribPointer(
+			location,
+			4,
+			GL_FLOAT,
+			GL_FALSE,
+			instanceStride,
+			(void*)(offsetof(BlockInstance, model) + column * sizeof(vec4)));
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1);
+	}
+
+	//texture array layer
+	u32 layerLocation = INSTANCE_ATTRIBUTE_START + 4;
+	glVertexAttribPointer(
+		layerLocation,
+		1,
+		GL_FLOAT,
+		GL_FALSE,
+		instanceStride,
+		(void*)offsetof(BlockInstance, layer));
+	glEnableVertexAttribArray(layerLocation);
+	glVertexAttribDivisor(layerLocation, 1);
+
+	//normal matrix, one column per attribute
+	if (hasNormalMatrix)
+	{
+		for (u32 column = 0; column < 3; ++column)
+		{
+			u32 location = INSTANCE_ATTRIBUTE_START + 5 + column;
+			glVertexAttribPointer(
+				location,
+				3,
+				GL_FLOAT,
+				GL_FALSE,
+				instanceStride,
+				(void*)(offsetof(ScaledBlockInstance, normal) + column * sizeof(vec3)));
+			glEnableVertexAttribArray(location);
+			glVertexAttribDivisor(location, 1);
+		}
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void DrawInstances(
+	InstanceStream& stream,
+	const void* instances,
+	size_t instanceCount,
+	size_t instanceSize,
+	const RenderSnapshot& snapshot)
+{
+	Shader_OpenGL* shader = stream.shader;
+
+	if (instanceCount == 0
+		|| shader == nullptr
+		|| !shader->Bind())
+	{
+		return;
+	}
+
+	u32 programID = shader->GetProgramID();
+
+	shader->SetMat4(programID, "projection", snapshot.projection);
+	shader->SetMat4(programID, "view", snapshot.view);
+	shader->SetVec3(programID, "viewPos", snapshot.viewPos);
+	shader->SetVec3(programID, "lightDirection", snapshot.dirLight.direction);
+	shader->SetVec3(programID, "lightColor", snapshot.dirLight.color);
+	shader->SetFloat(programID, "ambientStrength", snapshot.dirLight.ambientStrength);
+	shader->SetInt(programID, "blockTextures", 0);
+
+	BlockTextures::Bind(0);
+
+	//grow the instance buffer when needed, otherwise orphan and refill it
+
+	size_t byteSize = instanceCount * instanceSize;
+
+	glBindBuffer(GL_ARRAY_BUFFER, stream.instanceVBO);
+	if (instanceCount > stream.capacity) stream.capacity = instanceCount * 2;
+
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		static_cast<GLsizeiptr>(stream.capacity * instanceSize),
+		nullptr,
+		GL_STREAM_DRAW);
+	glBufferSubData(
+		GL_ARRAY_BUFFER,
+		0,
+		static_cast<GLsizeiptr>(byteSize),
+		instances);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_CULL_FACE);
+
+	glBindVertexArray(stream.VAO);
+	glDrawArraysInstanced(
+		GL_TRIANGLES,
+		0,
+		CUBE_VERTEX_COUNT,
+		static_cast<GLsizei>(instanceCount));
+	glBindVertexArray(0);
+}
+
+void DeleteInstanceStream(InstanceStream& stream)
+{
+	if (stream.VAO != 0)
+	{
+		glDeleteVertexArrays(1, &stream.VAO);
+	}
+	if (stream.instanceVBO != 0)
+	{
+		glDeleteBuffers(1, &stream.instanceVBO);
+	}
+
+	stream = InstanceStream{};
+}
\ No newline at end of file
@@ -0,0 +1,461 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image/stb_image.h"
+
+//kalawindow
+#include "graphics/opengl/opengl_core.hpp"
+#include "core/log.hpp"
+
+#include "graphics/blocktextures.hpp"
+#include "graphics/glfunctions.hpp"
+#include "graphics/cookedtexture.hpp"
+#include "core/profiler.hpp"
+
+//kalawindow
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Graphics::BlockTextures;
+using CircuitGame::Graphics::GLFunctions;
+using CircuitGame::Graphics::CookedFormat;
+using CircuitGame::Graphics::CookedTextureHeader;
+using CircuitGame::Graphics::CookedMipEntry;
+using CircuitGame::Graphics::CookedTextureView;
+using CircuitGame::Graphics::ParseCookedTexture;
+using CircuitGame::Graphics::COOKED_TEXTURE_EXTENSION;
+using CircuitGame::GameObjects::BlockType;
+using CircuitGame::GameObjects::GetBlockTypeName;
+using CircuitGame::GameObjects::GetBlockFallbackTint;
+using CircuitGame::GameObjects::BLOCK_TYPE_COUNT;
+
+using std::string;
+using std::vector;
+using std::filesystem::path;
+using std::filesystem::current_path;
+using std::filesystem::exists;
+using std::max;
+using std::move;
+using std::to_string;
+using std::ifstream;
+using std::ios;
+using std::streamsize;
+
+struct LayerImage
+{
+	vector<u8> pixels{};
+	i32 width{};
+	i32 height{};
+};
+
+static bool UploadCookedLayers(vec2& outSize, u32& outLevels);
+static bool UploadSourceLayers(vec2& outSize, u32& outLevels);
+
+static bool ReadFile(const path& filePath, vector<u8>& outBytes);
+static bool LoadLayerImage(const string& imagePath, LayerImage& outImage);
+static string FindBlockTexture(BlockType type);
+static void Resample(
+	const LayerImage& source,
+	i32 width,
+	i32 height,
+	LayerImage& outImage);
+
+namespace CircuitGame::Graphics
+{
+	bool BlockTextures::Initialize()
+	{
+		PROFILE_ZONE("BlockTextures::Initialize");
+
+		if (isInitialized)
+		{
+			Logger::Print(
+				"Cannot initialize block textures because they are already initialized!",
+				"BLOCK_TEXTURES",
+				LogType::LOG_ERROR,
+				2);
+
+			return false;
+		}
+
+		u32 textureID{};
+		glGenTextures(1, &textureID);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+
+		//cooked textures are uploaded as they are, source images are decoded and mipmapped here
+
+		vec2 layerSize{};
+		u32 levels{};
+		bool isCooked = UploadCookedLayers(layerSize, levels);
+		if (!isCooked
+			&& !UploadSourceLayers(layerSize, levels))
+		{
+			glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+			glDeleteTextures(1, &textureID);
+
+			return false;
+		}
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels - 1));
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+		openGLID = textureID;
+		size = layerSize;
+		mipMapLevels = levels;
+		isInitialized = true;
+
+		string source = isCooked ? "cooked" : "source";
+		Logger::Print(
+			"Created block texture array from " + source + " textures with " + to_string(BLOCK_TYPE_COUNT)
+			+ " layers and " + to_string(levels) + " mip levels!",
+			"BLOCK_TEXTURES",
+			LogType::LOG_SUCCESS);
+
+		return true;
+	}
+
+	void BlockTextures::Bind(u32 unit)
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, openGLID);
+	}
+
+	void BlockTextures::Shutdown()
+	{
+		if (openGLID != 0)
+		{
+			glDeleteTextures(1, &openGLID);
+			openGLID = 0;
+		}
+
+		isInitialized = false;
+	}
+}
+
+bool UploadCookedLayers(vec2& outSize, u32& outLevels)
+{
+	PROFILE_ZONE("BlockTextures::UploadCookedLayers");
+
+	path folder = current_path() / "files" / "cooked" / "textures" / "blocks";
+	if (!exists(folder)) return false;
+
+	//every layer must be cooked, in the same format, size and mip count
+
+	vector<vector<u8>> files(BLOCK_TYPE_COUNT);
+	vector<CookedTextureView> views(BLOCK_TYPE_COUNT);
+	for (u32 i = 0; i < BLOCK_TYPE_COUNT; ++i)
+	{
+		string name = GetBlockTypeName(static_cast<BlockType>(i));
+		path filePath = folder / (name + COOKED_TEXTURE_EXTENSION);
+
+		if (!ReadFile(filePath, files[i])
+			|| !ParseCookedTexture(files[i], views[i]))
+		{
+			Logger::Print(
+				"Cooked block texture '" + filePath.string() + "' is missing or invalid, using source textures.",
+				"BLOCK_TEXTURES",
+				LogType::LOG_WARNING);
+
+			return false;
+		}
+
+		const CookedTextureHeader& first = views[0].header;
+		const CookedTextureHeader& current = views[i].header;
+		if (current.format != first.format
+			|| current.width != first.width
+			|| current.height != first.height
+			|| current.mipCount != first.mipCount)
+		{
+			Logger::Print(
+				"Cooked block texture '" + name + "' does not match the first layer, using source textures.",
+				"BLOCK_TEXTURES",
+				LogType::LOG_WARNING);
+
+			return false;
+		}
+	}
+
+	const CookedTextureHeader& header = views[0].header;
+
+	GLenum internalFormat{};
+	switch (header.format)
+	{
+	case CookedFormat::Cooked_BC1:
+		internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		break;
+	case CookedFormat::Cooked_BC3:
+		internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		break;
+	case CookedFormat::Cooked_RGBA8:
+		internalFormat = GL_RGBA8;
+		break;
+	}
+
+	if (header.format != CookedFormat::Cooked_RGBA8
+		&& !GLFunctions::IsExtensionSupported("GL_EXT_texture_compression_s3tc"))
+	{
+		Logger::Print(
+			"S3TC texture compression is not supported, using source textures.",
+			"BLOCK_TEXTURES",
+			LogType::LOG_WARNING);
+
+		return false;
+	}
+
+	//layers of one mip level are contiguous in a 2D array, so each level is one upload
+
+	size_t totalBytes = 0;
+	vector<u8> levelBytes{};
+	for (u32 level = 0; level < header.mipCount; ++level)
+	{
+		const CookedMipEntry& mip = views[0].mips[level];
+
+		levelBytes.resize(static_cast<size_t>(mip.size) * BLOCK_TYPE_COUNT);
+		for (u32 i = 0; i < BLOCK_TYPE_COUNT; ++i)
+		{
+			memcpy(
+				levelBytes.data() + static_cast<size_t>(mip.size) * i,
+				views[i].GetMipData(level),
+				mip.size);
+		}
+
+		if (header.format == CookedFormat::Cooked_RGBA8)
+		{
+			glTexImage3D(
+				GL_TEXTURE_2D_ARRAY,
+				static_cast<GLint>(level),
+				GL_RGBA8,
+				static_cast<GLsizei>(mip.width),
+				static_cast<GLsizei>(mip.height),
+				static_cast<GLsizei>(BLOCK_TYPE_COUNT),
+				0,
+				GL_RGBA,
+				GL_UNSIGNED_BYTE,
+				levelBytes.data());
+		}
+		else
+		{
+			glCompressedTexImage3D(
+				GL_TEXTURE_2D_ARRAY,
+				static_cast<GLint>(level),
+				internalFormat,
+				static_cast<GLsizei>(mip.width),
+				static_cast<GLsizei>(mip.height),
+				static_cast<GLsizei>(BLOCK_TYPE_COUNT),
+				0,
+				static_cast<GLsizei>(levelBytes.size()),
+				levelBytes.data());
+		}
+
+		totalBytes += levelBytes.size();
+	}
+
+	Logger::Print(
+		"Uploaded " + to_string(totalBytes / 1024) + "KB of cooked block texture data.",
+		"BLOCK_TEXTURES",
+		LogType::LOG_DEBUG);
+
+	outSize = vec2(header.width, header.height);
+	outLevels = header.mipCount;
+
+	return true;
+}
+
+bool UploadSourceLayers(vec2& outSize, u32& outLevels)
+{
+	PROFILE_ZONE("BlockTextures::UploadSourceLayers");
+
+	string fallbackPath = path(current_path() / "files" / "textures" / "cube.jpg").string();
+
+	LayerImage fallback{};
+	if (!LoadLayerImage(fallbackPath, fallback)) return false;
+
+	//every layer must share the size of the first layer
+
+	vector<LayerImage> layers(BLOCK_TYPE_COUNT);
+	for (u32 i = 0; i < BLOCK_TYPE_COUNT; ++i)
+	{
+		BlockType type = static_cast<BlockType>(i);
+		string texturePath = FindBlockTexture(type);
+
+		LayerImage image{};
+		if (texturePath.empty()
+			|| !LoadLayerImage(texturePath, image))
+		{
+			image = fallback;
+
+			vec3 tint = GetBlockFallbackTint(type);
+			for (size_t p = 0; p < image.pixels.size(); p += 4)
+			{
+				image.pixels[p + 0] = static_cast<u8>(image.pixels[p + 0] * tint.r);
+				image.pixels[p + 1] = static_cast<u8>(image.pixels[p + 1] * tint.g);
+				image.pixels[p + 2] = static_cast<u8>(image.pixels[p + 2] * tint.b);
+			}
+		}
+
+		if (i > 0
+			&& (image.width != layers[0].width
+			|| image.height != layers[0].height))
+		{
+			Logger::Print(
+				"Block texture '" + GetBlockTypeName(type) + "' size does not match the first layer, resampling it.",
+				"BLOCK_TEXTURES",
+				LogType::LOG_WARNING);
+
+			LayerImage resampled{};
+			Resample(image, layers[0].width, layers[0].height, resampled);
+			image = move(resampled);
+		}
+
+		layers[i] = move(image);
+	}
+
+	i32 width = layers[0].width;
+	i32 height = layers[0].height;
+
+	u32 levels = 1;
+	for (i32 largest = max(width, height); largest > 1; largest /= 2) ++levels;
+
+	glTexImage3D(
+		GL_TEXTURE_2D_ARRAY,
+		0,
+		GL_RGBA8,
+		width,
+		height,
+		static_cast<GLsizei>(BLOCK_TYPE_COUNT),
+		0,
+		GL_RGBA,
+		GL_UNSIGNED_BYTE,
+		nullptr);
+
+	for (u32 i = 0; i < BLOCK_TYPE_COUNT; ++i)
+	{
+		glTexSubImage3D(
+			GL_TEXTURE_2D_ARRAY,
+			0,
+			0,
+			0,
+			static_cast<GLint>(i),
+			width,
+			height,
+			1,
+			GL_RGBA,
+			GL_UNSIGNED_BYTE,
+			layers[i].pixels.data());
+	}
+
+	//full mip chain for every layer
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels - 1));
+	glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+	outSize = vec2(width, height);
+	outLevels = levels;
+
+	return true;
+}
+
+bool ReadFile(const path& filePath, vector<u8>& outBytes)
+{
+	if (!exists(filePath)) return false;
+
+	ifstream file(filePath, ios::binary | ios::ate);
+	if (!file.is_open()) return false;
+
+	streamsize fileSize = file.tellg();
+	file.seekg(0, ios::beg);
+
+	outBytes.resize(static_cast<size_t>(fileSize));
+	return static_cast<bool>(file.read(reinterpret_cast<char*>(outBytes.data()), fileSize));
+}
+
+bool LoadLayerImage(const string& imagePath, LayerImage& outImage)
+{
+	i32 width{};
+	i32 height{};
+	i32 channels{};
+
+	stbi_set_flip_vertically_on_load(true);
+	u8* data = stbi_load(
+		imagePath.c_str(),
+		&width,
+		&height,
+		&channels,
+		4);
+
+	if (data == nullptr)
+	{
+		Logger::Print(
+			"Failed to load block texture '" + imagePath + "'! Reason: " + stbi_failure_reason(),
+			"BLOCK_TEXTURES",
+			LogType::LOG_ERROR,
+			2);
+
+		return false;
+	}
+
+	outImage.width = width;
+	outImage.height = height;
+	outImage.pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+
+	stbi_image_free(data);
+
+	return true;
+}
+
+string FindBlockTexture(BlockType type)
+{
+	path folder = current_path() / "files" / "textures" / "blocks";
+	string name = GetBlockTypeName(type);
+
+	for (const char* extension : { ".png", ".jpg" })
+	{
+		path candidate = folder / (name + extension);
+		if (exists(candidate)) return candidate.string();
+	}
+
+	return "";
+}
+
+void Resample(
+	const LayerImage& source,
+	i32 width,
+	i32 height,
+	LayerImage& outImage)
+{
+	outImage.width = width;
+	outImage.height = height;
+	outImage.pixels.resize(static_cast<size_t>(width) * height * 4);
+
+	for (i32 y = 0; y < height; ++y)
+	{
+		i32 sourceY = y * source.height / height;
+		for (i32 x = 0; x < width; ++x)
+		{
+			i32 sourceX = x * source.width / width;
+
+			const u8* from = &source.pixels[(static_cast<size_t>(sourceY) * source.width + sourceX) * 4];
+			u8* to = &outImage.pixels[(static_cast<size_t>(y) * width + x) * 4];
+
+			to[0] = from[0];
+			to[1] = from[1];
+			to[2] = from[2];
+			to[3] = from[3];
+		}
+	}
+}
\ No newline at end of file
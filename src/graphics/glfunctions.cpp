@@ -0,0 +1,139 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <string>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+//kalawindow
+#include "graphics/opengl/opengl_core.hpp"
+#include "core/log.hpp"
+
+#include "graphics/glfunctions.hpp"
+
+//kalawindow
+using KalaWindow::Graphics::Window;
+using KalaWindow::Graphics::OpenGL::OpenGLCore;
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using std::string;
+
+void (K_APIENTRY* glTexImage3D)(
+	GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) = nullptr;
+void (K_APIENTRY* glTexSubImage3D)(
+	GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const void*) = nullptr;
+void (K_APIENTRY* glCompressedTexImage3D)(
+	GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const void*) = nullptr;
+void (K_APIENTRY* glVertexAttribDivisor)(
+	GLuint, GLuint) = nullptr;
+void (K_APIENTRY* glDrawArraysInstanced)(
+	GLenum, GLint, GLsizei, GLsizei) = nullptr;
+void (K_APIENTRY* glBufferSubData)(
+	GLenum, GLintptr, GLsizeiptr, const void*) = nullptr;
+void (K_APIENTRY* glBlendFunc)(
+	GLenum, GLenum) = nullptr;
+void (K_APIENTRY* glDepthMask)(
+	GLboolean) = nullptr;
+const GLubyte* (K_APIENTRY* glGetStringi)(
+	GLenum, GLuint) = nullptr;
+void (K_APIENTRY* glGenQueries)(
+	GLsizei, GLuint*) = nullptr;
+void (K_APIENTRY* glDeleteQueries)(
+	GLsizei, const GLuint*) = nullptr;
+void (K_APIENTRY* glBeginQuery)(
+	GLenum, GLuint) = nullptr;
+void (K_APIENTRY* glEndQuery)(
+	GLenum) = nullptr;
+void (K_APIENTRY* glGetQueryObjectuiv)(
+	GLuint, GLenum, GLuint*) = nullptr;
+void (K_APIENTRY* glGetQueryObjectui64v)(
+	GLuint, GLenum, GLuint64*) = nullptr;
+
+template<typename T> static bool LoadFunction(T& target, const char* name)
+{
+	target = reinterpret_cast<T>(OpenGLCore::GetGLProcAddress(name));
+	if (target == nullptr)
+	{
+		Logger::Print(
+			"Failed to load OpenGL function '" + string(name) + "'!",
+			"GL_FUNCTIONS",
+			LogType::LOG_ERROR,
+			2);
+
+		return false;
+	}
+
+	return true;
+}
+
+namespace CircuitGame::Graphics
+{
+	bool GLFunctions::Initialize()
+	{
+		bool loaded = true;
+
+		loaded &= LoadFunction(glTexImage3D, "glTexImage3D");
+		loaded &= LoadFunction(glTexSubImage3D, "glTexSubImage3D");
+		loaded &= LoadFunction(glCompressedTexImage3D, "glCompressedTexImage3D");
+		loaded &= LoadFunction(glVertexAttribDivisor, "glVertexAttribDivisor");
+		loaded &= LoadFunction(glDrawArraysInstanced, "glDrawArraysInstanced");
+		loaded &= LoadFunction(glBufferSubData, "glBufferSubData");
+		loaded &= LoadFunction(glBlendFunc, "glBlendFunc");
+		loaded &= LoadFunction(glDepthMask, "glDepthMask");
+		loaded &= LoadFunction(glGetStringi, "glGetStringi");
+		loaded &= LoadFunction(glGenQueries, "glGenQueries");
+		loaded &= LoadFunction(glDeleteQueries, "glDeleteQueries");
+		loaded &= LoadFunction(glBeginQuery, "glBeginQuery");
+		loaded &= LoadFunction(glEndQuery, "glEndQuery");
+		loaded &= LoadFunction(glGetQueryObjectuiv, "glGetQueryObjectuiv");
+		loaded &= LoadFunction(glGetQueryObjectui64v, "glGetQueryObjectui64v");
+
+		return loaded;
+	}
+
+	bool GLFunctions::IsExtensionSupported(const char* extension)
+	{
+		if (glGetStringi == nullptr) return false;
+
+		GLint count{};
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+		for (GLint i = 0; i < count; ++i)
+		{
+			const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+			if (name != nullptr
+				&& strcmp(name, extension) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void GLFunctions::ReleaseCurrentContext(Window* window)
+	{
+#ifdef _WIN32
+		wglMakeCurrent(nullptr, nullptr);
+#elif __linux__
+		//glXMakeCurrent is not linked directly, same as the rest of the GL entry points
+		using GLXMakeCurrentFunc = int (*)(void* display, unsigned long drawable, void* context);
+		static GLXMakeCurrentFunc glXMakeCurrent{};
+		if (glXMakeCurrent == nullptr
+			&& !LoadFunction(glXMakeCurrent, "glXMakeCurrent"))
+		{
+			return;
+		}
+
+		glXMakeCurrent(
+			reinterpret_cast<void*>(window->GetWindowData().display),
+			0,
+			nullptr);
+#endif
+	}
+}
\ No newline at end of file
@@ -0,0 +1,224 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <string>
+
+//kalawindow
+#include "graphics/opengl/opengl_core.hpp"
+#include "core/log.hpp"
+
+#include "graphics/gputimer.hpp"
+#include "graphics/glfunctions.hpp"
+#include "core/framestats.hpp"
+#include "core/profiler.hpp"
+
+//kalawindow
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Graphics::GPUTimer;
+using CircuitGame::Graphics::GPUPass;
+using CircuitGame::Graphics::GPU_PASS_COUNT;
+using CircuitGame::Graphics::GetGPUPassName;
+using CircuitGame::Core::FrameStats;
+using CircuitGame::Core::FrameMetric;
+using CircuitGame::Core::Profiler;
+using CircuitGame::Core::ReadProfilerTimestamp;
+
+using std::to_string;
+
+//Frames in flight before a query is reused, the GPU is rarely more than two frames behind
+static constexpr u32 GPU_TIMER_LATENCY = 4;
+
+struct TimedFrame
+{
+	u64 frameIndex{};
+	u64 issueTimestamp{}; //profiler timestamp of the first pass, where the GPU track places this frame
+	GLuint queries[GPU_PASS_COUNT]{};
+	bool isUsed[GPU_PASS_COUNT]{};
+	bool isPending{};
+};
+
+static TimedFrame timedFrames[GPU_TIMER_LATENCY]{};
+static u32 currentFrame{};
+
+static bool isInitialized{};
+static bool isFrameOpen{};
+static bool isPassOpen{};
+
+static u32 gpuTrack{};
+
+static bool ReadFrame(TimedFrame& frame);
+static FrameMetric GetPassMetric(u32 pass);
+
+namespace CircuitGame::Graphics
+{
+	bool GPUTimer::Initialize()
+	{
+		if (isInitialized) return true;
+
+		for (auto& frame : timedFrames)
+		{
+			glGenQueries(GPU_PASS_COUNT, frame.queries);
+		}
+
+#ifdef CIRCUIT_PROFILER_ENABLED
+		gpuTrack = Profiler::CreateTrack("GPU");
+#endif
+
+		isInitialized = true;
+		return true;
+	}
+
+	void GPUTimer::BeginFrame(u64 frameIndex)
+	{
+		if (!isInitialized) return;
+
+		//oldest first, so reports arrive in frame order
+		currentFrame = (currentFrame + 1) % GPU_TIMER_LATENCY;
+		for (u32 i = 0; i < GPU_TIMER_LATENCY; ++i)
+		{
+			TimedFrame& frame = timedFrames[(currentFrame + i) % GPU_TIMER_LATENCY];
+			if (frame.isPending) ReadFrame(frame);
+		}
+
+		//the queries are about to be reused, a result that is still missing is lost
+		TimedFrame& frame = timedFrames[currentFrame];
+		if (frame.isPending) ++droppedFrameCount;
+
+		frame.frameIndex = frameIndex;
+		frame.issueTimestamp = 0;
+		frame.isPending = false;
+		for (auto& isUsed : frame.isUsed) isUsed = false;
+
+		isFrameOpen = true;
+	}
+
+	void GPUTimer::BeginPass(GPUPass pass)
+	{
+		if (!isFrameOpen) return;
+		if (isPassOpen) EndPass();
+
+		TimedFrame& frame = timedFrames[currentFrame];
+		u32 index = static_cast<u32>(pass);
+
+		//the same pass twice in one frame keeps the first measurement
+		if (frame.isUsed[index]) return;
+
+		if (frame.issueTimestamp == 0) frame.issueTimestamp = ReadProfilerTimestamp();
+
+		glBeginQuery(GL_TIME_ELAPSED, frame.queries[index]);
+		frame.isUsed[index] = true;
+		isPassOpen = true;
+	}
+
+	void GPUTimer::EndPass()
+	{
+		if (!isPassOpen) return;
+
+		glEndQuery(GL_TIME_ELAPSED);
+		isPassOpen = false;
+	}
+
+	void GPUTimer::EndFrame()
+	{
+		if (!isFrameOpen) return;
+
+		EndPass();
+		isFrameOpen = false;
+
+		TimedFrame& frame = timedFrames[currentFrame];
+		for (const auto& isUsed : frame.isUsed)
+		{
+			frame.isPending |= isUsed;
+		}
+	}
+
+	void GPUTimer::Shutdown()
+	{
+		if (!isInitialized) return;
+
+		for (auto& frame : timedFrames)
+		{
+			glDeleteQueries(GPU_PASS_COUNT, frame.queries);
+			frame = {};
+		}
+
+		if (droppedFrameCount > 0)
+		{
+			Logger::Print(
+				"Dropped GPU timings of " + to_string(droppedFrameCount) + " frames because the GPU was more than "
+				+ to_string(GPU_TIMER_LATENCY) + " frames behind.",
+				"GPU_TIMER",
+				LogType::LOG_DEBUG);
+		}
+
+		isInitialized = false;
+		isFrameOpen = false;
+		isPassOpen = false;
+	}
+}
+
+bool ReadFrame(TimedFrame& frame)
+{
+	for (u32 i = 0; i < GPU_PASS_COUNT; ++i)
+	{
+		if (!frame.isUsed[i]) continue;
+
+		GLuint isAvailable{};
+		glGetQueryObjectuiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+		if (isAvailable == 0) return false;
+	}
+
+#ifdef CIRCUIT_PROFILER_ENABLED
+	bool isCapturing = Profiler::IsCapturing();
+#else
+	bool isCapturing = false;
+#endif
+	u64 trackTimestamp = frame.issueTimestamp;
+	f32 frameTime = 0.0f;
+
+	for (u32 i = 0; i < GPU_PASS_COUNT; ++i)
+	{
+		if (!frame.isUsed[i]) continue;
+
+		GLuint64 nanoseconds{};
+		glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &nanoseconds);
+
+		f32 milliseconds = static_cast<f32>(static_cast<f64>(nanoseconds) / 1e6);
+		frameTime += milliseconds;
+
+		FrameStats::Report(
+			frame.frameIndex,
+			GetPassMetric(i),
+			milliseconds);
+
+		//passes run back to back, laid out from where the CPU issued them
+		//since GL_TIME_ELAPSED only knows durations
+		if (isCapturing)
+		{
+			u64 ticks = Profiler::NanosecondsToTicks(nanoseconds);
+			Profiler::RecordOnTrack(
+				gpuTrack,
+				GetGPUPassName(static_cast<GPUPass>(i)),
+				trackTimestamp,
+				trackTimestamp + ticks);
+			trackTimestamp += ticks;
+		}
+	}
+
+	FrameStats::Report(
+		frame.frameIndex,
+		FrameMetric::Metric_GPUFrame,
+		frameTime);
+
+	frame.isPending = false;
+	return true;
+}
+
+FrameMetric GetPassMetric(u32 pass)
+{
+	return static_cast<FrameMetric>(static_cast<u32>(FrameMetric::Metric_GPUClear) + pass);
+}
\ No newline at end of file
@@ -7,34 +7,46 @@
 #include <vector>
 #include <filesystem>
 #include <memory>
+#include <chrono>
+#include <span>
 
 //kalawindow
 #include "graphics/window.hpp"
 #include "graphics/texture.hpp"
 #include "graphics/opengl/opengl.hpp"
 #include "graphics/opengl/opengl_core.hpp"
-#include "graphics/opengl/shader_opengl.hpp"
 #include "core/log.hpp"
 #include "core/core.hpp"
 #include "core/containers.hpp"
 
 //glm
 #include "glm/gtc/matrix_transform.hpp"
-#include "glm/gtc/type_ptr.hpp"
 
 #include "graphics/render.hpp"
+#include "graphics/glfunctions.hpp"
+#include "graphics/blocktextures.hpp"
+#include "graphics/blockbatch.hpp"
+#include "graphics/waterbatch.hpp"
+#include "graphics/renderthread.hpp"
+#include "graphics/gputimer.hpp"
 #include "gameobjects/gameobject.hpp"
 #include "gameobjects/cube.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "gameobjects/transformsystem.hpp"
 #include "core/gamecore.hpp"
+#include "core/framestats.hpp"
+#include "core/profiler.hpp"
+#include "core/loglevel.hpp"
+#include "core/levelarena.hpp"
+#include "world/chunkstore.hpp"
+#include "world/broadphase.hpp"
+#include "world/watersystem.hpp"
 
 //kalawindow
 using KalaWindow::Graphics::Window;
 using KalaWindow::Graphics::Texture;
 using KalaWindow::Graphics::OpenGL::Renderer_OpenGL;
 using KalaWindow::Graphics::OpenGL::OpenGLCore;
-using KalaWindow::Graphics::OpenGL::Shader_OpenGL;
-using KalaWindow::Graphics::OpenGL::ShaderStage;
-using KalaWindow::Graphics::OpenGL::ShaderType;
 using KalaWindow::Graphics::OpenGL::Texture_OpenGL;
 using KalaWindow::Graphics::TextureType;
 using KalaWindow::Graphics::TextureFormat;
@@ -47,17 +59,37 @@ using KalaWindow::Core::createdOpenGLShaders;
 using KalaWindow::Core::runtimeOpenGLTextures;
 using KalaWindow::Core::runtimeOpenGLShaders;
 
-using CircuitGame::GameObjects::GameObject;
 using CircuitGame::GameObjects::GameObjectType;
 using CircuitGame::GameObjects::Cube;
-using CircuitGame::Core::createdCubes;
-using CircuitGame::Core::runtimeCubes;
+using CircuitGame::GameObjects::Entity;
+using CircuitGame::GameObjects::INVALID_ENTITY;
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::RenderComponent;
+using CircuitGame::GameObjects::TransformMatrices;
+using CircuitGame::GameObjects::TransformSystem;
+using CircuitGame::GameObjects::BlockType;
+using CircuitGame::GameObjects::GetBlockTypeName;
+using CircuitGame::GameObjects::BLOCK_TYPE_COUNT;
+using CircuitGame::Graphics::GLFunctions;
+using CircuitGame::Graphics::BlockTextures;
+using CircuitGame::Graphics::BlockBatch;
+using CircuitGame::Graphics::WaterBatch;
+using CircuitGame::Graphics::BlockInstance;
+using CircuitGame::Graphics::RenderThread;
+using CircuitGame::Graphics::RenderSnapshot;
+using CircuitGame::Graphics::GPUTimer;
+using CircuitGame::Graphics::GPUPass;
+using CircuitGame::Graphics::GPUPassScope;
 using CircuitGame::Core::mainWindow;
 using CircuitGame::Core::createdCamera;
+using CircuitGame::Core::FrameStats;
+using CircuitGame::Core::LevelArena;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::Broadphase;
+using CircuitGame::World::WaterSystem;
+using CircuitGame::World::WaterSurface;
 
-using glm::ortho;
 using glm::perspective;
-using glm::value_ptr;
 using glm::radians;
 using std::string;
 using std::vector;
@@ -65,33 +97,31 @@ using std::filesystem::path;
 using std::filesystem::current_path;
 using std::unique_ptr;
 using std::make_unique;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::span;
 
+//render thread only, the viewport size of the last drawn snapshot
 static vec2 lastSize{};
 
+
 static Texture_OpenGL* texturePtr{};
-static Shader_OpenGL* shaderPtr{};
 
 struct TextureData
 {
 	string textureName;
 	string texturePath;
 };
-struct ShaderData
-{
-	string shaderName;
-	string vertPath;
-	string fragPath;
-};
 struct GameObjectData
 {
 	string name;
 	GameObjectType type;
-	Texture_OpenGL* texture;
-	Shader_OpenGL* shader;
+	BlockType blockType;
+	vec3 pos;
+	bool isAnchored;
 };
 
 static bool InitializeTextures(const vector<TextureData>& textures);
-static bool InitializeShaders(const vector<ShaderData>& shaders);
 static bool CreateGameObjects(const vector<GameObjectData>& gameObjects);
 
 static void ResizeProjectionMatrix();
@@ -101,6 +131,8 @@ namespace CircuitGame::Graphics
 	bool Render::Initialize()
 	{
 		if (!Renderer_OpenGL::Initialize(mainWindow)) return false;
+		if (!GLFunctions::Initialize()) return false;
+		if (!GPUTimer::Initialize()) return false;
 
 #ifdef _DEBUG
 		glEnable(GL_DEBUG_OUTPUT);
@@ -122,26 +154,32 @@ namespace CircuitGame::Graphics
 		textures.push_back(textureData);
 		if (!InitializeTextures(textures)) return false;
 
-		vector<ShaderData> shaders{};
-		ShaderData shaderData =
+		if (!BlockTextures::Initialize()
+			|| !BlockBatch::Initialize()
+			|| !WaterBatch::Initialize())
 		{
-			.shaderName = "shader_cube",
-			.vertPath = path(current_path() / "files" / "shaders" / "basic.vert").string(),
-			.fragPath = path(current_path() / "files" / "shaders" / "basic.frag").string()
-		};
-		shaders.push_back(shaderData);
-		if (!InitializeShaders(shaders)) return false;
+			KalaWindowCore::ForceClose(
+				"Block error",
+				"Failed to create block textures, block batch or water batch!");
+		}
 
+		//one test block per block type, all drawn in the same batch
 		vector<GameObjectData> gameObjects{};
-
-		GameObjectData cubeData =
+		for (u32 i = 0; i < BLOCK_TYPE_COUNT; ++i)
 		{
-			.name = "cube_1",
-			.type = GameObjectType::cube,
-			.texture = texturePtr,
-			.shader = shaderPtr
-		};
-		gameObjects.push_back(cubeData);
+			BlockType blockType = static_cast<BlockType>(i);
+			f32 offset = static_cast<f32>(i) - static_cast<f32>(BLOCK_TYPE_COUNT - 1) * 0.5f;
+
+			GameObjectData cubeData =
+			{
+				.name = "cube_" + GetBlockTypeName(blockType),
+				.type = GameObjectType::cube,
+				.blockType = blockType,
+				.pos = vec3(offset * 1.5f, 0.0f, -5.0f),
+				.isAnchored = true //Nothing is under the test row, it would fall with the first cell cleared below it
+			};
+			gameObjects.push_back(cubeData);
+		}
 		CreateGameObjects(gameObjects);
 
 		if (Camera::CreateCamera(mainWindow) == nullptr)
@@ -151,6 +189,9 @@ namespace CircuitGame::Graphics
 				"Failed to create camera!");
 		}
 
+		//from here on the context belongs to the render thread
+		if (!RenderThread::Start()) return false;
+
 		return true;
 	}
 
@@ -161,57 +202,136 @@ namespace CircuitGame::Graphics
 
 	void Render::Redraw()
 	{
-		glClearColor(0.29f, 0.36f, 0.85f, 1.0f); //light blue
-		glClear(
-			GL_COLOR_BUFFER_BIT
-			| GL_DEPTH_BUFFER_BIT);
+		PROFILE_ZONE("Render::Redraw");
+
+		RenderSnapshot& snapshot = RenderThread::GetWriteSnapshot();
+
+		snapshot.frameIndex = FrameStats::GetFrameIndex();
+		snapshot.framebufferSize = mainWindow->GetSize();
 
-		mat4 projection{};
-		mat4 view{};
 		if (createdCamera != nullptr)
 		{
-			projection = perspective(
+			snapshot.projection = perspective(
 				radians(createdCamera->GetFOV()),
 				createdCamera->GetAspectRatio(),
 				createdCamera->GetNearClip(),
 				createdCamera->GetFarClip());
 
-			view = createdCamera->GetViewMatrix();
+			snapshot.view = createdCamera->GetViewMatrix();
+			snapshot.viewPos = createdCamera->GetPos();
 		}
 
-		if (runtimeCubes.size() > 0)
+		//clear keeps the capacity of the previous use of this slot
+		snapshot.blocks.clear();
+		snapshot.scaledBlocks.clear();
+		snapshot.water.clear();
+
+		//walks the packed render components, matrices are looked up through the transform sparse set,
+		//they were rebuilt by TransformSystem::Update earlier this frame
+		span<const Entity> entities = EntityStore::GetRenders().GetEntities();
+		span<const RenderComponent> renders = EntityStore::GetRenders().GetComponents();
+
+		for (size_t i = 0; i < renders.size(); ++i)
 		{
-			for (const auto& object : runtimeCubes)
+			if (!renders[i].isVisible) continue;
+
+			const TransformMatrices* transform = TransformSystem::GetMatrices(entities[i]);
+			if (transform == nullptr) continue;
+
+			if (transform->isRigid)
 			{
-				if (object == nullptr)
-				{
-					Logger::Print(
-						"Failed to render a cube because it was nullptr!",
-						"RENDER",
-						LogType::LOG_DEBUG);
-
-					continue;
-				}
-				object->Render(view, projection);
+				snapshot.blocks.push_back(BlockBatch::MakeInstance(
+					transform->world,
+					renders[i].blockType));
+			}
+			else
+			{
+				snapshot.scaledBlocks.push_back(BlockBatch::MakeScaledInstance(
+					transform->world,
+					transform->normal,
+					renders[i].blockType));
 			}
 		}
 
-		Renderer_OpenGL::SwapOpenGLBuffers(mainWindow);
+		//only chunks whose water changed since the last frame are listed again
+		for (const WaterSurface& surface : WaterSystem::GetSurfaces())
+		{
+			snapshot.water.push_back(WaterBatch::MakeInstance(surface.cell, surface.level));
+		}
+
+		RenderThread::PublishSnapshot();
 	}
 
-	void Render::Shutdown()
+	void Render::Draw(const RenderSnapshot& snapshot)
 	{
-		for (const auto& obj : runtimeCubes)
+		PROFILE_ZONE("Render::Draw");
+
+		if (lastSize != snapshot.framebufferSize)
 		{
-			obj->SetUpdate(false);
+			lastSize = snapshot.framebufferSize;
+			glViewport(
+				0,
+				0,
+				static_cast<GLsizei>(lastSize.x),
+				static_cast<GLsizei>(lastSize.y));
 		}
 
-		createdCubes.clear();
+		GPUTimer::BeginFrame(snapshot.frameIndex);
+
+		{
+			GPUPassScope pass(GPUPass::Pass_Clear);
+
+			glClearColor(0.29f, 0.36f, 0.85f, 1.0f); //light blue
+			glClear(
+				GL_COLOR_BUFFER_BIT
+				| GL_DEPTH_BUFFER_BIT);
+		}
+		{
+			GPUPassScope pass(GPUPass::Pass_Opaque);
+			BlockBatch::Draw(snapshot);
+		}
+		{
+			GPUPassScope pass(GPUPass::Pass_Transparent);
+			WaterBatch::Draw(snapshot);
+		}
+
+		//the swap is not part of any pass, it waits on vsync
+		GPUTimer::EndFrame();
+
+		Renderer_OpenGL::SwapOpenGLBuffers(mainWindow);
+	}
+
+	void Render::Shutdown()
+	{
+		//GL objects below are deleted on this thread, so the context has to come back first
+		RenderThread::Stop();
+
+		//entities are plain component data and their names live in the level arena,
+		//so unloading them is clearing the arrays and one reset
+		//instead of a destructor, GL delete and log line per cube
+		auto unloadStart = steady_clock::now();
+		u32 cubeCount = EntityStore::GetCount();
+
+		EntityStore::Clear();
+		ChunkStore::Clear();
+		WaterSystem::Clear();
+		Broadphase::Clear();
+		LevelArena::Reset();
+
+		duration<f64, std::micro> unloadTime = steady_clock::now() - unloadStart;
+		LOGF_DEBUG("RENDER", "Unloaded %u cubes in %.1fus.", cubeCount, unloadTime.count());
+
+		BlockBatch::Shutdown();
+		WaterBatch::Shutdown();
+		BlockTextures::Shutdown();
+		GPUTimer::Shutdown();
 	}
 }
 
 bool InitializeTextures(const vector<TextureData>& textures)
 {
+	PROFILE_ZONE("Render::InitializeTextures");
+
 	for (const auto& texture : textures)
 	{
 		string textureName = texture.textureName;
@@ -235,64 +355,24 @@ bool InitializeTextures(const vector<TextureData>& textures)
 	return true;
 }
 
-bool InitializeShaders(const vector<ShaderData>& shaders)
-{
-	for (const auto& shader : shaders)
-	{
-		string shaderName = shader.shaderName;
-
-		string vertPath = shader.vertPath;
-		string fragPath = shader.fragPath;
-		struct ShaderStage vertStage
-		{
-			.shaderType = ShaderType::Shader_Vertex,
-			.shaderPath = vertPath
-		};
-		struct ShaderStage fragStage
-		{
-			.shaderType = ShaderType::Shader_Fragment,
-			.shaderPath = fragPath
-		};
-
-		vector<ShaderStage> stages
-		{
-			vertStage,
-			fragStage
-		};
-
-		shaderPtr = Shader_OpenGL::CreateShader(
-			shaderName,
-			stages,
-			mainWindow);
-
-		if (shaderPtr == nullptr)
-		{
-			KalaWindowCore::ForceClose(
-				"Shader error",
-				"Failed to create cube shader!");
-		}
-	}
-
-	return true;
-}
-
 bool CreateGameObjects(const vector<GameObjectData>& gameObjects)
 {
 	for (const auto& obj : gameObjects)
 	{
-		Cube* cube = Cube::Initialize(
-			"cube_1",
-			vec3(0.0f, 0.0f, -5.0f));
-
-		if (cube == nullptr)
+		Entity cube = Cube::Initialize(
+			obj.name,
+			obj.pos,
+			vec3(0),
+			vec3(1),
+			obj.blockType,
+			obj.isAnchored);
+
+		if (cube == INVALID_ENTITY)
 		{
 			KalaWindowCore::ForceClose(
 				"GameObject error",
 				"Failed to create cube!");
 		}
-
-		cube->SetTexture(obj.texture);
-		cube->SetShader(obj.shader);
 	}
 
 	return true;
@@ -307,59 +387,4 @@ void ResizeProjectionMatrix()
 	{
 		createdCamera->SetAspectRatio(aspect);
 	}
-
-	if (shaderPtr != nullptr)
-	{
-		f32 orthoWidth = 1.0f;
-		f32 orthoHeight = 1.0f;
-
-		if (aspect >= 1.0f) orthoWidth = aspect;
-		else orthoHeight = 1.0f / aspect;
-
-		mat4 proj = ortho(
-			-orthoWidth, orthoWidth,
-			-orthoHeight, orthoHeight,
-			-1.0f, 1.0f);
-
-		mat4 model = mat4(1.0f);
-
-		GLuint program = shaderPtr->GetProgramID();
-		glUseProgram(program);
-
-		//upload projection
-
-		u32 projLoc = glGetUniformLocation(program, "uProjection");
-
-		//Logger::Print(
-		//	  "uProjection uniform location: " + to_string(projLoc),
-		//	  "Render",
-		//	  LogType::LOG_DEBUG);
-
-		if (projLoc >= 0)
-		{
-			glUniformMatrix4fv(
-				projLoc,
-				1,
-				GL_FALSE,
-				value_ptr(proj));
-		}
-
-		//upload model
-
-		u32 modelLoc = glGetUniformLocation(program, "uModel");
-
-		//Logger::Print(
-		//	  "uModel uniform location: " + to_string(modelLoc),
-		//	  "Render",
-		//	  LogType::LOG_DEBUG);
-
-		if (modelLoc >= 0)
-		{
-			glUniformMatrix4fv(
-				modelLoc,
-				1,
-				GL_FALSE,
-				value_ptr(model));
-		}
-	}
 }
\ No newline at end of file
@@ -0,0 +1,239 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <limits>
+
+//kalawindow
+#include "graphics/opengl/opengl.hpp"
+#include "core/log.hpp"
+
+#include "graphics/renderthread.hpp"
+#include "graphics/render.hpp"
+#include "graphics/glfunctions.hpp"
+#include "core/triplebuffer.hpp"
+#include "core/gamecore.hpp"
+#include "core/framestats.hpp"
+#include "core/profiler.hpp"
+#include "core/alloctracker.hpp"
+
+//kalawindow
+using KalaWindow::Graphics::OpenGL::Renderer_OpenGL;
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Graphics::RenderThread;
+using CircuitGame::Graphics::RenderSnapshot;
+using CircuitGame::Graphics::Render;
+using CircuitGame::Graphics::GLFunctions;
+using CircuitGame::Core::TripleBuffer;
+using CircuitGame::Core::mainWindow;
+using CircuitGame::Core::FrameStats;
+using CircuitGame::Core::FrameMetric;
+using CircuitGame::Core::AllocTag;
+
+using std::thread;
+using std::atomic;
+using std::mutex;
+using std::lock_guard;
+using std::vector;
+using std::function;
+using std::swap;
+using std::move;
+using std::this_thread::get_id;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using std::numeric_limits;
+
+static thread renderThread{};
+
+static TripleBuffer<RenderSnapshot> snapshots{};
+
+//bumped by the game thread whenever the render thread has something to do,
+//the render thread sleeps on it instead of spinning while nothing is published
+static atomic<u32> wakeSignal{};
+static atomic<bool> stopRequested{};
+
+//snapshots published by the game thread and the publish index of the last one presented,
+//the game thread sleeps on presentedCount in WaitForPresent
+static u64 publishedCount{};
+static atomic<u64> presentedCount{};
+
+static mutex commandMutex{};
+static vector<function<void()>> pendingCommands{};
+static vector<function<void()>> runningCommands{};
+
+static void RenderLoop();
+static void RunCommands();
+static void WakeRenderThread();
+
+namespace CircuitGame::Graphics
+{
+	bool RenderThread::Start()
+	{
+		if (isRunning)
+		{
+			Logger::Print(
+				"Cannot start render thread because it is already running!",
+				"RENDER_THREAD",
+				LogType::LOG_ERROR,
+				2);
+
+			return false;
+		}
+
+		stopRequested.store(false);
+		publishedCount = 0;
+		presentedCount.store(0);
+
+		//a context can only be current on one thread at a time
+		GLFunctions::ReleaseCurrentContext(mainWindow);
+
+		renderThread = thread(RenderLoop);
+		isRunning = true;
+
+		Logger::Print(
+			"Started render thread!",
+			"RENDER_THREAD",
+			LogType::LOG_SUCCESS);
+
+		return true;
+	}
+
+	RenderSnapshot& RenderThread::GetWriteSnapshot()
+	{
+		return snapshots.GetWriteBuffer();
+	}
+
+	void RenderThread::PublishSnapshot()
+	{
+		snapshots.GetWriteBuffer().publishIndex = ++publishedCount;
+		snapshots.Publish();
+		WakeRenderThread();
+	}
+
+	void RenderThread::WaitForPresent()
+	{
+		if (!isRunning) return;
+
+		PROFILE_ZONE("RenderThread::WaitForPresent");
+
+		u64 target = publishedCount > 0 ? publishedCount - 1 : 0;
+
+		u64 presented = presentedCount.load();
+		while (presented < target)
+		{
+			presentedCount.wait(presented);
+			presented = presentedCount.load();
+		}
+	}
+
+	void RenderThread::Enqueue(function<void()> command)
+	{
+		if (!isRunning)
+		{
+			command();
+			return;
+		}
+
+		{
+			lock_guard<mutex> lock(commandMutex);
+			pendingCommands.push_back(move(command));
+		}
+		WakeRenderThread();
+	}
+
+	void RenderThread::Stop()
+	{
+		if (!isRunning) return;
+		isRunning = false;
+
+		stopRequested.store(true);
+		WakeRenderThread();
+
+		//a crash on the render thread itself cannot join itself,
+		//the crash handler shuts the process down right after this anyway
+		if (get_id() == renderThread.get_id())
+		{
+			renderThread.detach();
+			return;
+		}
+
+		renderThread.join();
+
+		Renderer_OpenGL::MakeContextCurrent(mainWindow);
+
+		//commands queued after the last frame still expect to run
+		RunCommands();
+	}
+}
+
+void RenderLoop()
+{
+	PROFILE_THREAD_NAME("Render");
+	ALLOC_THREAD_TAG(AllocTag::Tag_Render);
+
+	Renderer_OpenGL::MakeContextCurrent(mainWindow);
+
+	u32 seenSignal = 0;
+	while (true)
+	{
+		wakeSignal.wait(seenSignal);
+		seenSignal = wakeSignal.load();
+
+		if (stopRequested.load()) break;
+
+		RunCommands();
+
+		//only the newest snapshot is drawn, frames the game thread
+		//published while the previous one was submitting are skipped
+		if (snapshots.Acquire())
+		{
+			const RenderSnapshot& snapshot = snapshots.GetReadBuffer();
+
+			auto submitStart = steady_clock::now();
+			Render::Draw(snapshot);
+			duration<f32, std::milli> submitTime = steady_clock::now() - submitStart;
+
+			FrameStats::Report(
+				snapshot.frameIndex,
+				FrameMetric::Metric_Submit,
+				submitTime.count());
+
+			//a skipped snapshot counts as presented, a newer one replaced it
+			presentedCount.store(snapshot.publishIndex);
+			presentedCount.notify_all();
+		}
+	}
+
+	//nothing is presented anymore, the game thread must not keep waiting for it
+	presentedCount.store(numeric_limits<u64>::max());
+	presentedCount.notify_all();
+
+	RunCommands();
+
+	GLFunctions::ReleaseCurrentContext(mainWindow);
+}
+
+void RunCommands()
+{
+	{
+		lock_guard<mutex> lock(commandMutex);
+		swap(pendingCommands, runningCommands);
+	}
+
+	for (auto& command : runningCommands) command();
+	runningCommands.clear();
+}
+
+void WakeRenderThread()
+{
+	wakeSignal.fetch_add(1);
+	wakeSignal.notify_one();
+}
\ No newline at end of file
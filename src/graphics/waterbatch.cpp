@@ -0,0 +1,261 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <string>
+#include <vector>
+#include <filesystem>
+
+//kalawindow
+#include "graphics/opengl/opengl_core.hpp"
+#include "graphics/opengl/shader_opengl.hpp"
+#include "core/log.hpp"
+
+#include "graphics/waterbatch.hpp"
+#include "graphics/rendersnapshot.hpp"
+#include "graphics/glfunctions.hpp"
+#include "core/gamecore.hpp"
+#include "core/profiler.hpp"
+#include "world/chunkstore.hpp"
+#include "world/watersystem.hpp"
+
+//kalawindow
+using KalaWindow::Graphics::OpenGL::Shader_OpenGL;
+using KalaWindow::Graphics::OpenGL::ShaderStage;
+using KalaWindow::Graphics::OpenGL::ShaderType;
+using KalaWindow::Core::Logger;
+using KalaWindow::Core::LogType;
+
+using CircuitGame::Graphics::WaterBatch;
+using CircuitGame::Graphics::WaterInstance;
+using CircuitGame::Graphics::RenderSnapshot;
+using CircuitGame::Core::mainWindow;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::CELL_SIZE;
+using CircuitGame::World::WATER_FULL;
+
+using std::string;
+using std::vector;
+using std::filesystem::path;
+using std::filesystem::current_path;
+
+static constexpr u32 QUAD_VERTEX_COUNT = 6;
+
+static u32 VAO{};
+static u32 meshVBO{};
+static u32 instanceVBO{};
+static size_t capacity{};
+static Shader_OpenGL* shader{};
+
+static Shader_OpenGL* CreateWaterShader();
+static void CreateQuadMesh();
+
+namespace CircuitGame::Graphics
+{
+	bool WaterBatch::Initialize()
+	{
+		PROFILE_ZONE("WaterBatch::Initialize");
+
+		shader = CreateWaterShader();
+		if (shader == nullptr)
+		{
+			Logger::Print(
+				"Failed to create water shader!",
+				"WATER_BATCH",
+				LogType::LOG_ERROR,
+				2);
+
+			return false;
+		}
+
+		CreateQuadMesh();
+
+		Logger::Print(
+			"Created water batch!",
+			"WATER_BATCH",
+			LogType::LOG_SUCCESS);
+
+		return true;
+	}
+
+	WaterInstance WaterBatch::MakeInstance(
+		const ivec3& cell,
+		u8 level)
+	{
+		WaterInstance instance{};
+		instance.cellMin = ChunkStore::CellToWorld(cell);
+		instance.height = static_cast<f32>(level) / static_cast<f32>(WATER_FULL) * CELL_SIZE;
+
+		return instance;
+	}
+
+	void WaterBatch::Draw(const RenderSnapshot& snapshot)
+	{
+		size_t instanceCount = snapshot.water.size();
+
+		if (instanceCount == 0
+			|| shader == nullptr
+			|| !shader->Bind())
+		{
+			return;
+		}
+
+		u32 programID = shader->GetProgramID();
+
+		shader->SetMat4(programID, "projection", snapshot.projection);
+		shader->SetMat4(programID, "view", snapshot.view);
+		shader->SetVec3(programID, "lightDirection", snapshot.dirLight.direction);
+		shader->SetVec3(programID, "lightColor", snapshot.dirLight.color);
+		shader->SetFloat(programID, "ambientStrength", snapshot.dirLight.ambientStrength);
+		shader->SetFloat(programID, "cellSize", CELL_SIZE);
+
+		//grow the instance buffer when needed, otherwise orphan and refill it
+
+		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+		if (instanceCount > capacity) capacity = instanceCount * 2;
+
+		glBufferData(
+			GL_ARRAY_BUFFER,
+			static_cast<GLsizeiptr>(capacity * sizeof(WaterInstance)),
+			nullptr,
+			GL_STREAM_DRAW);
+		glBufferSubData(
+			GL_ARRAY_BUFFER,
+			0,
+			static_cast<GLsizeiptr>(instanceCount * sizeof(WaterInstance)),
+			snapshot.water.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		//tested against the blocks but not written, surfaces are seen from above and below
+		glEnable(GL_DEPTH_TEST);
+		glDisable(GL_CULL_FACE);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glDepthMask(GL_FALSE);
+
+		glBindVertexArray(VAO);
+		glDrawArraysInstanced(
+			GL_TRIANGLES,
+			0,
+			QUAD_VERTEX_COUNT,
+			static_cast<GLsizei>(instanceCount));
+		glBindVertexArray(0);
+
+		//the depth clear of the next frame needs depth writes back on
+		glDepthMask(GL_TRUE);
+		glDisable(GL_BLEND);
+		glEnable(GL_CULL_FACE);
+	}
+
+	void WaterBatch::Shutdown()
+	{
+		if (VAO != 0)
+		{
+			glDeleteVertexArrays(1, &VAO);
+			VAO = 0;
+		}
+		if (meshVBO != 0)
+		{
+			glDeleteBuffers(1, &meshVBO);
+			meshVBO = 0;
+		}
+		if (instanceVBO != 0)
+		{
+			glDeleteBuffers(1, &instanceVBO);
+			instanceVBO = 0;
+		}
+
+		capacity = 0;
+		shader = nullptr;
+	}
+}
+
+Shader_OpenGL* CreateWaterShader()
+{
+	string vertPath = path(current_path() / "files" / "shaders" / "water.vert").string();
+	string fragPath = path(current_path() / "files" / "shaders" / "water.frag").string();
+
+	vector<ShaderStage> stages
+	{
+		ShaderStage
+		{
+			.shaderType = ShaderType::Shader_Vertex,
+			.shaderPath = vertPath,
+			.shaderID = 0
+		},
+		ShaderStage
+		{
+			.shaderType = ShaderType::Shader_Fragment,
+			.shaderPath = fragPath,
+			.shaderID = 0
+		}
+	};
+
+	return Shader_OpenGL::CreateShader(
+		"shader_water",
+		stages,
+		mainWindow);
+}
+
+void CreateQuadMesh()
+{
+	//unit square on the xz plane, scaled to one cell in water.vert
+	f32 vertices[] =
+	{
+		0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f,
+		1.0f, 0.0f, 1.0f,
+		1.0f, 0.0f, 1.0f,
+		1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.0f,
+	};
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &meshVBO);
+	glGenBuffers(1, &instanceVBO);
+
+	glBindVertexArray(VAO);
+
+	//per-vertex data
+
+	glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+	glBufferData(
+		GL_ARRAY_BUFFER,
+		sizeof(vertices),
+		vertices,
+		GL_STATIC_DRAW);
+
+	//position
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(f32), (void*)0);
+	glEnableVertexAttribArray(0);
+
+	//per-instance data
+
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+
+	//minimum corner of the cell
+	glVertexAttribPointer(
+		1,
+		3,
+		GL_FLOAT,
+		GL_FALSE,
+		sizeof(WaterInstance),
+		(void*)offsetof(WaterInstance, cellMin));
+	glEnableVertexAttribArray(1);
+	glVertexAttribDivisor(1, 1);
+
+	//surface height
+	glVertexAttribPointer(
+		2,
+		1,
+		GL_FLOAT,
+		GL_FALSE,
+		sizeof(WaterInstance),
+		(void*)offsetof(WaterInstance, height));
+	glEnableVertexAttribArray(2);
+	glVertexAttribDivisor(2, 1);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
\ No newline at end of file
@@ -7,9 +7,9 @@
 
 using CircuitGame::Core::Game;
 
-int main()
+int main(int argc, char* argv[])
 {
-	Game::Initialize();
+	Game::Initialize(argc, argv);
 
 	return 0;
 }
\ No newline at end of file
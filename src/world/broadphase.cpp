@@ -0,0 +1,425 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "world/broadphase.hpp"
+
+using CircuitGame::World::Broadphase;
+using CircuitGame::World::Proxy;
+using CircuitGame::World::ProxyTag;
+using CircuitGame::World::OverlapPair;
+using CircuitGame::Core::HandleSlots;
+
+using std::vector;
+using std::span;
+using std::lower_bound;
+using std::upper_bound;
+using std::sort;
+using std::unique;
+using std::merge;
+using std::back_inserter;
+using std::swap;
+
+struct ProxyData
+{
+	vec3 min{};
+	vec3 max{};
+	u32 userData{};
+	bool isSleeping{};
+	bool isInAwakeList{}; //Sleeping proxies leave the awake list at the end of the next update
+};
+
+//a copy of the box so the sweep reads one array front to back
+struct SweepEntry
+{
+	vec3 min{};
+	vec3 max{};
+	Proxy proxy{};
+};
+
+static HandleSlots<ProxyTag> proxySlots{};
+static vector<ProxyData> proxies{};
+
+static vector<SweepEntry> awakeEntries{};    //Sorted by min.x after each update
+static vector<SweepEntry> sleepingEntries{}; //Always sorted by min.x
+static f32 maxSleepingWidth{};               //Widest sleeping box along x, bounds the lookup
+
+static vector<OverlapPair> pairs{};
+static vector<OverlapPair> nextPairs{};
+static vector<OverlapPair> mergedPairs{}; //Merge target for nextPairs, swapped with it so neither allocates once warmed up
+static vector<OverlapPair> addedPairs{};
+static vector<OverlapPair> removedPairs{};
+
+static void InsertSleeping(Proxy proxy);
+static void EraseSleeping(Proxy proxy);
+static void SortAwakeEntries();
+static void AddPair(Proxy first, Proxy second);
+static u64 GetPairKey(const OverlapPair& pair);
+
+//overlap on y and z, x is known from the sort
+static bool OverlapsYZ(
+	const SweepEntry& first,
+	const SweepEntry& second);
+
+namespace CircuitGame::World
+{
+	Proxy Broadphase::Add(
+		const vec3& min,
+		const vec3& max,
+		u32 userData,
+		bool isSleeping)
+	{
+		Proxy proxy = proxySlots.Create();
+		if (!proxy.IsValid()) return proxy;
+
+		u32 index = proxy.GetIndex();
+		if (index >= proxies.size()) proxies.resize(index + 1);
+
+		proxies[index] = ProxyData
+		{
+			.min = min,
+			.max = max,
+			.userData = userData,
+			.isSleeping = isSleeping,
+			.isInAwakeList = true
+		};
+
+		//even a proxy added asleep is swept once to find the sleepers it starts out touching
+		awakeEntries.push_back(SweepEntry{ min, max, proxy });
+		if (isSleeping) InsertSleeping(proxy);
+
+		return proxy;
+	}
+
+	void Broadphase::Remove(Proxy proxy)
+	{
+		if (!IsAlive(proxy)) return;
+
+		//awake entries of stale proxies are dropped by the next update
+		if (proxies[proxy.GetIndex()].isSleeping) EraseSleeping(proxy);
+
+		proxySlots.Destroy(proxy);
+	}
+
+	void Broadphase::Move(
+		Proxy proxy,
+		const vec3& min,
+		const vec3& max)
+	{
+		if (!IsAlive(proxy)) return;
+
+		SetSleeping(proxy, false);
+
+		ProxyData& data = proxies[proxy.GetIndex()];
+		data.min = min;
+		data.max = max;
+	}
+
+	void Broadphase::SetSleeping(
+		Proxy proxy,
+		bool isSleeping)
+	{
+		if (!IsAlive(proxy)) return;
+
+		ProxyData& data = proxies[proxy.GetIndex()];
+		if (data.isSleeping == isSleeping) return;
+
+		data.isSleeping = isSleeping;
+
+		if (isSleeping) InsertSleeping(proxy);
+		else
+		{
+			EraseSleeping(proxy);
+
+			if (!data.isInAwakeList)
+			{
+				awakeEntries.push_back(SweepEntry{ data.min, data.max, proxy });
+				data.isInAwakeList = true;
+			}
+		}
+	}
+
+	bool Broadphase::IsSleeping(Proxy proxy)
+	{
+		return IsAlive(proxy)
+			&& proxies[proxy.GetIndex()].isSleeping;
+	}
+
+	bool Broadphase::IsAlive(Proxy proxy)
+	{
+		return proxySlots.IsAlive(proxy);
+	}
+
+	u32 Broadphase::GetUserData(Proxy proxy)
+	{
+		if (!IsAlive(proxy)) return 0;
+
+		return proxies[proxy.GetIndex()].userData;
+	}
+
+	void Broadphase::Update()
+	{
+		nextPairs.clear();
+		addedPairs.clear();
+		removedPairs.clear();
+
+		//latest boxes, removed proxies drop out here.
+		//Proxies put to sleep since the last update stay for this one sweep,
+		//their pairs may have changed between their last move and falling asleep.
+		u32 writeIndex = 0;
+		for (const SweepEntry& entry : awakeEntries)
+		{
+			if (!IsAlive(entry.proxy)) continue;
+
+			const ProxyData& data = proxies[entry.proxy.GetIndex()];
+			awakeEntries[writeIndex++] = SweepEntry{ data.min, data.max, entry.proxy };
+		}
+		awakeEntries.resize(writeIndex);
+
+		SortAwakeEntries();
+
+		u32 awakeEntryCount = static_cast<u32>(awakeEntries.size());
+		for (u32 i = 0; i < awakeEntryCount; i++)
+		{
+			const SweepEntry& entry = awakeEntries[i];
+
+			//awake against awake, only the boxes starting before this one ends
+			for (u32 j = i + 1; j < awakeEntryCount; j++)
+			{
+				const SweepEntry& other = awakeEntries[j];
+				if (other.min.x > entry.max.x) break;
+
+				if (OverlapsYZ(entry, other)) AddPair(entry.proxy, other.proxy);
+			}
+
+			//awake against sleeping, no sleeping box starting further left than this can reach it
+			auto sleeping = lower_bound(
+				sleepingEntries.begin(),
+				sleepingEntries.end(),
+				entry.min.x - maxSleepingWidth,
+				[](const SweepEntry& sleepingEntry, f32 x) { return sleepingEntry.min.x < x; });
+
+			for (; sleeping != sleepingEntries.end(); ++sleeping)
+			{
+				if (sleeping->min.x > entry.max.x) break;
+
+				if (sleeping->max.x >= entry.min.x
+					&& sleeping->proxy != entry.proxy
+					&& OverlapsYZ(entry, *sleeping))
+				{
+					AddPair(entry.proxy, sleeping->proxy);
+				}
+			}
+		}
+
+		//two sleepers that were not swept this time cannot have changed,
+		//they come from the sorted list of the last update and stay sorted
+		size_t sweptPairCount = nextPairs.size();
+		for (const OverlapPair& pair : pairs)
+		{
+			if (!IsAlive(pair.a)
+				|| !IsAlive(pair.b))
+			{
+				continue;
+			}
+
+			const ProxyData& first = proxies[pair.a.GetIndex()];
+			const ProxyData& second = proxies[pair.b.GetIndex()];
+			if (first.isSleeping
+				&& second.isSleeping
+				&& !first.isInAwakeList
+				&& !second.isInAwakeList)
+			{
+				nextPairs.push_back(pair);
+			}
+		}
+
+		//sleepers swept one last time leave the awake list
+		writeIndex = 0;
+		for (const SweepEntry& entry : awakeEntries)
+		{
+			ProxyData& data = proxies[entry.proxy.GetIndex()];
+			if (data.isSleeping)
+			{
+				data.isInAwakeList = false;
+				continue;
+			}
+
+			awakeEntries[writeIndex++] = entry;
+		}
+		awakeEntries.resize(writeIndex);
+
+		//only the swept pairs need sorting, a sleeper swept this time is found from both lists
+		auto isPairBefore = [](const OverlapPair& first, const OverlapPair& second) { return GetPairKey(first) < GetPairKey(second); };
+		sort(nextPairs.begin(), nextPairs.begin() + sweptPairCount, isPairBefore);
+
+		mergedPairs.clear();
+		merge(
+			nextPairs.begin(), nextPairs.begin() + sweptPairCount,
+			nextPairs.begin() + sweptPairCount, nextPairs.end(),
+			back_inserter(mergedPairs),
+			isPairBefore);
+		swap(nextPairs, mergedPairs);
+
+		nextPairs.erase(
+			unique(nextPairs.begin(), nextPairs.end(),
+				[](const OverlapPair& first, const OverlapPair& second) { return GetPairKey(first) == GetPairKey(second); }),
+			nextPairs.end());
+
+		//both lists are sorted, so one merge finds what changed
+		size_t oldIndex = 0;
+		size_t newIndex = 0;
+		while (oldIndex < pairs.size()
+			|| newIndex < nextPairs.size())
+		{
+			if (newIndex == nextPairs.size())
+			{
+				removedPairs.push_back(pairs[oldIndex++]);
+				continue;
+			}
+			if (oldIndex == pairs.size())
+			{
+				addedPairs.push_back(nextPairs[newIndex++]);
+				continue;
+			}
+
+			u64 oldKey = GetPairKey(pairs[oldIndex]);
+			u64 newKey = GetPairKey(nextPairs[newIndex]);
+
+			if (oldKey < newKey) removedPairs.push_back(pairs[oldIndex++]);
+			else if (newKey < oldKey) addedPairs.push_back(nextPairs[newIndex++]);
+			else
+			{
+				oldIndex++;
+				newIndex++;
+			}
+		}
+
+		pairs.swap(nextPairs);
+	}
+
+	span<const OverlapPair> Broadphase::GetPairs()
+	{
+		return pairs;
+	}
+
+	span<const OverlapPair> Broadphase::GetAddedPairs()
+	{
+		return addedPairs;
+	}
+
+	span<const OverlapPair> Broadphase::GetRemovedPairs()
+	{
+		return removedPairs;
+	}
+
+	u32 Broadphase::GetAwakeCount()
+	{
+		return proxySlots.GetAliveCount() - GetSleepingCount();
+	}
+
+	u32 Broadphase::GetSleepingCount()
+	{
+		return static_cast<u32>(sleepingEntries.size());
+	}
+
+	void Broadphase::Clear()
+	{
+		proxySlots.Clear();
+		proxies.clear();
+
+		awakeEntries.clear();
+		sleepingEntries.clear();
+		maxSleepingWidth = 0.0f;
+
+		pairs.clear();
+		nextPairs.clear();
+		mergedPairs.clear();
+		addedPairs.clear();
+		removedPairs.clear();
+	}
+}
+
+void InsertSleeping(Proxy proxy)
+{
+	const ProxyData& data = proxies[proxy.GetIndex()];
+
+	auto position = upper_bound(
+		sleepingEntries.begin(),
+		sleepingEntries.end(),
+		data.min.x,
+		[](f32 x, const SweepEntry& entry) { return x < entry.min.x; });
+
+	sleepingEntries.insert(position, SweepEntry{ data.min, data.max, proxy });
+	maxSleepingWidth = glm::max(maxSleepingWidth, data.max.x - data.min.x);
+}
+
+void EraseSleeping(Proxy proxy)
+{
+	//the box has not changed since it went to sleep, moving wakes it first
+	const ProxyData& data = proxies[proxy.GetIndex()];
+
+	auto it = lower_bound(
+		sleepingEntries.begin(),
+		sleepingEntries.end(),
+		data.min.x,
+		[](const SweepEntry& entry, f32 x) { return entry.min.x < x; });
+
+	for (; it != sleepingEntries.end(); ++it)
+	{
+		if (it->proxy == proxy)
+		{
+			sleepingEntries.erase(it);
+			break;
+		}
+	}
+
+	if (sleepingEntries.empty()) maxSleepingWidth = 0.0f;
+}
+
+void SortAwakeEntries()
+{
+	//boxes only move a little per step, so almost every entry is already in place
+	for (size_t i = 1; i < awakeEntries.size(); i++)
+	{
+		SweepEntry entry = awakeEntries[i];
+
+		size_t j = i;
+		while (j > 0
+			&& awakeEntries[j - 1].min.x > entry.min.x)
+		{
+			awakeEntries[j] = awakeEntries[j - 1];
+			j--;
+		}
+
+		awakeEntries[j] = entry;
+	}
+}
+
+void AddPair(Proxy first, Proxy second)
+{
+	if (second.value < first.value) nextPairs.push_back(OverlapPair{ second, first });
+	else nextPairs.push_back(OverlapPair{ first, second });
+}
+
+u64 GetPairKey(const OverlapPair& pair)
+{
+	return (static_cast<u64>(pair.a.value) << 32) | pair.b.value;
+}
+
+bool OverlapsYZ(
+	const SweepEntry& first,
+	const SweepEntry& second)
+{
+	//one combined test, each comparison alone is close to a coin flip for the branch predictor
+	return (first.min.y <= second.max.y)
+		& (second.min.y <= first.max.y)
+		& (first.min.z <= second.max.z)
+		& (second.min.z <= first.max.z);
+}
\ No newline at end of file
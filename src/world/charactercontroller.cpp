@@ -0,0 +1,212 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <cmath>
+
+#include "world/charactercontroller.hpp"
+#include "world/chunkstore.hpp"
+
+using CircuitGame::World::CharacterController;
+using CircuitGame::World::CharacterBody;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::CELL_SIZE;
+using CircuitGame::World::CELL_EMPTY;
+
+using std::floor;
+using std::ceil;
+using std::fabs;
+using glm::ivec3;
+
+static constexpr f32 GRAVITY = 20.0f;
+static constexpr f32 MAX_FALL_SPEED = 40.0f;
+
+//how far a face may be inside a cell before that cell counts as touched,
+//so a box resting exactly against a face is not blocked by the cell behind it
+static constexpr f32 CONTACT_TOLERANCE = 1e-4f;
+
+//how far below the feet the ground still counts as under them
+static constexpr f32 GROUND_PROBE = 0.02f;
+
+//true if any cell of one layer across the box is filled
+static bool IsLayerBlocked(
+	u32 axis,
+	i32 layer,
+	const ivec3& first,
+	const ivec3& last);
+
+//sweeps along x or z, and if a ledge of at most stepHeight stops the box, walks onto it
+static void MoveHorizontal(
+	vec3& boxMin,
+	vec3& boxMax,
+	u32 axis,
+	f32 distance,
+	f32 stepHeight);
+
+namespace CircuitGame::World
+{
+	void CharacterController::Step(
+		CharacterBody& body,
+		const vec3& moveVelocity,
+		bool wantsJump,
+		f32 deltaTime)
+	{
+		if (deltaTime <= 0.0f) return;
+
+		body.velocity.x = moveVelocity.x;
+		body.velocity.z = moveVelocity.z;
+
+		if (body.isFlying) body.velocity.y = moveVelocity.y;
+		else
+		{
+			if (wantsJump
+				&& body.isGrounded)
+			{
+				body.velocity.y = body.jumpSpeed;
+			}
+
+			body.velocity.y = glm::max(body.velocity.y - GRAVITY * deltaTime, -MAX_FALL_SPEED);
+		}
+
+		vec3 delta = body.velocity * deltaTime;
+		vec3 boxMin = body.pos - vec3(body.halfExtents.x, 0.0f, body.halfExtents.z);
+		vec3 boxMax = body.pos + vec3(body.halfExtents.x, body.halfExtents.y * 2.0f, body.halfExtents.z);
+
+		//vertical first, so a step up below starts from where the feet ended up
+		f32 movedY = SweepAxis(boxMin, boxMax, 1, delta.y);
+		boxMin.y += movedY;
+		boxMax.y += movedY;
+
+		bool landed = delta.y < 0.0f && movedY != delta.y;
+		if (movedY != delta.y) body.velocity.y = 0.0f;
+
+		f32 stepHeight = !body.isFlying && (body.isGrounded || landed)
+			? body.stepHeight
+			: 0.0f;
+
+		MoveHorizontal(boxMin, boxMax, 0, delta.x, stepHeight);
+		MoveHorizontal(boxMin, boxMax, 2, delta.z, stepHeight);
+
+		body.isGrounded = SweepAxis(boxMin, boxMax, 1, -GROUND_PROBE) > -GROUND_PROBE;
+		body.pos = vec3(
+			(boxMin.x + boxMax.x) * 0.5f,
+			boxMin.y,
+			(boxMin.z + boxMax.z) * 0.5f);
+	}
+
+	f32 CharacterController::SweepAxis(
+		const vec3& boxMin,
+		const vec3& boxMax,
+		u32 axis,
+		f32 distance)
+	{
+		if (distance == 0.0f) return 0.0f;
+
+		//cells the box covers across the sweep, faces it only touches are left out
+		ivec3 first{};
+		ivec3 last{};
+		for (u32 i = 0; i < 3; i++)
+		{
+			first[i] = static_cast<i32>(floor((boxMin[i] + CONTACT_TOLERANCE) / CELL_SIZE));
+			last[i] = static_cast<i32>(ceil((boxMax[i] - CONTACT_TOLERANCE) / CELL_SIZE)) - 1;
+		}
+
+		//layers of cells from the leading face to where it would end up, nearest first
+		if (distance > 0.0f)
+		{
+			i32 firstLayer = static_cast<i32>(ceil((boxMax[axis] - CONTACT_TOLERANCE) / CELL_SIZE));
+			i32 lastLayer = static_cast<i32>(ceil((boxMax[axis] + distance) / CELL_SIZE)) - 1;
+
+			for (i32 layer = firstLayer; layer <= lastLayer; layer++)
+			{
+				if (IsLayerBlocked(axis, layer, first, last))
+				{
+					return glm::max(static_cast<f32>(layer) * CELL_SIZE - boxMax[axis], 0.0f);
+				}
+			}
+		}
+		else
+		{
+			i32 firstLayer = static_cast<i32>(floor((boxMin[axis] + CONTACT_TOLERANCE) / CELL_SIZE)) - 1;
+			i32 lastLayer = static_cast<i32>(floor((boxMin[axis] + distance) / CELL_SIZE));
+
+			for (i32 layer = firstLayer; layer >= lastLayer; layer--)
+			{
+				if (IsLayerBlocked(axis, layer, first, last))
+				{
+					return glm::min(static_cast<f32>(layer + 1) * CELL_SIZE - boxMin[axis], 0.0f);
+				}
+			}
+		}
+
+		return distance;
+	}
+}
+
+bool IsLayerBlocked(
+	u32 axis,
+	i32 layer,
+	const ivec3& first,
+	const ivec3& last)
+{
+	u32 axisB = (axis + 1) % 3;
+	u32 axisC = (axis + 2) % 3;
+
+	ivec3 cell{};
+	cell[axis] = layer;
+
+	for (i32 b = first[axisB]; b <= last[axisB]; b++)
+	{
+		cell[axisB] = b;
+		for (i32 c = first[axisC]; c <= last[axisC]; c++)
+		{
+			cell[axisC] = c;
+			if (ChunkStore::GetCell(cell) != CELL_EMPTY) return true;
+		}
+	}
+
+	return false;
+}
+
+void MoveHorizontal(
+	vec3& boxMin,
+	vec3& boxMax,
+	u32 axis,
+	f32 distance,
+	f32 stepHeight)
+{
+	if (distance == 0.0f) return;
+
+	f32 moved = CharacterController::SweepAxis(boxMin, boxMax, axis, distance);
+
+	if (moved != distance
+		&& stepHeight > 0.0f)
+	{
+		//the same move from up to one step higher, then back down onto the ledge
+		vec3 stepMin = boxMin;
+		vec3 stepMax = boxMax;
+
+		f32 lift = CharacterController::SweepAxis(stepMin, stepMax, 1, stepHeight);
+		stepMin.y += lift;
+		stepMax.y += lift;
+
+		f32 stepMoved = CharacterController::SweepAxis(stepMin, stepMax, axis, distance);
+		if (fabs(stepMoved) > fabs(moved))
+		{
+			stepMin[axis] += stepMoved;
+			stepMax[axis] += stepMoved;
+
+			f32 drop = CharacterController::SweepAxis(stepMin, stepMax, 1, -lift);
+			stepMin.y += drop;
+			stepMax.y += drop;
+
+			boxMin = stepMin;
+			boxMax = stepMax;
+			return;
+		}
+	}
+
+	boxMin[axis] += moved;
+	boxMax[axis] += moved;
+}
\ No newline at end of file
@@ -0,0 +1,438 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "world/chunkstore.hpp"
+
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::Chunk;
+using CircuitGame::World::RaycastHit;
+using CircuitGame::World::CELL_SIZE;
+using CircuitGame::World::CELL_EMPTY;
+using CircuitGame::World::CHUNK_SIZE;
+using CircuitGame::World::CHUNK_SHIFT;
+using CircuitGame::World::CHUNK_MASK;
+using CircuitGame::World::GetCellIndex;
+
+using std::vector;
+using std::span;
+using std::unique_ptr;
+using std::unordered_map;
+using std::numeric_limits;
+using std::nothrow;
+using std::move;
+using glm::ivec3;
+
+//chunks are never freed one by one, so an index into this stays valid until Clear
+static vector<unique_ptr<Chunk>> chunks{};
+static unordered_map<u64, u32> chunkLookup{};
+static ivec3 minChunk{};
+static ivec3 maxChunk{};
+static vector<ivec3> emptiedCells{}; //Filled cells emptied since the last ClearEmptiedCells
+
+static constexpr f32 NO_CROSSING = numeric_limits<f32>::infinity();
+
+static u64 GetChunkKey(const ivec3& chunkCoord);
+static Chunk* FindChunk(const ivec3& chunkCoord);
+static Chunk* FindOrCreateChunk(const ivec3& chunkCoord);
+
+//axis whose next boundary crossing comes first
+static i32 GetFirstAxis(const vec3& tMax);
+
+//true once the ray is past the chunk bounds on an axis it does not step back along,
+//so no chunk can come after this one
+static bool IsLeavingBounds(
+	const ivec3& chunkCoord,
+	const ivec3& step);
+
+//cell by cell walk through one chunk between enterT and exitT, in cell units
+static bool TraverseChunk(
+	const Chunk& chunk,
+	const vec3& start,
+	const vec3& dir,
+	const ivec3& step,
+	f32 enterT,
+	f32 exitT,
+	const ivec3& enterNormal,
+	RaycastHit& outHit);
+
+namespace CircuitGame::World
+{
+	u8 ChunkStore::GetCell(const ivec3& cell)
+	{
+		const Chunk* chunk = FindChunk(CellToChunk(cell));
+		if (chunk == nullptr) return CELL_EMPTY;
+
+		return chunk->cells[GetCellIndex(
+			cell.x & CHUNK_MASK,
+			cell.y & CHUNK_MASK,
+			cell.z & CHUNK_MASK)];
+	}
+
+	bool ChunkStore::SetCell(
+		const ivec3& cell,
+		u8 value)
+	{
+		ivec3 chunkCoord = CellToChunk(cell);
+
+		//clearing a cell of a chunk that does not exist changes nothing
+		Chunk* chunk = value == CELL_EMPTY
+			? FindChunk(chunkCoord)
+			: FindOrCreateChunk(chunkCoord);
+
+		if (chunk == nullptr) return value == CELL_EMPTY;
+
+		u8& current = chunk->cells[GetCellIndex(
+			cell.x & CHUNK_MASK,
+			cell.y & CHUNK_MASK,
+			cell.z & CHUNK_MASK)];
+
+		if (current == CELL_EMPTY
+			&& value != CELL_EMPTY)
+		{
+			chunk->filledCount++;
+		}
+		else if (current != CELL_EMPTY
+			&& value == CELL_EMPTY)
+		{
+			chunk->filledCount--;
+			emptiedCells.push_back(cell);
+		}
+
+		current = value;
+		if (value != CELL_EMPTY)
+		{
+			chunk->water[GetCellIndex(
+				cell.x & CHUNK_MASK,
+				cell.y & CHUNK_MASK,
+				cell.z & CHUNK_MASK)] = 0;
+		}
+
+		return true;
+	}
+
+	bool ChunkStore::FillBox(
+		const vec3& min,
+		const vec3& max,
+		u8 value)
+	{
+		ivec3 first{};
+		ivec3 last{};
+		GetBoxCells(min, max, first, last);
+
+		for (i32 y = first.y; y <= last.y; y++)
+		{
+			for (i32 z = first.z; z <= last.z; z++)
+			{
+				for (i32 x = first.x; x <= last.x; x++)
+				{
+					if (!SetCell(ivec3(x, y, z), value)) return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void ChunkStore::GetBoxCells(
+		const vec3& min,
+		const vec3& max,
+		ivec3& outFirst,
+		ivec3& outLast)
+	{
+		//cells the box only touches on a face are left alone
+		outFirst = WorldToCell(min);
+		outLast = ivec3(glm::ceil(max / CELL_SIZE)) - 1;
+	}
+
+	const Chunk* ChunkStore::GetChunk(const ivec3& chunkCoord)
+	{
+		return FindChunk(chunkCoord);
+	}
+
+	Chunk* ChunkStore::CreateChunk(const ivec3& chunkCoord)
+	{
+		return FindOrCreateChunk(chunkCoord);
+	}
+
+	bool ChunkStore::GetChunkBounds(
+		ivec3& outMin,
+		ivec3& outMax)
+	{
+		if (chunks.empty()) return false;
+
+		outMin = minChunk;
+		outMax = maxChunk;
+
+		return true;
+	}
+
+	ivec3 ChunkStore::WorldToCell(const vec3& pos)
+	{
+		return ivec3(glm::floor(pos / CELL_SIZE));
+	}
+
+	vec3 ChunkStore::CellToWorld(const ivec3& cell)
+	{
+		return vec3(cell) * CELL_SIZE;
+	}
+
+	ivec3 ChunkStore::CellToChunk(const ivec3& cell)
+	{
+		//arithmetic shift rounds negative cells down into the right chunk
+		return ivec3(
+			cell.x >> CHUNK_SHIFT,
+			cell.y >> CHUNK_SHIFT,
+			cell.z >> CHUNK_SHIFT);
+	}
+
+	bool ChunkStore::Raycast(
+		const vec3& origin,
+		const vec3& direction,
+		f32 maxDistance,
+		RaycastHit& outHit)
+	{
+		f32 length = glm::length(direction);
+		if (length <= 0.0f
+			|| maxDistance <= 0.0f
+			|| chunks.empty())
+		{
+			return false;
+		}
+
+		//everything below is in cells, so boundaries sit on whole numbers
+		vec3 dir = direction / length;
+		vec3 start = origin / CELL_SIZE;
+		f32 maxT = maxDistance / CELL_SIZE;
+
+		//Amanatides-Woo over whole chunks first, missing and empty chunks
+		//are crossed in one step and only the others are walked cell by cell.
+		//Leaving the chunk bounds ends the walk, so an infinite maxDistance still stops.
+		ivec3 chunkCoord = CellToChunk(ivec3(glm::floor(start)));
+		ivec3 step{};
+		vec3 chunkMax{};
+		vec3 chunkDelta{};
+
+		for (i32 axis = 0; axis < 3; axis++)
+		{
+			if (dir[axis] > 0.0f)
+			{
+				step[axis] = 1;
+				chunkMax[axis] = (static_cast<f32>((chunkCoord[axis] + 1) * CHUNK_SIZE) - start[axis]) / dir[axis];
+				chunkDelta[axis] = CHUNK_SIZE / dir[axis];
+			}
+			else if (dir[axis] < 0.0f)
+			{
+				step[axis] = -1;
+				chunkMax[axis] = (static_cast<f32>(chunkCoord[axis] * CHUNK_SIZE) - start[axis]) / dir[axis];
+				chunkDelta[axis] = -CHUNK_SIZE / dir[axis];
+			}
+			else
+			{
+				chunkMax[axis] = NO_CROSSING;
+				chunkDelta[axis] = NO_CROSSING;
+			}
+		}
+
+		f32 enterT = 0.0f;
+		ivec3 enterNormal{};
+
+		while (enterT <= maxT
+			&& !IsLeavingBounds(chunkCoord, step))
+		{
+			i32 axis = GetFirstAxis(chunkMax);
+			f32 exitT = glm::min(chunkMax[axis], maxT);
+
+			const Chunk* chunk = FindChunk(chunkCoord);
+			if (chunk != nullptr
+				&& chunk->filledCount > 0
+				&& TraverseChunk(
+					*chunk,
+					start,
+					dir,
+					step,
+					enterT,
+					exitT,
+					enterNormal,
+					outHit))
+			{
+				outHit.distance *= CELL_SIZE;
+				return true;
+			}
+
+			enterT = chunkMax[axis];
+			chunkCoord[axis] += step[axis];
+			chunkMax[axis] += chunkDelta[axis];
+
+			enterNormal = ivec3(0);
+			enterNormal[axis] = -step[axis];
+		}
+
+		return false;
+	}
+
+	u32 ChunkStore::GetChunkCount()
+	{
+		return static_cast<u32>(chunks.size());
+	}
+
+	span<const ivec3> ChunkStore::GetEmptiedCells()
+	{
+		return emptiedCells;
+	}
+
+	void ChunkStore::ClearEmptiedCells()
+	{
+		emptiedCells.clear();
+	}
+
+	void ChunkStore::Clear()
+	{
+		chunks.clear();
+		chunkLookup.clear();
+		emptiedCells.clear();
+	}
+}
+
+u64 GetChunkKey(const ivec3& chunkCoord)
+{
+	//21 bits per axis is a million chunks in each direction
+	constexpr u64 mask = (1ull << 21) - 1;
+
+	return (static_cast<u64>(static_cast<u32>(chunkCoord.x)) & mask)
+		| ((static_cast<u64>(static_cast<u32>(chunkCoord.y)) & mask) << 21)
+		| ((static_cast<u64>(static_cast<u32>(chunkCoord.z)) & mask) << 42);
+}
+
+Chunk* FindChunk(const ivec3& chunkCoord)
+{
+	auto it = chunkLookup.find(GetChunkKey(chunkCoord));
+	if (it == chunkLookup.end()) return nullptr;
+
+	return chunks[it->second].get();
+}
+
+Chunk* FindOrCreateChunk(const ivec3& chunkCoord)
+{
+	if (Chunk* chunk = FindChunk(chunkCoord)) return chunk;
+
+	unique_ptr<Chunk> chunk(new (nothrow) Chunk{});
+	if (chunk == nullptr) return nullptr;
+
+	chunk->coord = chunkCoord;
+
+	minChunk = chunks.empty() ? chunkCoord : glm::min(minChunk, chunkCoord);
+	maxChunk = chunks.empty() ? chunkCoord : glm::max(maxChunk, chunkCoord);
+
+	Chunk* result = chunk.get();
+	chunkLookup.emplace(GetChunkKey(chunkCoord), static_cast<u32>(chunks.size()));
+	chunks.push_back(move(chunk));
+
+	return result;
+}
+
+i32 GetFirstAxis(const vec3& tMax)
+{
+	if (tMax.x < tMax.y) return tMax.x < tMax.z ? 0 : 2;
+	return tMax.y < tMax.z ? 1 : 2;
+}
+
+bool IsLeavingBounds(
+	const ivec3& chunkCoord,
+	const ivec3& step)
+{
+	for (i32 axis = 0; axis < 3; axis++)
+	{
+		if ((chunkCoord[axis] < minChunk[axis] && step[axis] <= 0)
+			|| (chunkCoord[axis] > maxChunk[axis] && step[axis] >= 0))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool TraverseChunk(
+	const Chunk& chunk,
+	const vec3& start,
+	const vec3& dir,
+	const ivec3& step,
+	f32 enterT,
+	f32 exitT,
+	const ivec3& enterNormal,
+	RaycastHit& outHit)
+{
+	ivec3 base = chunk.coord * CHUNK_SIZE;
+
+	//rounding can put the entry point a hair outside the chunk
+	ivec3 cell = glm::clamp(
+		ivec3(glm::floor(start + dir * enterT)),
+		base,
+		base + CHUNK_MASK);
+
+	vec3 tMax{};
+	vec3 tDelta{};
+
+	for (i32 axis = 0; axis < 3; axis++)
+	{
+		if (step[axis] > 0)
+		{
+			tMax[axis] = (static_cast<f32>(cell[axis] + 1) - start[axis]) / dir[axis];
+			tDelta[axis] = 1.0f / dir[axis];
+		}
+		else if (step[axis] < 0)
+		{
+			tMax[axis] = (static_cast<f32>(cell[axis]) - start[axis]) / dir[axis];
+			tDelta[axis] = -1.0f / dir[axis];
+		}
+		else
+		{
+			tMax[axis] = NO_CROSSING;
+			tDelta[axis] = NO_CROSSING;
+		}
+	}
+
+	f32 t = enterT;
+	ivec3 normal = enterNormal;
+
+	while (true)
+	{
+		ivec3 local = cell - base;
+		u8 value = chunk.cells[GetCellIndex(local.x, local.y, local.z)];
+
+		if (value != CELL_EMPTY)
+		{
+			outHit.cell = cell;
+			outHit.normal = normal;
+			outHit.distance = t;
+			outHit.cellValue = value;
+
+			return true;
+		}
+
+		i32 axis = GetFirstAxis(tMax);
+		if (tMax[axis] > exitT) return false;
+
+		t = glm::max(t, tMax[axis]);
+		cell[axis] += step[axis];
+		tMax[axis] += tDelta[axis];
+
+		if (cell[axis] < base[axis]
+			|| cell[axis] > base[axis] + CHUNK_MASK)
+		{
+			return false;
+		}
+
+		normal = ivec3(0);
+		normal[axis] = -step[axis];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,1165 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <algorithm>
+
+//glm
+#include "glm/gtc/quaternion.hpp"
+
+#include "world/debrissystem.hpp"
+#include "world/broadphase.hpp"
+#include "world/chunkstore.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "gameobjects/transformsystem.hpp"
+#include "core/jobsystem.hpp"
+#include "core/profiler.hpp"
+#include "core/framearena.hpp"
+
+using CircuitGame::World::DebrisSystem;
+using CircuitGame::World::Broadphase;
+using CircuitGame::World::Proxy;
+using CircuitGame::World::OverlapPair;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::CELL_SIZE;
+using CircuitGame::World::CELL_EMPTY;
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::Entity;
+using CircuitGame::GameObjects::DebrisComponent;
+using CircuitGame::GameObjects::TransformComponent;
+using CircuitGame::GameObjects::TransformSystem;
+using CircuitGame::Core::JobSystem;
+using CircuitGame::Core::FrameVector;
+
+using std::vector;
+using std::span;
+using std::numeric_limits;
+using std::lower_bound;
+using std::binary_search;
+using std::sort;
+using std::unique;
+using glm::quat;
+using glm::ivec3;
+
+static constexpr f32 GRAVITY = 9.81f;
+static constexpr u32 SOLVER_ITERATIONS = 8;
+static constexpr f32 FRICTION = 0.6f;
+static constexpr f32 LINEAR_DAMPING = 0.05f;
+static constexpr f32 ANGULAR_DAMPING = 0.1f;
+
+//share of the overlap pushed apart per step, overlap below the slop is left
+//so a resting box keeps touching what it rests on
+static constexpr f32 BAUMGARTE = 0.2f;
+static constexpr f32 PENETRATION_SLOP = 0.01f;
+
+//box points this far in front of the other box are kept as contacts that only stop
+//what would close the gap, so a rocking box does not lose its contacts every other step
+static constexpr f32 SPECULATIVE_DISTANCE = 0.02f;
+
+//a cached impulse further than this from a new contact of the same pair is dropped
+static constexpr f32 WARM_START_DISTANCE = 0.05f;
+
+//proxies are fattened so resting boxes keep their pairs
+static constexpr f32 PROXY_MARGIN = 0.05f;
+
+//an island sleeps once every body in it stayed slower than this for TIME_TO_SLEEP seconds
+static constexpr f32 SLEEP_LINEAR_SPEED = 0.05f;
+static constexpr f32 SLEEP_ANGULAR_SPEED = 0.05f;
+static constexpr f32 TIME_TO_SLEEP = 0.5f;
+
+//islands solved by one job, most islands are a single falling box
+static constexpr u32 ISLAND_GRAIN_SIZE = 8;
+
+static constexpr u32 NO_BODY = 0xFFFFFFFFu;
+static constexpr u32 BOX_CORNER_COUNT = 8;
+
+//a four sided face cut by four sides ends up with at most eight points
+static constexpr u32 MAX_CLIP_POINTS = 8;
+
+//one corner of a box inside a filled cell, or one point of a box face inside another box,
+//the normal points towards body a and the grid stands in for a missing body b
+struct Contact
+{
+	u32 bodyA{};
+	u32 bodyB = NO_BODY;
+	vec3 point{};
+	vec3 normal{};
+	f32 depth{}; //Negative while the point is still in front of the other box
+
+	//filled in by the solver
+	vec3 offsetA{};
+	vec3 offsetB{};
+	vec3 tangents[2]{};
+	f32 normalMass{};
+	f32 tangentMass[2]{};
+	f32 bias{};
+	f32 normalImpulse{};
+	f32 tangentImpulse[2]{};
+};
+
+//impulses a contact ended the step with, the contact of the same pair closest to it
+//starts the next step from them so a stack does not have to be rebuilt from nothing every step
+struct CachedImpulse
+{
+	u64 pairKey{};
+	vec3 localPoint{}; //In the space of body a
+	f32 normalImpulse{};
+	f32 tangentImpulse[2]{};
+};
+
+//bodies and contacts of one island sit next to each other in islandBodies and islandContacts
+struct Island
+{
+	u32 firstBody{};
+	u32 bodyCount{};
+	u32 firstContact{};
+	u32 contactCount{};
+	bool fellAsleep{};
+};
+
+//temporaries of one step, they live on the stack of Step and allocate from the frame arena
+struct StepData
+{
+	FrameVector<Contact> contacts{};
+	FrameVector<Contact> gridContacts{};     //BOX_CORNER_COUNT slots per body
+	FrameVector<u8> gridContactCounts{};
+	FrameVector<Contact> islandContacts{};
+	FrameVector<u32> islandBodies{};
+	FrameVector<Island> islands{};
+	FrameVector<u32> parents{};              //Union-find forest over body indices
+	FrameVector<ivec3> clearedCells{};       //Cells the chunk store emptied since the last step
+	FrameVector<u32> touchedSleepers{};      //Sleeping bodies that wake this step with what rests on them
+	FrameVector<u32> restingStarts{};        //Per body, where the sleepers resting on it start in resting
+	FrameVector<u32> resting{};
+	FrameVector<u32> restingPairs{};         //Lower then upper body of each sleeping pair found resting
+	FrameVector<u8> isWoken{};
+	FrameVector<u32> islandOfBody{};
+	FrameVector<mat3> inverseInertiaWorld{};
+};
+
+static StepData* step{};                       //Only set while Step runs
+static vector<CachedImpulse> cachedImpulses{}; //Sorted by pair key
+static vector<Entity> wokenEntities{};         //Asked to wake since the last step
+
+static u32 awakeCount{};
+static u32 islandCount{};
+static u32 contactCount{};
+
+//everything Step does, with the step data set up
+static void RunStep(f32 deltaTime);
+
+static vec3 GetWorldExtents(const DebrisComponent& body);
+static void GetCorners(
+	const DebrisComponent& body,
+	vec3 corners[BOX_CORNER_COUNT]);
+
+static void WakeBody(DebrisComponent& body);
+static u32 FindBody(
+	Proxy proxy,
+	span<DebrisComponent> bodies);
+
+//sleepers whose box covers a cleared cell
+static void FindSleepersOnCells(span<DebrisComponent> bodies);
+
+//sleepers an awake box really touches, the contacts found are thrown away
+static void FindTouchedSleepers(span<DebrisComponent> bodies);
+
+//wakes the touched sleepers and every sleeper resting on one of them, directly or through others,
+//returns how many woke
+static u32 WakeTouchedSleepers(span<DebrisComponent> bodies);
+
+static void CollideBoxes(
+	u32 bodyA,
+	u32 bodyB,
+	span<DebrisComponent> bodies);
+static u32 ClipToSide(
+	const vec3* points,
+	u32 count,
+	vec3* out,
+	const vec3& direction,
+	f32 offset);
+
+static u64 GetPairKey(
+	const Contact& contact,
+	span<const Entity> entities);
+static void WarmStart(
+	Contact& contact,
+	span<const DebrisComponent> bodies,
+	span<const Entity> entities);
+
+static u32 CollideGrid(
+	u32 bodyIndex,
+	const DebrisComponent& body,
+	Contact* out);
+
+static u32 FindRoot(u32 body);
+static void Union(u32 first, u32 second);
+static void BuildIslands(span<DebrisComponent> bodies);
+
+static void SolveIsland(
+	Island& island,
+	span<DebrisComponent> bodies,
+	f32 deltaTime);
+static void ApplyImpulse(
+	Contact& contact,
+	span<DebrisComponent> bodies,
+	const vec3& impulse);
+static vec3 GetRelativeVelocity(
+	const Contact& contact,
+	span<DebrisComponent> bodies);
+
+namespace CircuitGame::World
+{
+	DebrisComponent* DebrisSystem::Add(
+		Entity entity,
+		const vec3& velocity,
+		f32 density)
+	{
+		const TransformComponent* transform = EntityStore::GetTransforms().Get(entity);
+		if (transform == nullptr
+			|| transform->parent.IsValid())
+		{
+			return nullptr;
+		}
+
+		vec3 halfExtents = transform->scale * 0.5f;
+		f32 mass = density * 8.0f * halfExtents.x * halfExtents.y * halfExtents.z;
+
+		vec3 squared = halfExtents * halfExtents;
+		vec3 inertia = (mass / 3.0f) * vec3(
+			squared.y + squared.z,
+			squared.x + squared.z,
+			squared.x + squared.y);
+
+		DebrisComponent body
+		{
+			.orientation = quat(glm::radians(transform->rot)),
+			.pos = transform->pos,
+			.velocity = velocity,
+			.halfExtents = halfExtents,
+			.inverseMass = 1.0f / mass,
+			.inverseInertia = 1.0f / inertia
+		};
+
+		vec3 extents = GetWorldExtents(body) + PROXY_MARGIN;
+		body.proxy = Broadphase::Add(body.pos - extents, body.pos + extents, entity.value);
+		if (!body.proxy.IsValid()) return nullptr;
+
+		return &EntityStore::GetDebris().Add(entity, body);
+	}
+
+	void DebrisSystem::Remove(Entity entity)
+	{
+		const DebrisComponent* body = EntityStore::GetDebris().Get(entity);
+		if (body == nullptr) return;
+
+		Broadphase::Remove(body->proxy);
+	}
+
+	void DebrisSystem::Wake(Entity entity)
+	{
+		const DebrisComponent* body = EntityStore::GetDebris().Get(entity);
+		if (body == nullptr
+			|| !body->isSleeping)
+		{
+			return;
+		}
+
+		wokenEntities.push_back(entity);
+	}
+
+	void DebrisSystem::Step(f32 deltaTime)
+	{
+		PROFILE_ZONE("DebrisSystem::Step");
+
+		StepData data{};
+		step = &data;
+
+		//the chunk store only lists the cells, what rested on them is found here.
+		//Most levels empty cells long before anything turns into debris.
+		span<const ivec3> emptiedCells = ChunkStore::GetEmptiedCells();
+		if (EntityStore::GetDebris().GetSize() > 0)
+		{
+			data.clearedCells.assign(emptiedCells.begin(), emptiedCells.end());
+		}
+		ChunkStore::ClearEmptiedCells();
+
+		awakeCount = 0;
+		RunStep(deltaTime);
+
+		islandCount = static_cast<u32>(data.islands.size());
+		contactCount = static_cast<u32>(data.contacts.size());
+		step = nullptr;
+	}
+
+	u32 DebrisSystem::GetAwakeCount()
+	{
+		return awakeCount;
+	}
+
+	u32 DebrisSystem::GetIslandCount()
+	{
+		return islandCount;
+	}
+
+	u32 DebrisSystem::GetContactCount()
+	{
+		return contactCount;
+	}
+
+	void DebrisSystem::Clear()
+	{
+		cachedImpulses.clear();
+		wokenEntities.clear();
+		awakeCount = 0;
+		islandCount = 0;
+		contactCount = 0;
+	}
+}
+
+void RunStep(f32 deltaTime)
+{
+	span<DebrisComponent> bodies = EntityStore::GetDebris().GetComponents();
+	span<const Entity> entities = EntityStore::GetDebris().GetEntities();
+	u32 bodyCount = static_cast<u32>(bodies.size());
+
+	if (deltaTime <= 0.0f
+		|| bodyCount == 0)
+	{
+		wokenEntities.clear();
+		return;
+	}
+
+	for (Entity entity : wokenEntities)
+	{
+		const DebrisComponent* body = EntityStore::GetDebris().Get(entity);
+		if (body != nullptr
+			&& body->isSleeping)
+		{
+			step->touchedSleepers.push_back(static_cast<u32>(body - bodies.data()));
+		}
+	}
+	wokenEntities.clear();
+
+	if (!step->clearedCells.empty()) FindSleepersOnCells(bodies);
+
+	u32 movingCount = 0;
+	for (DebrisComponent& body : bodies)
+	{
+		if (body.isSleeping) continue;
+
+		vec3 extents = GetWorldExtents(body) + PROXY_MARGIN;
+		Broadphase::Move(body.proxy, body.pos - extents, body.pos + extents);
+		movingCount++;
+	}
+	Broadphase::Update();
+
+	//sleepers wake before any contact is built, so a woken island gets its pairs this step
+	if (movingCount > 0) FindTouchedSleepers(bodies);
+	if (!step->touchedSleepers.empty()) movingCount += WakeTouchedSleepers(bodies);
+
+	//only a moving body wakes a sleeper, so a settled collapse stops here
+	if (movingCount == 0) return;
+
+	//box against box, a sleeper left asleep was not touched by anything
+	for (const OverlapPair& pair : Broadphase::GetPairs())
+	{
+		if (Broadphase::IsSleeping(pair.a)
+			|| Broadphase::IsSleeping(pair.b))
+		{
+			continue;
+		}
+
+		u32 bodyA = FindBody(pair.a, bodies);
+		u32 bodyB = FindBody(pair.b, bodies);
+		if (bodyA == NO_BODY
+			|| bodyB == NO_BODY)
+		{
+			continue;
+		}
+
+		CollideBoxes(bodyA, bodyB, bodies);
+	}
+
+	//box against grid only reads the chunk store, so every body is its own job
+	step->gridContacts.resize(static_cast<size_t>(bodyCount) * BOX_CORNER_COUNT);
+	step->gridContactCounts.resize(bodyCount);
+
+	JobSystem::ParallelFor(
+		bodyCount,
+		64,
+		[bodies](u32 begin, u32 end)
+		{
+			for (u32 i = begin; i < end; i++)
+			{
+				step->gridContactCounts[i] = bodies[i].isSleeping
+					? 0
+					: static_cast<u8>(CollideGrid(i, bodies[i], &step->gridContacts[static_cast<size_t>(i) * BOX_CORNER_COUNT]));
+			}
+		},
+		"DebrisSystem::CollideGrid");
+
+	for (u32 i = 0; i < bodyCount; i++)
+	{
+		for (u32 k = 0; k < step->gridContactCounts[i]; k++)
+		{
+			step->contacts.push_back(step->gridContacts[static_cast<size_t>(i) * BOX_CORNER_COUNT + k]);
+		}
+	}
+
+	for (Contact& contact : step->contacts) WarmStart(contact, bodies, entities);
+
+	BuildIslands(bodies);
+
+	JobSystem::ParallelFor(
+		static_cast<u32>(step->islands.size()),
+		ISLAND_GRAIN_SIZE,
+		[bodies, deltaTime](u32 begin, u32 end)
+		{
+			for (u32 i = begin; i < end; i++) SolveIsland(step->islands[i], bodies, deltaTime);
+		},
+		"DebrisSystem::SolveIsland");
+
+	//contacts of islands that fell asleep start over once they wake
+	cachedImpulses.clear();
+	for (const Island& island : step->islands)
+	{
+		if (island.fellAsleep) continue;
+
+		for (u32 i = 0; i < island.contactCount; i++)
+		{
+			const Contact& contact = step->islandContacts[island.firstContact + i];
+			cachedImpulses.push_back(CachedImpulse
+			{
+				.pairKey = GetPairKey(contact, entities),
+				.localPoint = glm::conjugate(bodies[contact.bodyA].orientation) * contact.offsetA,
+				.normalImpulse = contact.normalImpulse,
+				.tangentImpulse = { contact.tangentImpulse[0], contact.tangentImpulse[1] }
+			});
+		}
+	}
+	sort(cachedImpulses.begin(), cachedImpulses.end(),
+		[](const CachedImpulse& first, const CachedImpulse& second) { return first.pairKey < second.pairKey; });
+
+	//the broadphase and transforms are game thread only
+	for (const Island& island : step->islands)
+	{
+		for (u32 i = 0; i < island.bodyCount; i++)
+		{
+			u32 bodyIndex = step->islandBodies[island.firstBody + i];
+			const DebrisComponent& body = bodies[bodyIndex];
+			Entity entity = entities[bodyIndex];
+
+			TransformSystem::SetPos(entity, body.pos);
+			TransformSystem::SetRot(entity, glm::degrees(glm::eulerAngles(body.orientation)));
+
+			if (island.fellAsleep) Broadphase::SetSleeping(body.proxy, true);
+			else awakeCount++;
+		}
+	}
+}
+
+vec3 GetWorldExtents(const DebrisComponent& body)
+{
+	mat3 rotation = glm::mat3_cast(body.orientation);
+
+	return vec3(
+		glm::abs(rotation[0]) * body.halfExtents.x
+		+ glm::abs(rotation[1]) * body.halfExtents.y
+		+ glm::abs(rotation[2]) * body.halfExtents.z);
+}
+
+void GetCorners(
+	const DebrisComponent& body,
+	vec3 corners[BOX_CORNER_COUNT])
+{
+	mat3 rotation = glm::mat3_cast(body.orientation);
+	vec3 axisX = rotation[0] * body.halfExtents.x;
+	vec3 axisY = rotation[1] * body.halfExtents.y;
+	vec3 axisZ = rotation[2] * body.halfExtents.z;
+
+	for (u32 i = 0; i < BOX_CORNER_COUNT; i++)
+	{
+		corners[i] = body.pos
+			+ ((i & 1) ? axisX : -axisX)
+			+ ((i & 2) ? axisY : -axisY)
+			+ ((i & 4) ? axisZ : -axisZ);
+	}
+}
+
+void WakeBody(DebrisComponent& body)
+{
+	body.isSleeping = false;
+	body.restTime = 0.0f;
+
+	Broadphase::SetSleeping(body.proxy, false);
+}
+
+u32 FindBody(
+	Proxy proxy,
+	span<DebrisComponent> bodies)
+{
+	//other systems share the broadphase, their proxies carry something else as user data
+	Entity entity{ Broadphase::GetUserData(proxy) };
+
+	const DebrisComponent* body = EntityStore::GetDebris().Get(entity);
+	if (body == nullptr
+		|| body->proxy != proxy)
+	{
+		return NO_BODY;
+	}
+
+	return static_cast<u32>(body - bodies.data());
+}
+
+void FindSleepersOnCells(span<DebrisComponent> bodies)
+{
+	auto isCellBefore = [](const ivec3& first, const ivec3& second)
+	{
+		if (first.x != second.x) return first.x < second.x;
+		if (first.y != second.y) return first.y < second.y;
+		return first.z < second.z;
+	};
+
+	FrameVector<ivec3>& cells = step->clearedCells;
+	sort(cells.begin(), cells.end(), isCellBefore);
+	cells.erase(unique(cells.begin(), cells.end()), cells.end());
+
+	ivec3 minCell = cells.front();
+	ivec3 maxCell = cells.front();
+	for (const ivec3& cell : cells)
+	{
+		minCell = glm::min(minCell, cell);
+		maxCell = glm::max(maxCell, cell);
+	}
+
+	for (u32 i = 0; i < static_cast<u32>(bodies.size()); i++)
+	{
+		const DebrisComponent& body = bodies[i];
+		if (!body.isSleeping) continue;
+
+		//the fattened box, a resting box only sinks into the cell below it by the slop
+		vec3 extents = GetWorldExtents(body) + PROXY_MARGIN;
+		ivec3 first{};
+		ivec3 last{};
+		ChunkStore::GetBoxCells(body.pos - extents, body.pos + extents, first, last);
+
+		first = glm::max(first, minCell);
+		last = glm::min(last, maxCell);
+
+		bool isTouched = false;
+		for (i32 y = first.y; y <= last.y && !isTouched; y++)
+		{
+			for (i32 z = first.z; z <= last.z && !isTouched; z++)
+			{
+				for (i32 x = first.x; x <= last.x && !isTouched; x++)
+				{
+					isTouched = binary_search(cells.begin(), cells.end(), ivec3(x, y, z), isCellBefore);
+				}
+			}
+		}
+
+		if (isTouched) step->touchedSleepers.push_back(i);
+	}
+}
+
+void FindTouchedSleepers(span<DebrisComponent> bodies)
+{
+	for (const OverlapPair& pair : Broadphase::GetPairs())
+	{
+		//most pairs of a settled pile are two sleepers, and two awake boxes wake nothing
+		if (Broadphase::IsSleeping(pair.a) == Broadphase::IsSleeping(pair.b)) continue;
+
+		u32 bodyA = FindBody(pair.a, bodies);
+		u32 bodyB = FindBody(pair.b, bodies);
+		if (bodyA == NO_BODY
+			|| bodyB == NO_BODY)
+		{
+			continue;
+		}
+
+		size_t firstContact = step->contacts.size();
+		CollideBoxes(bodyA, bodyB, bodies);
+		if (step->contacts.size() == firstContact) continue;
+
+		step->contacts.resize(firstContact);
+		step->touchedSleepers.push_back(bodies[bodyA].isSleeping ? bodyA : bodyB);
+	}
+}
+
+u32 WakeTouchedSleepers(span<DebrisComponent> bodies)
+{
+	u32 bodyCount = static_cast<u32>(bodies.size());
+
+	//what rests on what is not kept while a pile sleeps, sleeping pairs touching
+	//along a mostly upright normal give it again, lower body first
+	step->restingStarts.assign(bodyCount + 1, 0);
+	for (const OverlapPair& pair : Broadphase::GetPairs())
+	{
+		if (!Broadphase::IsSleeping(pair.a)
+			|| !Broadphase::IsSleeping(pair.b))
+		{
+			continue;
+		}
+
+		u32 bodyA = FindBody(pair.a, bodies);
+		u32 bodyB = FindBody(pair.b, bodies);
+		if (bodyA == NO_BODY
+			|| bodyB == NO_BODY)
+		{
+			continue;
+		}
+
+		size_t firstContact = step->contacts.size();
+		CollideBoxes(bodyA, bodyB, bodies);
+		if (step->contacts.size() == firstContact) continue;
+
+		//boxes lying side by side hold nothing up
+		bool isResting = glm::abs(step->contacts[firstContact].normal.y) > 0.5f;
+		step->contacts.resize(firstContact);
+		if (!isResting) continue;
+
+		u32 lower = bodies[bodyA].pos.y < bodies[bodyB].pos.y ? bodyA : bodyB;
+		u32 upper = lower == bodyA ? bodyB : bodyA;
+		step->restingPairs.push_back(lower);
+		step->restingPairs.push_back(upper);
+		step->restingStarts[lower + 1]++;
+	}
+
+	for (u32 i = 0; i < bodyCount; i++) step->restingStarts[i + 1] += step->restingStarts[i];
+
+	//parents is free until the islands are built, it is the fill cursor here
+	step->parents.assign(step->restingStarts.begin(), step->restingStarts.end() - 1);
+	step->resting.resize(step->restingPairs.size() / 2);
+	for (size_t i = 0; i < step->restingPairs.size(); i += 2)
+	{
+		step->resting[step->parents[step->restingPairs[i]]++] = step->restingPairs[i + 1];
+	}
+
+	//touchedSleepers doubles as the queue, everything pushed to it wakes
+	step->isWoken.assign(bodyCount, 0);
+	for (u32 body : step->touchedSleepers) step->isWoken[body] = 1;
+
+	for (size_t next = 0; next < step->touchedSleepers.size(); next++)
+	{
+		u32 body = step->touchedSleepers[next];
+		for (u32 i = step->restingStarts[body]; i < step->restingStarts[body + 1]; i++)
+		{
+			u32 upper = step->resting[i];
+			if (step->isWoken[upper]) continue;
+
+			step->isWoken[upper] = 1;
+			step->touchedSleepers.push_back(upper);
+		}
+	}
+
+	u32 wokenCount = 0;
+	for (u32 i = 0; i < bodyCount; i++)
+	{
+		if (!bodies[i].isSleeping
+			|| !step->isWoken[i])
+		{
+			continue;
+		}
+
+		WakeBody(bodies[i]);
+		wokenCount++;
+	}
+
+	return wokenCount;
+}
+
+void CollideBoxes(
+	u32 bodyA,
+	u32 bodyB,
+	span<DebrisComponent> bodies)
+{
+	const DebrisComponent& first = bodies[bodyA];
+	const DebrisComponent& second = bodies[bodyB];
+
+	mat3 rotations[2] = { glm::mat3_cast(first.orientation), glm::mat3_cast(second.orientation) };
+	vec3 offset = first.pos - second.pos;
+
+	//least overlap over the six face axes gives one normal for every contact of the pair,
+	//the nine edge axes are skipped, so crossing edges may report a contact that is not there
+	//and two boxes touching edge to edge get pushed apart along a face
+	f32 minOverlap = numeric_limits<f32>::max();
+	vec3 normal{};
+	f32 firstExtent{};
+	f32 secondExtent{};
+	u32 referenceBox{};
+
+	for (u32 box = 0; box < 2; box++)
+	{
+		for (u32 axis = 0; axis < 3; axis++)
+		{
+			vec3 direction = rotations[box][axis];
+
+			f32 extentA = glm::dot(glm::abs(glm::transpose(rotations[0]) * direction), first.halfExtents);
+			f32 extentB = glm::dot(glm::abs(glm::transpose(rotations[1]) * direction), second.halfExtents);
+			f32 distance = glm::dot(offset, direction);
+			f32 overlap = extentA + extentB - glm::abs(distance);
+
+			if (overlap <= 0.0f) return;
+			if (overlap < minOverlap)
+			{
+				minOverlap = overlap;
+				normal = distance < 0.0f ? -direction : direction;
+				firstExtent = extentA;
+				secondExtent = extentB;
+				referenceBox = box;
+			}
+		}
+	}
+
+	//the face of the reference box along the normal, and the face of the other box turned most against it
+	const DebrisComponent& reference = referenceBox == 0 ? first : second;
+	const DebrisComponent& incident = referenceBox == 0 ? second : first;
+	const mat3& referenceRotation = rotations[referenceBox];
+	const mat3& incidentRotation = rotations[1 - referenceBox];
+
+	vec3 faceNormal = referenceBox == 0 ? -normal : normal;
+
+	u32 incidentAxis = 0;
+	f32 maxAlignment = -1.0f;
+	for (u32 axis = 0; axis < 3; axis++)
+	{
+		f32 alignment = glm::abs(glm::dot(incidentRotation[axis], faceNormal));
+		if (alignment > maxAlignment)
+		{
+			maxAlignment = alignment;
+			incidentAxis = axis;
+		}
+	}
+
+	u32 axisB = (incidentAxis + 1) % 3;
+	u32 axisC = (incidentAxis + 2) % 3;
+	f32 side = glm::dot(incidentRotation[incidentAxis], faceNormal) > 0.0f ? -1.0f : 1.0f;
+
+	vec3 faceCenter = incident.pos + incidentRotation[incidentAxis] * (side * incident.halfExtents[incidentAxis]);
+	vec3 edgeB = incidentRotation[axisB] * incident.halfExtents[axisB];
+	vec3 edgeC = incidentRotation[axisC] * incident.halfExtents[axisC];
+
+	vec3 polygon[2][MAX_CLIP_POINTS]{};
+	polygon[0][0] = faceCenter - edgeB - edgeC;
+	polygon[0][1] = faceCenter + edgeB - edgeC;
+	polygon[0][2] = faceCenter + edgeB + edgeC;
+	polygon[0][3] = faceCenter - edgeB + edgeC;
+	u32 pointCount = 4;
+
+	//cut away what lies beyond the four sides of the reference face
+	u32 current = 0;
+	for (u32 axis = 0; axis < 3 && pointCount > 0; axis++)
+	{
+		vec3 direction = referenceRotation[axis];
+		if (glm::abs(glm::dot(direction, faceNormal)) > 0.5f) continue;
+
+		f32 center = glm::dot(reference.pos, direction);
+		f32 extent = reference.halfExtents[axis];
+
+		pointCount = ClipToSide(polygon[current], pointCount, polygon[1 - current], direction, center + extent);
+		current = 1 - current;
+		pointCount = ClipToSide(polygon[current], pointCount, polygon[1 - current], -direction, extent - center);
+		current = 1 - current;
+	}
+
+	f32 referenceExtent = referenceBox == 0 ? firstExtent : secondExtent;
+	f32 facePlane = glm::dot(reference.pos, faceNormal) + referenceExtent;
+
+	for (u32 i = 0; i < pointCount; i++)
+	{
+		const vec3& point = polygon[current][i];
+
+		f32 depth = facePlane - glm::dot(point, faceNormal);
+		if (depth <= -SPECULATIVE_DISTANCE) continue;
+
+		step->contacts.push_back(Contact
+		{
+			.bodyA = bodyA,
+			.bodyB = bodyB,
+			.point = point,
+			.normal = normal,
+			.depth = glm::min(depth, minOverlap)
+		});
+	}
+}
+
+u32 ClipToSide(
+	const vec3* points,
+	u32 count,
+	vec3* out,
+	const vec3& direction,
+	f32 offset)
+{
+	//one pass of Sutherland-Hodgman, keeps the part where dot(point, direction) <= offset
+	u32 outCount = 0;
+	for (u32 i = 0; i < count; i++)
+	{
+		const vec3& start = points[i];
+		const vec3& end = points[(i + 1) % count];
+
+		f32 startDistance = glm::dot(start, direction) - offset;
+		f32 endDistance = glm::dot(end, direction) - offset;
+
+		if (startDistance <= 0.0f) out[outCount++] = start;
+		if ((startDistance <= 0.0f) != (endDistance <= 0.0f))
+		{
+			f32 t = startDistance / (startDistance - endDistance);
+			out[outCount++] = start + (end - start) * t;
+		}
+	}
+
+	return outCount;
+}
+
+u64 GetPairKey(
+	const Contact& contact,
+	span<const Entity> entities)
+{
+	u32 second = contact.bodyB == NO_BODY
+		? NO_BODY
+		: entities[contact.bodyB].value;
+
+	return (static_cast<u64>(entities[contact.bodyA].value) << 32) | second;
+}
+
+void WarmStart(
+	Contact& contact,
+	span<const DebrisComponent> bodies,
+	span<const Entity> entities)
+{
+	//bodies are found by entity, their indices shift when one is removed
+	u64 pairKey = GetPairKey(contact, entities);
+	auto cached = lower_bound(
+		cachedImpulses.begin(),
+		cachedImpulses.end(),
+		pairKey,
+		[](const CachedImpulse& entry, u64 key) { return entry.pairKey < key; });
+
+	const DebrisComponent& bodyA = bodies[contact.bodyA];
+	vec3 localPoint = glm::conjugate(bodyA.orientation) * (contact.point - bodyA.pos);
+
+	const CachedImpulse* closest = nullptr;
+	f32 closestDistance = WARM_START_DISTANCE * WARM_START_DISTANCE;
+	for (; cached != cachedImpulses.end() && cached->pairKey == pairKey; ++cached)
+	{
+		vec3 difference = cached->localPoint - localPoint;
+		f32 distance = glm::dot(difference, difference);
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			closest = &*cached;
+		}
+	}
+
+	if (closest == nullptr) return;
+
+	contact.normalImpulse = closest->normalImpulse;
+	contact.tangentImpulse[0] = closest->tangentImpulse[0];
+	contact.tangentImpulse[1] = closest->tangentImpulse[1];
+}
+
+u32 CollideGrid(
+	u32 bodyIndex,
+	const DebrisComponent& body,
+	Contact* out)
+{
+	static constexpr ivec3 faceDirections[6] =
+	{
+		ivec3(0, 1, 0), ivec3(1, 0, 0), ivec3(-1, 0, 0),
+		ivec3(0, 0, 1), ivec3(0, 0, -1), ivec3(0, -1, 0)
+	};
+
+	vec3 corners[BOX_CORNER_COUNT]{};
+	GetCorners(body, corners);
+
+	u32 count = 0;
+	for (const vec3& point : corners)
+	{
+		ivec3 cell = ChunkStore::WorldToCell(point);
+		if (ChunkStore::GetCell(cell) == CELL_EMPTY) continue;
+
+		//out through the nearest face that is not covered by another filled cell,
+		//straight up if the corner is buried
+		vec3 cellMin = ChunkStore::CellToWorld(cell);
+		vec3 normal(0.0f, 1.0f, 0.0f);
+		f32 depth = cellMin.y + CELL_SIZE - point.y;
+		f32 bestDepth = numeric_limits<f32>::max();
+
+		for (const ivec3& direction : faceDirections)
+		{
+			if (ChunkStore::GetCell(cell + direction) != CELL_EMPTY) continue;
+
+			u32 axis = direction.x != 0 ? 0 : (direction.y != 0 ? 1 : 2);
+			f32 faceDepth = direction[axis] > 0
+				? cellMin[axis] + CELL_SIZE - point[axis]
+				: point[axis] - cellMin[axis];
+
+			if (faceDepth < bestDepth)
+			{
+				bestDepth = faceDepth;
+				depth = faceDepth;
+				normal = vec3(direction);
+			}
+		}
+
+		out[count++] = Contact
+		{
+			.bodyA = bodyIndex,
+			.point = point,
+			.normal = normal,
+			.depth = depth
+		};
+	}
+
+	return count;
+}
+
+u32 FindRoot(u32 body)
+{
+	while (step->parents[body] != body)
+	{
+		step->parents[body] = step->parents[step->parents[body]];
+		body = step->parents[body];
+	}
+
+	return body;
+}
+
+void Union(u32 first, u32 second)
+{
+	u32 firstRoot = FindRoot(first);
+	u32 secondRoot = FindRoot(second);
+
+	if (firstRoot != secondRoot) step->parents[secondRoot] = firstRoot;
+}
+
+void BuildIslands(span<DebrisComponent> bodies)
+{
+	u32 bodyCount = static_cast<u32>(bodies.size());
+
+	step->parents.resize(bodyCount);
+	for (u32 i = 0; i < bodyCount; i++) step->parents[i] = i;
+
+	//the grid never moves, only contacts between two boxes join islands
+	for (const Contact& contact : step->contacts)
+	{
+		if (contact.bodyB != NO_BODY) Union(contact.bodyA, contact.bodyB);
+	}
+
+	//island per root, counted first so bodies and contacts can be placed with one pass each
+	step->islandOfBody.assign(bodyCount, NO_BODY);
+	for (u32 i = 0; i < bodyCount; i++)
+	{
+		if (bodies[i].isSleeping) continue;
+
+		u32 root = FindRoot(i);
+		if (step->islandOfBody[root] == NO_BODY)
+		{
+			step->islandOfBody[root] = static_cast<u32>(step->islands.size());
+			step->islands.push_back(Island{});
+		}
+
+		step->islandOfBody[i] = step->islandOfBody[root];
+		step->islands[step->islandOfBody[i]].bodyCount++;
+	}
+
+	for (const Contact& contact : step->contacts) step->islands[step->islandOfBody[contact.bodyA]].contactCount++;
+
+	u32 bodyOffset = 0;
+	u32 contactOffset = 0;
+	for (Island& island : step->islands)
+	{
+		island.firstBody = bodyOffset;
+		island.firstContact = contactOffset;
+		bodyOffset += island.bodyCount;
+		contactOffset += island.contactCount;
+
+		island.bodyCount = 0;
+		island.contactCount = 0;
+	}
+
+	step->islandBodies.resize(bodyOffset);
+	step->islandContacts.resize(contactOffset);
+
+	for (u32 i = 0; i < bodyCount; i++)
+	{
+		if (step->islandOfBody[i] == NO_BODY) continue;
+
+		Island& island = step->islands[step->islandOfBody[i]];
+		step->islandBodies[island.firstBody + island.bodyCount++] = i;
+	}
+	for (const Contact& contact : step->contacts)
+	{
+		Island& island = step->islands[step->islandOfBody[contact.bodyA]];
+		step->islandContacts[island.firstContact + island.contactCount++] = contact;
+	}
+
+	step->inverseInertiaWorld.resize(bodyCount);
+}
+
+void SolveIsland(
+	Island& island,
+	span<DebrisComponent> bodies,
+	f32 deltaTime)
+{
+	span<const u32> bodyIndices(&step->islandBodies[island.firstBody], island.bodyCount);
+	span<Contact> solverContacts(step->islandContacts.data() + island.firstContact, island.contactCount);
+
+	f32 linearDamping = 1.0f / (1.0f + deltaTime * LINEAR_DAMPING);
+	f32 angularDamping = 1.0f / (1.0f + deltaTime * ANGULAR_DAMPING);
+
+	for (u32 index : bodyIndices)
+	{
+		DebrisComponent& body = bodies[index];
+
+		body.velocity.y -= GRAVITY * deltaTime;
+		body.velocity *= linearDamping;
+		body.angularVelocity *= angularDamping;
+
+		mat3 rotation = glm::mat3_cast(body.orientation);
+		mat3 inverseInertia(0.0f);
+		inverseInertia[0][0] = body.inverseInertia.x;
+		inverseInertia[1][1] = body.inverseInertia.y;
+		inverseInertia[2][2] = body.inverseInertia.z;
+
+		step->inverseInertiaWorld[index] = rotation * inverseInertia * glm::transpose(rotation);
+	}
+
+	//effective masses along the normal and two tangents
+	auto getMass = [bodies](const Contact& contact, const vec3& direction)
+	{
+		const DebrisComponent& bodyA = bodies[contact.bodyA];
+
+		vec3 angularA = glm::cross(step->inverseInertiaWorld[contact.bodyA] * glm::cross(contact.offsetA, direction), contact.offsetA);
+		f32 mass = bodyA.inverseMass + glm::dot(angularA, direction);
+
+		if (contact.bodyB != NO_BODY)
+		{
+			const DebrisComponent& bodyB = bodies[contact.bodyB];
+
+			vec3 angularB = glm::cross(step->inverseInertiaWorld[contact.bodyB] * glm::cross(contact.offsetB, direction), contact.offsetB);
+			mass += bodyB.inverseMass + glm::dot(angularB, direction);
+		}
+
+		return mass > 0.0f ? 1.0f / mass : 0.0f;
+	};
+
+	for (Contact& contact : solverContacts)
+	{
+		contact.offsetA = contact.point - bodies[contact.bodyA].pos;
+		if (contact.bodyB != NO_BODY) contact.offsetB = contact.point - bodies[contact.bodyB].pos;
+
+		//any direction perpendicular to the normal works for friction
+		vec3 reference = glm::abs(contact.normal.x) < 0.57f
+			? vec3(1.0f, 0.0f, 0.0f)
+			: vec3(0.0f, 1.0f, 0.0f);
+		contact.tangents[0] = glm::normalize(glm::cross(contact.normal, reference));
+		contact.tangents[1] = glm::cross(contact.normal, contact.tangents[0]);
+
+		contact.normalMass = getMass(contact, contact.normal);
+		contact.tangentMass[0] = getMass(contact, contact.tangents[0]);
+		contact.tangentMass[1] = getMass(contact, contact.tangents[1]);
+		contact.bias = contact.depth < 0.0f
+			? contact.depth / deltaTime
+			: BAUMGARTE / deltaTime * glm::max(contact.depth - PENETRATION_SLOP, 0.0f);
+
+		ApplyImpulse(contact, bodies,
+			contact.normal * contact.normalImpulse
+			+ contact.tangents[0] * contact.tangentImpulse[0]
+			+ contact.tangents[1] * contact.tangentImpulse[1]);
+	}
+
+	for (u32 iteration = 0; iteration < SOLVER_ITERATIONS; iteration++)
+	{
+		for (Contact& contact : solverContacts)
+		{
+			//push apart, the accumulated impulse never pulls
+			f32 normalSpeed = glm::dot(GetRelativeVelocity(contact, bodies), contact.normal);
+			f32 impulse = contact.normalMass * (contact.bias - normalSpeed);
+			f32 accumulated = glm::max(contact.normalImpulse + impulse, 0.0f);
+			impulse = accumulated - contact.normalImpulse;
+			contact.normalImpulse = accumulated;
+
+			ApplyImpulse(contact, bodies, contact.normal * impulse);
+
+			//friction up to what the normal impulse allows
+			f32 maxFriction = FRICTION * contact.normalImpulse;
+			for (u32 i = 0; i < 2; i++)
+			{
+				f32 tangentSpeed = glm::dot(GetRelativeVelocity(contact, bodies), contact.tangents[i]);
+				f32 tangentImpulse = -contact.tangentMass[i] * tangentSpeed;
+				f32 tangentAccumulated = glm::clamp(contact.tangentImpulse[i] + tangentImpulse, -maxFriction, maxFriction);
+				tangentImpulse = tangentAccumulated - contact.tangentImpulse[i];
+				contact.tangentImpulse[i] = tangentAccumulated;
+
+				ApplyImpulse(contact, bodies, contact.tangents[i] * tangentImpulse);
+			}
+		}
+	}
+
+	f32 minRestTime = numeric_limits<f32>::max();
+	for (u32 index : bodyIndices)
+	{
+		DebrisComponent& body = bodies[index];
+
+		body.pos += body.velocity * deltaTime;
+
+		quat spin(0.0f, body.angularVelocity.x, body.angularVelocity.y, body.angularVelocity.z);
+		body.orientation = glm::normalize(body.orientation + (0.5f * deltaTime) * (spin * body.orientation));
+
+		bool isResting = glm::dot(body.velocity, body.velocity) < SLEEP_LINEAR_SPEED * SLEEP_LINEAR_SPEED
+			&& glm::dot(body.angularVelocity, body.angularVelocity) < SLEEP_ANGULAR_SPEED * SLEEP_ANGULAR_SPEED;
+
+		body.restTime = isResting ? body.restTime + deltaTime : 0.0f;
+		minRestTime = glm::min(minRestTime, body.restTime);
+	}
+
+	//one body still moving keeps the whole island awake
+	if (minRestTime < TIME_TO_SLEEP) return;
+
+	for (u32 index : bodyIndices)
+	{
+		DebrisComponent& body = bodies[index];
+		body.velocity = vec3(0.0f);
+		body.angularVelocity = vec3(0.0f);
+		body.isSleeping = true;
+	}
+	island.fellAsleep = true;
+}
+
+void ApplyImpulse(
+	Contact& contact,
+	span<DebrisComponent> bodies,
+	const vec3& impulse)
+{
+	DebrisComponent& bodyA = bodies[contact.bodyA];
+	bodyA.velocity += impulse * bodyA.inverseMass;
+	bodyA.angularVelocity += step->inverseInertiaWorld[contact.bodyA] * glm::cross(contact.offsetA, impulse);
+
+	if (contact.bodyB == NO_BODY) return;
+
+	DebrisComponent& bodyB = bodies[contact.bodyB];
+	bodyB.velocity -= impulse * bodyB.inverseMass;
+	bodyB.angularVelocity -= step->inverseInertiaWorld[contact.bodyB] * glm::cross(contact.offsetB, impulse);
+}
+
+vec3 GetRelativeVelocity(
+	const Contact& contact,
+	span<DebrisComponent> bodies)
+{
+	const DebrisComponent& bodyA = bodies[contact.bodyA];
+	vec3 velocity = bodyA.velocity + glm::cross(bodyA.angularVelocity, contact.offsetA);
+
+	if (contact.bodyB != NO_BODY)
+	{
+		const DebrisComponent& bodyB = bodies[contact.bodyB];
+		velocity -= bodyB.velocity + glm::cross(bodyB.angularVelocity, contact.offsetB);
+	}
+
+	return velocity;
+}
\ No newline at end of file
@@ -0,0 +1,245 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <unordered_map>
+
+#include "world/supportsystem.hpp"
+#include "world/chunkstore.hpp"
+#include "world/watersystem.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "core/profiler.hpp"
+
+using CircuitGame::World::SupportSystem;
+using CircuitGame::World::CollapsedBlock;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::WaterSystem;
+using CircuitGame::World::CELL_EMPTY;
+using CircuitGame::World::CELL_SOLID;
+using CircuitGame::World::IsBlockCell;
+using CircuitGame::World::GetCellBlockType;
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::Entity;
+using CircuitGame::GameObjects::INVALID_ENTITY;
+using CircuitGame::GameObjects::SupportComponent;
+using CircuitGame::GameObjects::BlockType;
+
+using std::vector;
+using std::span;
+using std::unordered_map;
+using glm::ivec3;
+
+static unordered_map<u64, Entity> cellOwners{}; //Every cell of a registered block
+static vector<ivec3> pendingCells{};            //Emptied cells, the block above each one is checked
+static vector<Entity> brokenBlocks{};           //Blocks with a cleared cell, removed on the next Resolve
+static vector<CollapsedBlock> collapsedBlocks{};
+static u32 checkedCellCount{};
+
+static u64 GetCellKey(const ivec3& cell);
+static Entity FindOwner(const ivec3& cell);
+
+//any cell under the bottom of the block holds it up
+static bool IsSupported(const SupportComponent& support);
+
+//empties the cells of the block and queues the cells of its top layer,
+//whatever stands on the block rests on those
+static void EmptyBlock(const SupportComponent& support);
+
+static void Collapse(Entity entity);
+
+namespace CircuitGame::World
+{
+	SupportComponent* SupportSystem::Add(
+		Entity entity,
+		const vec3& min,
+		const vec3& max,
+		bool isAnchored)
+	{
+		SupportComponent support{ .isAnchored = isAnchored };
+		ChunkStore::GetBoxCells(min, max, support.minCell, support.maxCell);
+
+		u8 cellValue = ChunkStore::GetCell(support.minCell);
+		if (!IsBlockCell(cellValue)) return nullptr;
+
+		support.canRestOnWire = GetCellBlockType(cellValue) == BlockType::LayerSocket;
+
+		for (i32 y = support.minCell.y; y <= support.maxCell.y; y++)
+		{
+			for (i32 z = support.minCell.z; z <= support.maxCell.z; z++)
+			{
+				for (i32 x = support.minCell.x; x <= support.maxCell.x; x++)
+				{
+					cellOwners[GetCellKey(ivec3(x, y, z))] = entity;
+				}
+			}
+		}
+
+		return &EntityStore::GetSupports().Add(entity, support);
+	}
+
+	void SupportSystem::Remove(Entity entity)
+	{
+		//nothing left to empty for a block that already collapsed
+		const SupportComponent* support = EntityStore::GetSupports().Get(entity);
+		if (support == nullptr) return;
+
+		EmptyBlock(*support);
+	}
+
+	void SupportSystem::ClearCell(const ivec3& cell)
+	{
+		Entity owner = FindOwner(cell);
+		if (owner != INVALID_ENTITY)
+		{
+			brokenBlocks.push_back(owner);
+			return;
+		}
+
+		if (ChunkStore::GetCell(cell) == CELL_EMPTY) return;
+
+		ChunkStore::SetCell(cell, CELL_EMPTY);
+		WaterSystem::WakeCell(cell);
+		pendingCells.push_back(cell);
+	}
+
+	void SupportSystem::Resolve()
+	{
+		collapsedBlocks.clear();
+		checkedCellCount = 0;
+
+		if (brokenBlocks.empty()
+			&& pendingCells.empty())
+		{
+			return;
+		}
+
+		PROFILE_ZONE("SupportSystem::Resolve");
+
+		//a block broken twice is only found the first time
+		for (Entity entity : brokenBlocks) Collapse(entity);
+		brokenBlocks.clear();
+
+		//taking from the back follows one tower up before the next,
+		//a block falls the same no matter which cell under it was emptied first
+		while (!pendingCells.empty())
+		{
+			ivec3 above = pendingCells.back() + ivec3(0, 1, 0);
+			pendingCells.pop_back();
+			checkedCellCount++;
+
+			Entity owner = FindOwner(above);
+			if (owner == INVALID_ENTITY) continue;
+
+			const SupportComponent* support = EntityStore::GetSupports().Get(owner);
+			if (support->isAnchored
+				|| IsSupported(*support))
+			{
+				continue;
+			}
+
+			Collapse(owner);
+		}
+	}
+
+	span<const CollapsedBlock> SupportSystem::GetCollapsed()
+	{
+		return collapsedBlocks;
+	}
+
+	u32 SupportSystem::GetCheckedCellCount()
+	{
+		return checkedCellCount;
+	}
+
+	void SupportSystem::Clear()
+	{
+		cellOwners.clear();
+		pendingCells.clear();
+		brokenBlocks.clear();
+		collapsedBlocks.clear();
+		checkedCellCount = 0;
+	}
+}
+
+u64 GetCellKey(const ivec3& cell)
+{
+	//21 bits per axis is a million cells in each direction
+	constexpr u64 mask = (1ull << 21) - 1;
+
+	return (static_cast<u64>(static_cast<u32>(cell.x)) & mask)
+		| ((static_cast<u64>(static_cast<u32>(cell.y)) & mask) << 21)
+		| ((static_cast<u64>(static_cast<u32>(cell.z)) & mask) << 42);
+}
+
+Entity FindOwner(const ivec3& cell)
+{
+	auto it = cellOwners.find(GetCellKey(cell));
+	if (it == cellOwners.end()) return INVALID_ENTITY;
+
+	return it->second;
+}
+
+bool IsSupported(const SupportComponent& support)
+{
+	i32 y = support.minCell.y - 1;
+	for (i32 z = support.minCell.z; z <= support.maxCell.z; z++)
+	{
+		for (i32 x = support.minCell.x; x <= support.maxCell.x; x++)
+		{
+			u8 below = ChunkStore::GetCell(ivec3(x, y, z));
+			if (below == CELL_SOLID) return true;
+
+			//wires are not solid, only layer sockets are placed on them
+			if (IsBlockCell(below)
+				&& (GetCellBlockType(below) != BlockType::Wire
+				|| support.canRestOnWire))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void EmptyBlock(const SupportComponent& support)
+{
+	for (i32 y = support.minCell.y; y <= support.maxCell.y; y++)
+	{
+		for (i32 z = support.minCell.z; z <= support.maxCell.z; z++)
+		{
+			for (i32 x = support.minCell.x; x <= support.maxCell.x; x++)
+			{
+				ivec3 cell(x, y, z);
+				ChunkStore::SetCell(cell, CELL_EMPTY);
+				cellOwners.erase(GetCellKey(cell));
+
+				//water runs into the gap, SetCell already woke the debris resting on it
+				WaterSystem::WakeCell(cell);
+
+				if (y == support.maxCell.y) pendingCells.push_back(cell);
+			}
+		}
+	}
+}
+
+void Collapse(Entity entity)
+{
+	const SupportComponent* support = EntityStore::GetSupports().Get(entity);
+	if (support == nullptr) return;
+
+	collapsedBlocks.push_back(CollapsedBlock
+	{
+		.entity = entity,
+		.minCell = support->minCell,
+		.maxCell = support->maxCell,
+		.cellValue = ChunkStore::GetCell(support->minCell)
+	});
+
+	EmptyBlock(*support);
+
+	//the entity stays alive for whoever reads the batch, only the block is gone
+	EntityStore::GetSupports().Remove(entity);
+}
\ No newline at end of file
@@ -0,0 +1,796 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <vector>
+#include <span>
+#include <unordered_map>
+#include <cstring>
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define CIRCUIT_WATER_SSE2
+#endif
+
+#include "world/watersystem.hpp"
+#include "world/chunkstore.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "core/jobsystem.hpp"
+#include "core/profiler.hpp"
+#include "core/framearena.hpp"
+
+using CircuitGame::World::WaterSystem;
+using CircuitGame::World::WaterSurface;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::Chunk;
+using CircuitGame::World::CELL_EMPTY;
+using CircuitGame::World::CELL_SOLID;
+using CircuitGame::World::CHUNK_SIZE;
+using CircuitGame::World::CHUNK_MASK;
+using CircuitGame::World::CHUNK_VOLUME;
+using CircuitGame::World::WATER_FULL;
+using CircuitGame::World::WATER_SHORT_LEVEL;
+using CircuitGame::World::GetCellIndex;
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::Entity;
+using CircuitGame::GameObjects::CircuitComponent;
+using CircuitGame::GameObjects::MAX_POWER_LEVEL;
+using CircuitGame::Core::JobSystem;
+using CircuitGame::Core::FrameArena;
+
+using std::vector;
+using std::span;
+using std::unordered_map;
+using std::memcmp;
+using std::memcpy;
+using glm::ivec3;
+
+//chunks stepped by one job, a chunk is 256 rows, so a job is a few thousand rows
+//and waking the workers is paid back even with few active chunks
+static constexpr u32 CHUNK_GRAIN_SIZE = 8;
+
+enum ChunkSide : u32
+{
+	Side_Below,
+	Side_Above,
+	Side_Left,  //-x
+	Side_Right, //+x
+	Side_Back,  //-z
+	Side_Front, //+z
+	Side_Count
+};
+
+static constexpr ivec3 sideOffsets[Side_Count] =
+{
+	ivec3(0, -1, 0), ivec3(0, 1, 0),
+	ivec3(-1, 0, 0), ivec3(1, 0, 0),
+	ivec3(0, 0, -1), ivec3(0, 0, 1)
+};
+
+//one row of 16 cells along x, or a single cell at the edge of a row
+struct RowView
+{
+	const u8* water{};
+	const u8* cells{};
+};
+
+struct SteppedChunk
+{
+	Chunk* chunk{};
+	const Chunk* neighbors[Side_Count]{}; //Nullptr where the neighbour is not stepped, no water crosses there this step
+	bool hasChanged{};
+};
+
+//stands in for a missing or resting neighbour, water never flows into it
+struct ClosedRow
+{
+	u8 water[CHUNK_SIZE]{};
+	u8 cells[CHUNK_SIZE]{};
+};
+
+static const ClosedRow closedRow = []()
+{
+	ClosedRow row{};
+	for (u8& cell : row.cells) cell = CELL_SOLID;
+	return row;
+}();
+
+//a circuit block in the grid, cells are inclusive like ChunkStore::GetBoxCells
+struct CircuitCells
+{
+	Entity entity{};
+	ivec3 firstCell{};
+	ivec3 lastCell{};
+};
+
+struct WetChunk
+{
+	Chunk* chunk{};
+	vector<WaterSurface> surfaces{}; //Kept until the water of the chunk changes
+};
+
+static vector<Chunk*> activeChunks{};
+static vector<SteppedChunk> steppedChunks{};
+
+static unordered_map<const Chunk*, vector<CircuitCells>> chunkCircuits{}; //Blocks with a cell in the chunk
+static unordered_map<u32, CircuitCells> circuitCells{};                   //By entity handle value
+
+static vector<WetChunk> wetChunks{};
+static vector<WaterSurface> surfaces{};
+static bool areSurfacesDirty{};
+
+static void Activate(Chunk* chunk);
+static void AddStepped(Chunk* chunk);
+static bool HasWater(const Chunk& chunk);
+
+static RowView GetRow(
+	const Chunk& chunk,
+	i32 x,
+	i32 y,
+	i32 z);
+static RowView GetNeighborRow(
+	const SteppedChunk& stepped,
+	ChunkSide side,
+	i32 x,
+	i32 y,
+	i32 z);
+
+//every row falls into the one below, out holds the new levels of the chunk
+static void FallChunk(
+	const SteppedChunk& stepped,
+	u8* out);
+
+//every row evens out with the rows and cells beside it
+static void SpreadChunk(
+	const SteppedChunk& stepped,
+	u8* out);
+
+//runs one pass over every stepped chunk, then writes the new levels back
+template<typename Pass> static void RunPass(
+	Pass pass,
+	u8* nextWater,
+	const char* name);
+
+//the surface of the chunk and of the wet chunk below it are listed again on the next GetSurfaces
+static void MarkSurfaceDirty(Chunk* chunk);
+static void ListSurfaces(WetChunk& wet);
+
+//every chunk the block has a cell in
+template<typename Func> static void ForEachCircuitChunk(
+	const CircuitCells& circuit,
+	Func func);
+static bool IsNextToWater(const CircuitCells& circuit);
+static void UpdateCircuits();
+
+#ifdef CIRCUIT_WATER_SSE2
+static void FallRowSSE(RowView row, RowView below, RowView above, u8* out);
+static void SpreadRowSSE(RowView row, RowView back, RowView front, RowView left, RowView right, u8* out);
+#else
+static void FallRowScalar(RowView row, RowView below, RowView above, u8* out);
+static void SpreadRowScalar(RowView row, RowView back, RowView front, RowView left, RowView right, u8* out);
+#endif
+
+namespace CircuitGame::World
+{
+	u8 WaterSystem::AddWater(
+		const ivec3& cell,
+		u8 amount)
+	{
+		if (amount == 0
+			|| ChunkStore::GetCell(cell) != CELL_EMPTY)
+		{
+			return 0;
+		}
+
+		Chunk* chunk = ChunkStore::CreateChunk(ChunkStore::CellToChunk(cell));
+		if (chunk == nullptr) return 0;
+
+		u8& level = chunk->water[GetCellIndex(
+			cell.x & CHUNK_MASK,
+			cell.y & CHUNK_MASK,
+			cell.z & CHUNK_MASK)];
+
+		u8 added = glm::min(amount, static_cast<u8>(WATER_FULL - level));
+		level += added;
+
+		if (added > 0)
+		{
+			Activate(chunk);
+			MarkSurfaceDirty(chunk);
+		}
+
+		return added;
+	}
+
+	u8 WaterSystem::GetLevel(const ivec3& cell)
+	{
+		const Chunk* chunk = ChunkStore::GetChunk(ChunkStore::CellToChunk(cell));
+		if (chunk == nullptr) return 0;
+
+		return chunk->water[GetCellIndex(
+			cell.x & CHUNK_MASK,
+			cell.y & CHUNK_MASK,
+			cell.z & CHUNK_MASK)];
+	}
+
+	void WaterSystem::WakeCell(const ivec3& cell)
+	{
+		//the chunks around it are stepped along with it
+		ivec3 chunkCoord = ChunkStore::CellToChunk(cell);
+		if (ChunkStore::GetChunk(chunkCoord) == nullptr) return;
+
+		//filling a cell removes its water without a step
+		Chunk* chunk = ChunkStore::CreateChunk(chunkCoord);
+		Activate(chunk);
+		if (chunk != nullptr && chunk->isWet) MarkSurfaceDirty(chunk);
+	}
+
+	void WaterSystem::Step()
+	{
+		PROFILE_ZONE("WaterSystem::Step");
+
+		for (SteppedChunk& stepped : steppedChunks) stepped.chunk->isWaterStepped = false;
+		steppedChunks.clear();
+
+		if (activeChunks.empty()) return;
+
+		//active chunks and the chunks around them, inside the level bounds.
+		//A missing chunk next to water is created so the water can flow into it.
+		ivec3 minChunk{};
+		ivec3 maxChunk{};
+		ChunkStore::GetChunkBounds(minChunk, maxChunk);
+
+		for (Chunk* chunk : activeChunks) AddStepped(chunk);
+
+		size_t activeCount = steppedChunks.size();
+		for (size_t i = 0; i < activeCount; i++)
+		{
+			const Chunk& chunk = *steppedChunks[i].chunk;
+			bool hasWater = HasWater(chunk);
+
+			for (const ivec3& offset : sideOffsets)
+			{
+				ivec3 coord = chunk.coord + offset;
+				if (glm::any(glm::lessThan(coord, minChunk))
+					|| glm::any(glm::greaterThan(coord, maxChunk)))
+				{
+					continue;
+				}
+
+				if (hasWater
+					|| ChunkStore::GetChunk(coord) != nullptr)
+				{
+					if (Chunk* neighbor = ChunkStore::CreateChunk(coord)) AddStepped(neighbor);
+				}
+			}
+		}
+
+		for (SteppedChunk& stepped : steppedChunks)
+		{
+			for (u32 side = 0; side < Side_Count; side++)
+			{
+				const Chunk* neighbor = ChunkStore::GetChunk(stepped.chunk->coord + sideOffsets[side]);
+				stepped.neighbors[side] = neighbor != nullptr && neighbor->isWaterStepped
+					? neighbor
+					: nullptr;
+			}
+		}
+
+		//CHUNK_VOLUME per stepped chunk, only needed until the pass is written back
+		u8* nextWater = static_cast<u8*>(FrameArena::Allocate(steppedChunks.size() * CHUNK_VOLUME, 64));
+		if (nextWater == nullptr) return;
+
+		//falling first, so water that lands spreads in the same step
+		RunPass(FallChunk, nextWater, "WaterSystem::Fall");
+		RunPass(SpreadChunk, nextWater, "WaterSystem::Spread");
+
+		//a chunk that did not change stays as it is until a neighbour changes or it is woken
+		for (Chunk* chunk : activeChunks) chunk->isWaterActive = false;
+		activeChunks.clear();
+
+		for (const SteppedChunk& stepped : steppedChunks)
+		{
+			if (!stepped.hasChanged) continue;
+
+			Activate(stepped.chunk);
+			MarkSurfaceDirty(stepped.chunk);
+		}
+
+		UpdateCircuits();
+	}
+
+	void WaterSystem::AddCircuit(
+		Entity entity,
+		const ivec3& firstCell,
+		const ivec3& lastCell)
+	{
+		CircuitCells circuit
+		{
+			.entity = entity,
+			.firstCell = firstCell,
+			.lastCell = lastCell
+		};
+		if (!circuitCells.emplace(entity.value, circuit).second) return;
+
+		ForEachCircuitChunk(
+			circuit,
+			[&circuit](const Chunk* chunk)
+			{
+				chunkCircuits[chunk].push_back(circuit);
+			});
+	}
+
+	void WaterSystem::RemoveCircuit(Entity entity)
+	{
+		auto found = circuitCells.find(entity.value);
+		if (found == circuitCells.end()) return;
+
+		ForEachCircuitChunk(
+			found->second,
+			[entity](const Chunk* chunk)
+			{
+				auto listed = chunkCircuits.find(chunk);
+				if (listed == chunkCircuits.end()) return;
+
+				vector<CircuitCells>& circuits = listed->second;
+				for (size_t i = 0; i < circuits.size(); i++)
+				{
+					if (circuits[i].entity != entity) continue;
+
+					circuits[i] = circuits.back();
+					circuits.pop_back();
+					break;
+				}
+			});
+
+		circuitCells.erase(found);
+	}
+
+	void WaterSystem::ClearCircuits()
+	{
+		chunkCircuits.clear();
+		circuitCells.clear();
+	}
+
+	span<const WaterSurface> WaterSystem::GetSurfaces()
+	{
+		if (!areSurfacesDirty) return surfaces;
+
+		PROFILE_ZONE("WaterSystem::GetSurfaces");
+
+		surfaces.clear();
+		for (WetChunk& wet : wetChunks)
+		{
+			if (wet.chunk->isSurfaceDirty) ListSurfaces(wet);
+
+			surfaces.insert(surfaces.end(), wet.surfaces.begin(), wet.surfaces.end());
+		}
+
+		areSurfacesDirty = false;
+		return surfaces;
+	}
+
+	u32 WaterSystem::GetSteppedChunkCount()
+	{
+		return static_cast<u32>(steppedChunks.size());
+	}
+
+	u32 WaterSystem::GetActiveChunkCount()
+	{
+		return static_cast<u32>(activeChunks.size());
+	}
+
+	void WaterSystem::Clear()
+	{
+		activeChunks.clear();
+		steppedChunks.clear();
+
+		ClearCircuits();
+
+		wetChunks.clear();
+		surfaces.clear();
+		areSurfacesDirty = false;
+	}
+}
+
+void Activate(Chunk* chunk)
+{
+	if (chunk == nullptr
+		|| chunk->isWaterActive)
+	{
+		return;
+	}
+
+	chunk->isWaterActive = true;
+	activeChunks.push_back(chunk);
+}
+
+void AddStepped(Chunk* chunk)
+{
+	if (chunk->isWaterStepped) return;
+
+	chunk->isWaterStepped = true;
+	steppedChunks.push_back(SteppedChunk{ .chunk = chunk });
+}
+
+bool HasWater(const Chunk& chunk)
+{
+	for (u8 level : chunk.water)
+	{
+		if (level != 0) return true;
+	}
+
+	return false;
+}
+
+RowView GetRow(
+	const Chunk& chunk,
+	i32 x,
+	i32 y,
+	i32 z)
+{
+	u32 index = GetCellIndex(x, y, z);
+
+	return RowView{ &chunk.water[index], &chunk.cells[index] };
+}
+
+RowView GetNeighborRow(
+	const SteppedChunk& stepped,
+	ChunkSide side,
+	i32 x,
+	i32 y,
+	i32 z)
+{
+	const Chunk* neighbor = stepped.neighbors[side];
+	if (neighbor == nullptr) return RowView{ closedRow.water, closedRow.cells };
+
+	return GetRow(*neighbor, x, y, z);
+}
+
+void FallChunk(
+	const SteppedChunk& stepped,
+	u8* out)
+{
+	const Chunk& chunk = *stepped.chunk;
+
+	for (i32 y = 0; y < CHUNK_SIZE; y++)
+	{
+		for (i32 z = 0; z < CHUNK_SIZE; z++)
+		{
+			RowView below = y > 0
+				? GetRow(chunk, 0, y - 1, z)
+				: GetNeighborRow(stepped, Side_Below, 0, CHUNK_MASK, z);
+			RowView above = y < CHUNK_MASK
+				? GetRow(chunk, 0, y + 1, z)
+				: GetNeighborRow(stepped, Side_Above, 0, 0, z);
+
+#ifdef CIRCUIT_WATER_SSE2
+			FallRowSSE(GetRow(chunk, 0, y, z), below, above, out + GetCellIndex(0, y, z));
+#else
+			FallRowScalar(GetRow(chunk, 0, y, z), below, above, out + GetCellIndex(0, y, z));
+#endif
+		}
+	}
+}
+
+void SpreadChunk(
+	const SteppedChunk& stepped,
+	u8* out)
+{
+	const Chunk& chunk = *stepped.chunk;
+
+	for (i32 y = 0; y < CHUNK_SIZE; y++)
+	{
+		for (i32 z = 0; z < CHUNK_SIZE; z++)
+		{
+			RowView back = z > 0
+				? GetRow(chunk, 0, y, z - 1)
+				: GetNeighborRow(stepped, Side_Back, 0, y, CHUNK_MASK);
+			RowView front = z < CHUNK_MASK
+				? GetRow(chunk, 0, y, z + 1)
+				: GetNeighborRow(stepped, Side_Front, 0, y, 0);
+
+			//only the one cell past each end of the row
+			RowView left = GetNeighborRow(stepped, Side_Left, CHUNK_MASK, y, z);
+			RowView right = GetNeighborRow(stepped, Side_Right, 0, y, z);
+
+#ifdef CIRCUIT_WATER_SSE2
+			SpreadRowSSE(GetRow(chunk, 0, y, z), back, front, left, right, out + GetCellIndex(0, y, z));
+#else
+			SpreadRowScalar(GetRow(chunk, 0, y, z), back, front, left, right, out + GetCellIndex(0, y, z));
+#endif
+		}
+	}
+}
+
+template<typename Pass> void RunPass(
+	Pass pass,
+	u8* nextWater,
+	const char* name)
+{
+	u32 steppedCount = static_cast<u32>(steppedChunks.size());
+
+	//every chunk reads its neighbours, so nothing is written back until all of them are done
+	JobSystem::ParallelFor(
+		steppedCount,
+		CHUNK_GRAIN_SIZE,
+		[pass, nextWater](u32 begin, u32 end)
+		{
+			for (u32 i = begin; i < end; i++)
+			{
+				pass(steppedChunks[i], &nextWater[static_cast<size_t>(i) * CHUNK_VOLUME]);
+			}
+		},
+		name);
+
+	for (u32 i = 0; i < steppedCount; i++)
+	{
+		SteppedChunk& stepped = steppedChunks[i];
+		const u8* levels = &nextWater[static_cast<size_t>(i) * CHUNK_VOLUME];
+
+		if (memcmp(levels, stepped.chunk->water, CHUNK_VOLUME) == 0) continue;
+
+		memcpy(stepped.chunk->water, levels, CHUNK_VOLUME);
+		stepped.hasChanged = true;
+	}
+}
+
+void MarkSurfaceDirty(Chunk* chunk)
+{
+	if (!chunk->isWet)
+	{
+		chunk->isWet = true;
+		wetChunks.push_back(WetChunk{ .chunk = chunk });
+	}
+
+	chunk->isSurfaceDirty = true;
+	areSurfacesDirty = true;
+
+	//the top row of the chunk below is a surface only while this chunk has no water over it
+	const Chunk* below = ChunkStore::GetChunk(chunk->coord + sideOffsets[Side_Below]);
+	if (below != nullptr
+		&& below->isWet)
+	{
+		ChunkStore::CreateChunk(below->coord)->isSurfaceDirty = true;
+	}
+}
+
+void ListSurfaces(WetChunk& wet)
+{
+	const Chunk& chunk = *wet.chunk;
+	const Chunk* above = ChunkStore::GetChunk(chunk.coord + sideOffsets[Side_Above]);
+	ivec3 firstCell = chunk.coord * CHUNK_SIZE;
+
+	wet.surfaces.clear();
+	for (i32 y = 0; y < CHUNK_SIZE; y++)
+	{
+		for (i32 z = 0; z < CHUNK_SIZE; z++)
+		{
+			for (i32 x = 0; x < CHUNK_SIZE; x++)
+			{
+				u8 level = chunk.water[GetCellIndex(x, y, z)];
+				if (level == 0) continue;
+
+				u8 levelAbove = y < CHUNK_MASK
+					? chunk.water[GetCellIndex(x, y + 1, z)]
+					: (above != nullptr ? above->water[GetCellIndex(x, 0, z)] : 0);
+				if (levelAbove != 0) continue;
+
+				wet.surfaces.push_back(WaterSurface
+				{
+					.cell = firstCell + ivec3(x, y, z),
+					.level = level
+				});
+			}
+		}
+	}
+
+	wet.chunk->isSurfaceDirty = false;
+}
+
+template<typename Func> void ForEachCircuitChunk(
+	const CircuitCells& circuit,
+	Func func)
+{
+	ivec3 firstChunk = ChunkStore::CellToChunk(circuit.firstCell);
+	ivec3 lastChunk = ChunkStore::CellToChunk(circuit.lastCell);
+
+	for (i32 y = firstChunk.y; y <= lastChunk.y; y++)
+	{
+		for (i32 z = firstChunk.z; z <= lastChunk.z; z++)
+		{
+			for (i32 x = firstChunk.x; x <= lastChunk.x; x++)
+			{
+				if (const Chunk* chunk = ChunkStore::GetChunk(ivec3(x, y, z))) func(chunk);
+			}
+		}
+	}
+}
+
+bool IsNextToWater(const CircuitCells& circuit)
+{
+	//cells sharing a face with the block, the box grown by one minus its edges and corners
+	ivec3 first = circuit.firstCell - 1;
+	ivec3 last = circuit.lastCell + 1;
+
+	for (i32 y = first.y; y <= last.y; y++)
+	{
+		for (i32 z = first.z; z <= last.z; z++)
+		{
+			for (i32 x = first.x; x <= last.x; x++)
+			{
+				ivec3 cell(x, y, z);
+				ivec3 outside = ivec3(glm::lessThan(cell, circuit.firstCell))
+					+ ivec3(glm::greaterThan(cell, circuit.lastCell));
+				if (outside.x + outside.y + outside.z != 1) continue;
+
+				if (WaterSystem::GetLevel(cell) >= WATER_SHORT_LEVEL) return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void UpdateCircuits()
+{
+	if (chunkCircuits.empty()) return;
+
+	//only blocks in a stepped chunk can have had the water beside them change,
+	//water next to a block is in the chunk of one of its cells or in a chunk beside that one,
+	//which is stepped along with it. A block across a chunk border is checked once per chunk.
+	for (const SteppedChunk& stepped : steppedChunks)
+	{
+		auto listed = chunkCircuits.find(stepped.chunk);
+		if (listed == chunkCircuits.end()) continue;
+
+		for (const CircuitCells& cells : listed->second)
+		{
+			CircuitComponent* circuit = EntityStore::GetCircuits().Get(cells.entity);
+			if (circuit == nullptr) continue;
+
+			circuit->isShorted = IsNextToWater(cells);
+
+			//nothing conducts yet, sources come back on once the water is gone
+			if (circuit->isShorted)
+			{
+				circuit->isPowered = false;
+				circuit->powerLevel = 0;
+			}
+			else if (circuit->isSource)
+			{
+				circuit->isPowered = true;
+				circuit->powerLevel = MAX_POWER_LEVEL;
+			}
+		}
+	}
+}
+
+#ifdef CIRCUIT_WATER_SSE2
+
+//
+// SSE2, one row of 16 cells is one register
+//
+
+static __m128i LoadRow(const u8* values)
+{
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+}
+
+//0xFF in every lane whose cell is empty
+static __m128i LoadOpen(const u8* cells)
+{
+	return _mm_cmpeq_epi8(LoadRow(cells), _mm_setzero_si128());
+}
+
+//unsigned bytes divided by eight, rounded down
+static __m128i DivideByEight(__m128i values)
+{
+	return _mm_and_si128(_mm_srli_epi16(values, 3), _mm_set1_epi8(0x1F));
+}
+
+void FallRowSSE(RowView row, RowView below, RowView above, u8* out)
+{
+	__m128i water = LoadRow(row.water);
+	__m128i open = LoadOpen(row.cells);
+	__m128i belowWater = LoadRow(below.water);
+	__m128i belowOpen = LoadOpen(below.cells);
+	__m128i aboveWater = LoadRow(above.water);
+	__m128i aboveOpen = LoadOpen(above.cells);
+	__m128i full = _mm_set1_epi8(static_cast<char>(WATER_FULL));
+
+	//as much as fits below, and as much from above as fits here
+	__m128i fallOut = _mm_and_si128(_mm_min_epu8(water, _mm_subs_epu8(full, belowWater)), belowOpen);
+	__m128i fallIn = _mm_and_si128(
+		_mm_min_epu8(aboveWater, _mm_subs_epu8(full, water)),
+		_mm_and_si128(aboveOpen, open));
+
+	_mm_storeu_si128(
+		reinterpret_cast<__m128i*>(out),
+		_mm_adds_epu8(_mm_subs_epu8(water, fallOut), fallIn));
+}
+
+void SpreadRowSSE(RowView row, RowView back, RowView front, RowView left, RowView right, u8* out)
+{
+	__m128i water = LoadRow(row.water);
+	__m128i open = LoadOpen(row.cells);
+
+	//neighbours along x are the row itself moved by one lane, with the cell past the end shifted in
+	__m128i leftWater = _mm_or_si128(_mm_slli_si128(water, 1), _mm_cvtsi32_si128(left.water[0]));
+	__m128i leftOpen = _mm_or_si128(_mm_slli_si128(open, 1), _mm_cvtsi32_si128(left.cells[0] == CELL_EMPTY ? 0xFF : 0));
+	__m128i rightWater = _mm_or_si128(_mm_srli_si128(water, 1), _mm_slli_si128(_mm_cvtsi32_si128(right.water[0]), 15));
+	__m128i rightOpen = _mm_or_si128(_mm_srli_si128(open, 1), _mm_slli_si128(_mm_cvtsi32_si128(right.cells[0] == CELL_EMPTY ? 0xFF : 0), 15));
+
+	__m128i neighborWater[4] = { LoadRow(back.water), LoadRow(front.water), leftWater, rightWater };
+	__m128i neighborOpen[4] = { LoadOpen(back.cells), LoadOpen(front.cells), leftOpen, rightOpen };
+
+	//an eighth of the difference to every open neighbour, both cells of a pair round the same way
+	__m128i gain = _mm_setzero_si128();
+	__m128i loss = _mm_setzero_si128();
+	for (u32 i = 0; i < 4; i++)
+	{
+		__m128i pairOpen = _mm_and_si128(open, neighborOpen[i]);
+
+		gain = _mm_adds_epu8(gain, _mm_and_si128(DivideByEight(_mm_subs_epu8(neighborWater[i], water)), pairOpen));
+		loss = _mm_adds_epu8(loss, _mm_and_si128(DivideByEight(_mm_subs_epu8(water, neighborWater[i])), pairOpen));
+	}
+
+	_mm_storeu_si128(
+		reinterpret_cast<__m128i*>(out),
+		_mm_subs_epu8(_mm_adds_epu8(water, gain), loss));
+}
+
+#else
+
+//
+// Scalar, the same steps one cell at a time
+//
+
+void FallRowScalar(RowView row, RowView below, RowView above, u8* out)
+{
+	for (i32 x = 0; x < CHUNK_SIZE; x++)
+	{
+		u8 water = row.water[x];
+
+		u8 fallOut = below.cells[x] == CELL_EMPTY
+			? glm::min(water, static_cast<u8>(WATER_FULL - below.water[x]))
+			: 0;
+		u8 fallIn = above.cells[x] == CELL_EMPTY && row.cells[x] == CELL_EMPTY
+			? glm::min(above.water[x], static_cast<u8>(WATER_FULL - water))
+			: 0;
+
+		out[x] = static_cast<u8>(water - fallOut + fallIn);
+	}
+}
+
+void SpreadRowScalar(RowView row, RowView back, RowView front, RowView left, RowView right, u8* out)
+{
+	for (i32 x = 0; x < CHUNK_SIZE; x++)
+	{
+		i32 water = row.water[x];
+		i32 level = water;
+
+		if (row.cells[x] == CELL_EMPTY)
+		{
+			RowView neighbors[4] =
+			{
+				RowView{ &back.water[x], &back.cells[x] },
+				RowView{ &front.water[x], &front.cells[x] },
+				x > 0 ? RowView{ &row.water[x - 1], &row.cells[x - 1] } : left,
+				x < CHUNK_MASK ? RowView{ &row.water[x + 1], &row.cells[x + 1] } : right
+			};
+
+			for (const RowView& neighbor : neighbors)
+			{
+				if (neighbor.cells[0] != CELL_EMPTY) continue;
+
+				i32 difference = neighbor.water[0] - water;
+				level += difference > 0 ? difference / 8 : -(-difference / 8);
+			}
+		}
+
+		out[x] = static_cast<u8>(level);
+	}
+}
+
+#endif
\ No newline at end of file
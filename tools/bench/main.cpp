@@ -0,0 +1,1067 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+//Circuit_Chan_bench - timings for engine systems that do not need a window.
+//Usage: Circuit_Chan_bench [max worker count]
+//  - jobs: embarrassingly parallel workload run with 1, 2, 4... workers,
+//    speedup and efficiency are relative to the single worker run
+//  - profiler: cost of one PROFILE_ZONE while idle and while capturing
+//  - arena: per frame temporary vectors from the heap and from the frame arena
+//  - entities: iterating 100k blocks stored as heap objects and as packed components,
+//    and updating cached transforms when 1% of them move
+//  - batch math: TRS, mat4 x mat4, mat4 x vec4 and AABB kernels at every supported
+//    instruction set against one glm call per object
+//  - raycast: picking rays through a chunked block grid, short rays among blocks
+//    and long rays over open floor where whole chunks are skipped
+//  - character: fixed steps of the player box walking and jumping among the blocks
+//  - broadphase: overlap pairs of many dynamic boxes when all of them move
+//    and when most of them sleep
+//  - debris: a collapsed floor of panels falling and piling up until it sleeps,
+//    and steps once all of it sleeps
+//  - water: a walled room flooding from two leaks, evening out until it sleeps,
+//    and steps once all of it sleeps
+//  - collapse: blocks falling once the ground under them is gone, one tower
+//    and then every tower and wire network on a floor that gives way
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+#include "core/jobsystem.hpp"
+#include "core/profiler.hpp"
+#include "core/framearena.hpp"
+#include "gameobjects/entitystore.hpp"
+#include "gameobjects/transformsystem.hpp"
+#include "core/batchmath.hpp"
+#include "world/chunkstore.hpp"
+#include "world/charactercontroller.hpp"
+#include "world/broadphase.hpp"
+#include "world/debrissystem.hpp"
+#include "world/watersystem.hpp"
+#include "world/supportsystem.hpp"
+
+using CircuitGame::Core::JobSystem;
+using CircuitGame::Core::JobCounter;
+using CircuitGame::Core::JobDesc;
+using CircuitGame::Core::Profiler;
+using CircuitGame::Core::FrameArena;
+using CircuitGame::Core::FrameVector;
+using CircuitGame::GameObjects::EntityStore;
+using CircuitGame::GameObjects::Entity;
+using CircuitGame::GameObjects::BlockType;
+using CircuitGame::GameObjects::BLOCK_TYPE_COUNT;
+using CircuitGame::GameObjects::TransformComponent;
+using CircuitGame::GameObjects::TransformMatrices;
+using CircuitGame::GameObjects::RenderComponent;
+using CircuitGame::GameObjects::CircuitComponent;
+using CircuitGame::GameObjects::GetModelMatrix;
+using CircuitGame::GameObjects::TransformSystem;
+using CircuitGame::Core::BatchMath;
+using CircuitGame::Core::SIMDLevel;
+using CircuitGame::Core::GetSIMDLevelName;
+using CircuitGame::Core::TRSArrays;
+using CircuitGame::Core::Vec4Arrays;
+using CircuitGame::Core::AABBArrays;
+using CircuitGame::World::ChunkStore;
+using CircuitGame::World::RaycastHit;
+using CircuitGame::World::CELL_SOLID;
+using CircuitGame::World::CELL_EMPTY;
+using CircuitGame::World::CELL_SIZE;
+using CircuitGame::World::MakeBlockCell;
+using CircuitGame::World::CharacterController;
+using CircuitGame::World::CharacterBody;
+using CircuitGame::World::Broadphase;
+using CircuitGame::World::Proxy;
+using CircuitGame::World::DebrisSystem;
+using CircuitGame::World::WaterSystem;
+using CircuitGame::World::SupportSystem;
+
+using std::cout;
+using std::fixed;
+using std::setprecision;
+using std::setw;
+using std::string;
+using std::vector;
+using std::thread;
+using std::unique_ptr;
+using std::make_unique;
+using std::unordered_map;
+using std::span;
+using std::to_string;
+using std::move;
+using std::max;
+using std::min;
+using std::stoul;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+using glm::ivec3;
+
+static constexpr u32 ITEM_COUNT = 1 << 20;
+static constexpr u32 GRAIN_SIZE = 1024;
+static constexpr u32 ITERATIONS_PER_ITEM = 64;
+static constexpr u32 RUN_COUNT = 5;
+
+static f64 RunParallelWorkload(vector<f32>& values);
+static f64 RunEmptyJobs(u32 jobCount);
+#ifdef CIRCUIT_PROFILER_ENABLED
+static f64 RunProfileZones(u32 zoneCount);
+#endif
+template<typename List> static f64 RunTransientLists(bool isArena);
+static void RunEntityIteration();
+static void RunBatchMath();
+//same sequence on every run and platform, in [0, 1)
+static f32 NextRandom(u32& seed);
+static void BuildBenchGrid();
+static void RunRaycasts();
+static void RunCharacterSteps();
+static void RunBroadphase();
+static void RunDebris();
+static void RunWater();
+static void RunCollapse();
+template<typename Function> static f64 TimeBest(Function function);
+
+static volatile u64 benchSink{};
+
+//temporary lists built per frame, each filled one element at a time
+static constexpr u32 TRANSIENT_FRAMES = 200;
+static constexpr u32 TRANSIENT_LISTS = 512;
+static constexpr u32 TRANSIENT_LIST_SIZE = 64;
+
+static constexpr u32 ENTITY_COUNT = 100000;
+static constexpr u32 MOVED_ENTITY_COUNT = ENTITY_COUNT / 100;
+
+//instances of a large level
+static constexpr u32 BATCH_COUNT = 16384;
+
+//floor of a 64m x 64m room, rays per timed run
+static constexpr i32 RAYCAST_ROOM_CELLS = 128;
+static constexpr u32 RAY_COUNT = 100000;
+static constexpr u32 CHARACTER_STEP_COUNT = 100000;
+
+//debris boxes of a collapsed level, one in this many keeps moving in the sleeping run
+static constexpr u32 BROADPHASE_BODY_COUNT = 5000;
+static constexpr u32 BROADPHASE_AWAKE_RATIO = 20;
+static constexpr u32 BROADPHASE_STEP_COUNT = 60;
+
+//panels of a 20 x 20 floor dropped in four layers, fixed steps to give them to settle
+static constexpr u32 DEBRIS_PANEL_COUNT = 400;
+static constexpr u32 DEBRIS_MAX_STEPS = 1800;
+static constexpr u32 DEBRIS_SLEEPING_STEPS = 600;
+
+//a 20m x 20m room with 4m walls, steps the leaks run and the most steps given to even out
+static constexpr u32 WATER_POUR_STEPS = 600;
+static constexpr u32 WATER_MAX_STEPS = 6000;
+static constexpr u32 WATER_SLEEPING_STEPS = 600;
+
+//floor cells along each side, blocks per tower standing on every other floor cell
+static constexpr i32 COLLAPSE_FLOOR_CELLS = 64;
+static constexpr i32 COLLAPSE_TOWER_HEIGHT = 8;
+
+//What one instance in the block batch holds
+struct BenchInstance
+{
+	mat4 model{};
+	f32 layer{};
+};
+
+//Copy of the gameobject layout the entity store replaced:
+//one heap object per block with name, transform, GL handles and shader together,
+//owned by a map and iterated through a vector of pointers
+class LegacyObject
+{
+public:
+	virtual ~LegacyObject() = default;
+	virtual bool Render(const mat4&, const mat4&) { return true; }
+
+	bool canUpdate = true;
+	string name{};
+	u32 ID{};
+	vec3 pos{};
+	vec3 rot{};
+	vec3 scale = vec3(1.0f);
+	u32 VAO{};
+	u32 VBO{};
+	u32 EBO{};
+	void* shader{};
+	void* texture{};
+	BlockType blockType{};
+};
+
+int main(int argc, char* argv[])
+{
+	u32 hardwareThreads = max(thread::hardware_concurrency(), 1u);
+	u32 maxWorkers = argc > 1
+		? max(static_cast<u32>(stoul(argv[1])), 1u)
+		: hardwareThreads;
+
+	cout << "[BENCH] " << hardwareThreads << " hardware threads, "
+		<< ITEM_COUNT << " items, grain " << GRAIN_SIZE << ", best of " << RUN_COUNT << " runs\n";
+	cout << "[BENCH] workers      time(ms)   speedup   efficiency\n";
+
+	vector<f32> values(ITEM_COUNT);
+
+	f64 baseline = 0.0;
+	for (u32 workers = 1; ; workers = min(workers * 2, maxWorkers))
+	{
+		JobSystem::Initialize(workers);
+
+		f64 best = 1e30;
+		for (u32 run = 0; run < RUN_COUNT; ++run)
+		{
+			best = min(best, RunParallelWorkload(values));
+		}
+
+		JobSystem::Shutdown();
+
+		if (workers == 1) baseline = best;
+		f64 speedup = baseline / best;
+
+		cout << "[BENCH] " << setw(7) << workers
+			<< fixed << setprecision(2)
+			<< setw(14) << best * 1000.0
+			<< setw(10) << speedup
+			<< setw(12) << speedup / workers * 100.0 << "%\n";
+
+		if (workers == maxWorkers) break;
+	}
+
+	//scheduling overhead, jobs that do nothing
+
+	JobSystem::Initialize(maxWorkers);
+	u32 emptyJobCount = 100000;
+	f64 emptyTime = RunEmptyJobs(emptyJobCount);
+	JobSystem::Shutdown();
+
+	cout << "[BENCH] " << emptyJobCount << " empty jobs on " << maxWorkers << " workers: "
+		<< fixed << setprecision(1) << emptyTime * 1e9 / emptyJobCount << "ns per job\n";
+
+	//profiler overhead, an empty zone with and without a capture running
+
+#ifdef CIRCUIT_PROFILER_ENABLED
+	u32 zoneCount = 1000000;
+	f64 idleZoneTime = RunProfileZones(zoneCount);
+
+	Profiler::BeginCapture(1);
+	f64 capturingZoneTime = RunProfileZones(zoneCount);
+	Profiler::EndFrame();
+
+	cout << "[BENCH] profile zone: " << fixed << setprecision(1)
+		<< idleZoneTime * 1e9 / zoneCount << "ns idle, "
+		<< capturingZoneTime * 1e9 / zoneCount << "ns capturing\n";
+#else
+	cout << "[BENCH] profile zone: compiled out, enable CIRCUIT_PROFILER\n";
+#endif
+
+	//heap against frame arena for lists that only live for one frame
+
+	f64 heapTime = RunTransientLists<vector<u32>>(false);
+	f64 arenaTime = RunTransientLists<FrameVector<u32>>(true);
+	f64 listCount = static_cast<f64>(TRANSIENT_FRAMES) * TRANSIENT_LISTS;
+
+	cout << "[BENCH] " << TRANSIENT_LISTS << " lists of " << TRANSIENT_LIST_SIZE << " per frame: "
+		<< fixed << setprecision(1)
+		<< heapTime * 1e9 / listCount << "ns per list on the heap, "
+		<< arenaTime * 1e9 / listCount << "ns per list in the frame arena, "
+		<< FrameArena::GetCapacity() / 1024 << "KB arena\n";
+
+	FrameArena::Shutdown();
+
+	RunEntityIteration();
+	RunBatchMath();
+	RunRaycasts();
+	RunCharacterSteps();
+	RunBroadphase();
+	RunDebris();
+	RunWater();
+	RunCollapse();
+
+	return 0;
+}
+
+f64 RunParallelWorkload(vector<f32>& values)
+{
+	auto start = steady_clock::now();
+
+	JobSystem::ParallelFor(
+		ITEM_COUNT,
+		GRAIN_SIZE,
+		[&values](u32 begin, u32 end)
+		{
+			for (u32 i = begin; i < end; ++i)
+			{
+				f32 x = static_cast<f32>(i) * 0.001f;
+				for (u32 k = 0; k < ITERATIONS_PER_ITEM; ++k)
+				{
+					x = std::sin(x) * 0.5f + std::sqrt(x + 1.0f);
+				}
+				values[i] = x;
+			}
+		});
+
+	duration<f64> elapsed = steady_clock::now() - start;
+	return elapsed.count();
+}
+
+f64 RunEmptyJobs(u32 jobCount)
+{
+	JobCounter counter{};
+	JobDesc job =
+	{
+		.function = [](void*, u32, u32) {}
+	};
+
+	auto start = steady_clock::now();
+
+	for (u32 i = 0; i < jobCount; ++i) JobSystem::Submit(job, &counter);
+	JobSystem::Wait(counter);
+
+	duration<f64> elapsed = steady_clock::now() - start;
+	return elapsed.count();
+}
+
+#ifdef CIRCUIT_PROFILER_ENABLED
+f64 RunProfileZones(u32 zoneCount)
+{
+	auto start = steady_clock::now();
+
+	for (u32 i = 0; i < zoneCount; ++i)
+	{
+		PROFILE_ZONE("Bench::EmptyZone");
+	}
+
+	duration<f64> elapsed = steady_clock::now() - start;
+	return elapsed.count();
+}
+#endif
+
+template<typename List> f64 RunTransientLists(bool isArena)
+{
+	u64 checksum = 0;
+
+	auto start = steady_clock::now();
+
+	for (u32 frame = 0; frame < TRANSIENT_FRAMES; ++frame)
+	{
+		for (u32 i = 0; i < TRANSIENT_LISTS; ++i)
+		{
+			List list{};
+			for (u32 k = 0; k < TRANSIENT_LIST_SIZE; ++k) list.push_back(frame + i + k);
+
+			checksum += list.back();
+		}
+
+		if (isArena) FrameArena::EndFrame();
+	}
+
+	duration<f64> elapsed = steady_clock::now() - start;
+
+	//keeps the lists from being optimized away
+	benchSink = checksum;
+
+	return elapsed.count();
+}
+
+void RunEntityIteration()
+{
+	unordered_map<u32, unique_ptr<LegacyObject>> legacyObjects{};
+	vector<LegacyObject*> legacyRuntime{};
+
+	for (u32 i = 0; i < ENTITY_COUNT; ++i)
+	{
+		auto object = make_unique<LegacyObject>();
+		object->name = "cube_passthrough_socket_" + to_string(i);
+		object->ID = i;
+		object->pos = vec3(static_cast<f32>(i % 100), static_cast<f32>(i / 10000), static_cast<f32>((i / 100) % 100));
+		object->blockType = static_cast<BlockType>(i % BLOCK_TYPE_COUNT);
+
+		legacyRuntime.push_back(object.get());
+		legacyObjects[i] = move(object);
+	}
+
+	for (u32 i = 0; i < ENTITY_COUNT; ++i)
+	{
+		Entity entity = EntityStore::Create();
+		TransformSystem::Add(entity, legacyRuntime[i]->pos);
+		EntityStore::GetRenders().Add(entity, RenderComponent{ .blockType = legacyRuntime[i]->blockType });
+	}
+
+	TransformSystem::Update();
+
+	vector<BenchInstance> instances{};
+	instances.reserve(ENTITY_COUNT);
+
+	f64 legacySum = 1e30;
+	f64 storeSum = 1e30;
+	f64 legacyGather = 1e30;
+	f64 storeGather = 1e30;
+	f64 movedUpdate = 1e30;
+	f32 checksum = 0.0f;
+
+	for (u32 run = 0; run < RUN_COUNT; ++run)
+	{
+		//plain walk over positions, shows the memory layout alone
+
+		auto start = steady_clock::now();
+		vec3 total{};
+		for (const auto* object : legacyRuntime)
+		{
+			if (object->canUpdate) total += object->pos;
+		}
+		duration<f64> elapsed = steady_clock::now() - start;
+		legacySum = min(legacySum, elapsed.count());
+		checksum += total.x;
+
+		start = steady_clock::now();
+		total = vec3(0.0f);
+		for (const auto& transform : EntityStore::GetTransforms().GetComponents())
+		{
+			total += transform.pos;
+		}
+		elapsed = steady_clock::now() - start;
+		storeSum = min(storeSum, elapsed.count());
+		checksum += total.x;
+
+		//the block batch gather Render::Redraw does every frame
+
+		start = steady_clock::now();
+		instances.clear();
+		for (const auto* object : legacyRuntime)
+		{
+			if (!object->canUpdate) continue;
+
+			instances.push_back(
+			{
+				GetModelMatrix(object->pos, object->rot, object->scale),
+				static_cast<f32>(object->blockType)
+			});
+		}
+		elapsed = steady_clock::now() - start;
+		legacyGather = min(legacyGather, elapsed.count());
+		checksum += instances.back().layer;
+
+		start = steady_clock::now();
+		instances.clear();
+		span<const Entity> entities = EntityStore::GetRenders().GetEntities();
+		span<const RenderComponent> renders = EntityStore::GetRenders().GetComponents();
+		for (size_t i = 0; i < renders.size(); ++i)
+		{
+			if (!renders[i].isVisible) continue;
+
+			const TransformMatrices* transform = TransformSystem::GetMatrices(entities[i]);
+			if (transform == nullptr) continue;
+
+			instances.push_back({ transform->world, static_cast<f32>(renders[i].blockType) });
+		}
+		elapsed = steady_clock::now() - start;
+		storeGather = min(storeGather, elapsed.count());
+		checksum += instances.back().layer;
+
+		//a few blocks move, only they are rebuilt
+
+		span<const Entity> transformEntities = EntityStore::GetTransforms().GetEntities();
+		for (u32 i = 0; i < MOVED_ENTITY_COUNT; ++i)
+		{
+			Entity entity = transformEntities[(i * 97 + run) % ENTITY_COUNT];
+			TransformSystem::SetPos(entity, vec3(static_cast<f32>(run + 1), 0.0f, static_cast<f32>(i)));
+		}
+
+		start = steady_clock::now();
+		TransformSystem::Update();
+		elapsed = steady_clock::now() - start;
+		movedUpdate = min(movedUpdate, elapsed.count());
+	}
+
+	benchSink = static_cast<u64>(checksum);
+
+	cout << "[BENCH] " << ENTITY_COUNT << " entities: " << fixed << setprecision(2)
+		<< "position walk " << legacySum * 1e9 / ENTITY_COUNT << "ns legacy, "
+		<< storeSum * 1e9 / ENTITY_COUNT << "ns packed, "
+		<< "batch gather " << legacyGather * 1e9 / ENTITY_COUNT << "ns legacy, "
+		<< storeGather * 1e9 / ENTITY_COUNT << "ns packed per entity\n";
+	cout << "[BENCH] " << MOVED_ENTITY_COUNT << " of " << ENTITY_COUNT << " transforms moved: "
+		<< fixed << setprecision(1) << movedUpdate * 1e6 << "us to update\n";
+
+	EntityStore::Clear();
+}
+
+void RunBatchMath()
+{
+	//structure of arrays inputs, values stay small so nothing overflows across runs
+	vector<f32> arrays[10]{};
+	for (auto& values : arrays) values.resize(BATCH_COUNT);
+
+	for (u32 i = 0; i < BATCH_COUNT; ++i)
+	{
+		f32 t = static_cast<f32>(i) * 0.001f;
+		glm::quat rotation = glm::angleAxis(t, glm::normalize(vec3(1.0f, 2.0f, 3.0f)));
+
+		arrays[0][i] = t;
+		arrays[1][i] = -t;
+		arrays[2][i] = 0.5f * t;
+		arrays[3][i] = rotation.x;
+		arrays[4][i] = rotation.y;
+		arrays[5][i] = rotation.z;
+		arrays[6][i] = rotation.w;
+		arrays[7][i] = 1.0f;
+		arrays[8][i] = 1.0f + 0.5f * std::sin(t);
+		arrays[9][i] = 0.5f;
+	}
+
+	TRSArrays trs =
+	{
+		arrays[0].data(), arrays[1].data(), arrays[2].data(),
+		arrays[3].data(), arrays[4].data(), arrays[5].data(), arrays[6].data(),
+		arrays[7].data(), arrays[8].data(), arrays[9].data()
+	};
+
+	vector<mat4> models(BATCH_COUNT);
+	vector<mat4> results(BATCH_COUNT);
+	mat4 viewProjection = glm::perspective(1.0f, 16.0f / 9.0f, 0.1f, 100.0f)
+		* glm::lookAt(vec3(0.0f, 5.0f, 10.0f), vec3(0.0f), vec3(0.0f, 1.0f, 0.0f));
+
+	vector<f32> outputs[6]{};
+	for (auto& values : outputs) values.resize(BATCH_COUNT);
+
+	Vec4Arrays points = { arrays[0].data(), arrays[1].data(), arrays[2].data(), arrays[7].data() };
+	Vec4Arrays transformed = { outputs[0].data(), outputs[1].data(), outputs[2].data(), outputs[3].data() };
+
+	//unit boxes around every position
+	vector<f32> boxes[6]{};
+	for (auto& values : boxes) values.resize(BATCH_COUNT);
+	for (u32 i = 0; i < BATCH_COUNT; ++i)
+	{
+		for (u32 axis = 0; axis < 3; ++axis)
+		{
+			boxes[axis][i] = arrays[axis][i] - 0.5f;
+			boxes[axis + 3][i] = arrays[axis][i] + 0.5f;
+		}
+	}
+	AABBArrays boxesIn = { boxes[0].data(), boxes[1].data(), boxes[2].data(), boxes[3].data(), boxes[4].data(), boxes[5].data() };
+	AABBArrays boxesOut = { outputs[0].data(), outputs[1].data(), outputs[2].data(), outputs[3].data(), outputs[4].data(), outputs[5].data() };
+
+	//one glm call per object, the way TransformSystem and Render::Redraw work today
+
+	f64 glmTimes[4]{};
+	glmTimes[0] = TimeBest([&]()
+	{
+		for (u32 i = 0; i < BATCH_COUNT; ++i)
+		{
+			glm::quat rotation(arrays[6][i], arrays[3][i], arrays[4][i], arrays[5][i]);
+			mat4 model = glm::translate(mat4(1.0f), vec3(arrays[0][i], arrays[1][i], arrays[2][i]));
+			model *= glm::mat4_cast(rotation);
+			models[i] = glm::scale(model, vec3(arrays[7][i], arrays[8][i], arrays[9][i]));
+		}
+	});
+	glmTimes[1] = TimeBest([&]()
+	{
+		for (u32 i = 0; i < BATCH_COUNT; ++i) results[i] = viewProjection * models[i];
+	});
+	glmTimes[2] = TimeBest([&]()
+	{
+		for (u32 i = 0; i < BATCH_COUNT; ++i)
+		{
+			vec4 point = viewProjection * vec4(points.x[i], points.y[i], points.z[i], points.w[i]);
+			transformed.x[i] = point.x;
+			transformed.y[i] = point.y;
+			transformed.z[i] = point.z;
+			transformed.w[i] = point.w;
+		}
+	});
+	glmTimes[3] = TimeBest([&]()
+	{
+		const mat4& matrix = models[BATCH_COUNT / 2];
+		for (u32 i = 0; i < BATCH_COUNT; ++i)
+		{
+			vec3 boxMin(boxesIn.minX[i], boxesIn.minY[i], boxesIn.minZ[i]);
+			vec3 boxMax(boxesIn.maxX[i], boxesIn.maxY[i], boxesIn.maxZ[i]);
+			vec3 center = vec3(matrix * vec4((boxMin + boxMax) * 0.5f, 1.0f));
+			vec3 extent = glm::mat3(
+				glm::abs(vec3(matrix[0])),
+				glm::abs(vec3(matrix[1])),
+				glm::abs(vec3(matrix[2]))) * ((boxMax - boxMin) * 0.5f);
+
+			boxesOut.minX[i] = center.x - extent.x;
+			boxesOut.minY[i] = center.y - extent.y;
+			boxesOut.minZ[i] = center.z - extent.z;
+			boxesOut.maxX[i] = center.x + extent.x;
+			boxesOut.maxY[i] = center.y + extent.y;
+			boxesOut.maxZ[i] = center.z + extent.z;
+		}
+	});
+
+	SIMDLevel supported = BatchMath::GetSupportedSIMDLevel();
+	u32 levelCount = static_cast<u32>(supported) + 1;
+
+	f64 batchTimes[3][4]{};
+	for (u32 level = 0; level < levelCount; ++level)
+	{
+		BatchMath::SetSIMDLevel(static_cast<SIMDLevel>(level));
+
+		batchTimes[level][0] = TimeBest([&]() { BatchMath::ComposeTRS(trs, models.data(), BATCH_COUNT); });
+		batchTimes[level][1] = TimeBest([&]() { BatchMath::MultiplyMat4(viewProjection, models.data(), results.data(), BATCH_COUNT); });
+		batchTimes[level][2] = TimeBest([&]() { BatchMath::TransformVec4(viewProjection, points, transformed, BATCH_COUNT); });
+		batchTimes[level][3] = TimeBest([&]() { BatchMath::TransformAABB(models[BATCH_COUNT / 2], boxesIn, boxesOut, BATCH_COUNT); });
+	}
+	BatchMath::SetSIMDLevel(supported);
+
+	benchSink = static_cast<u64>(results[BATCH_COUNT - 1][3][0] + outputs[5][BATCH_COUNT - 1]);
+
+	cout << "[BENCH] batch math, " << BATCH_COUNT << " objects, ns per object, best cpu level " << GetSIMDLevelName(supported) << "\n";
+	cout << "[BENCH] kernel         glm";
+	for (u32 level = 0; level < levelCount; ++level) cout << setw(9) << GetSIMDLevelName(static_cast<SIMDLevel>(level));
+	cout << "\n";
+
+	const char* kernelNames[4] = { "trs", "mat4 x mat4", "mat4 x vec4", "aabb" };
+	for (u32 kernel = 0; kernel < 4; ++kernel)
+	{
+		cout << "[BENCH] " << kernelNames[kernel] << string(12 - string(kernelNames[kernel]).size(), ' ')
+			<< fixed << setprecision(2) << setw(6) << glmTimes[kernel] * 1e9 / BATCH_COUNT;
+		for (u32 level = 0; level < levelCount; ++level)
+		{
+			cout << setw(9) << batchTimes[level][kernel] * 1e9 / BATCH_COUNT;
+		}
+		cout << "\n";
+	}
+}
+
+template<typename Function> f64 TimeBest(Function function)
+{
+	f64 best = 1e30;
+	for (u32 run = 0; run < RUN_COUNT; ++run)
+	{
+		auto start = steady_clock::now();
+		function();
+		duration<f64> elapsed = steady_clock::now() - start;
+
+		best = min(best, elapsed.count());
+	}
+
+	return best;
+}
+
+void BuildBenchGrid()
+{
+	//solid floor with a wire network and scattered blocks on it, nothing above 4m
+	ChunkStore::FillBox(
+		vec3(0.0f, -1.0f, 0.0f),
+		vec3(RAYCAST_ROOM_CELLS * 0.5f, 0.0f, RAYCAST_ROOM_CELLS * 0.5f),
+		CELL_SOLID);
+
+	u32 seed = 12345;
+
+	for (u32 i = 0; i < 4096; ++i)
+	{
+		ivec3 cell(
+			static_cast<i32>(NextRandom(seed) * RAYCAST_ROOM_CELLS),
+			static_cast<i32>(NextRandom(seed) * 8.0f),
+			static_cast<i32>(NextRandom(seed) * RAYCAST_ROOM_CELLS));
+
+		ChunkStore::SetCell(cell, MakeBlockCell(static_cast<BlockType>(i % BLOCK_TYPE_COUNT)));
+	}
+}
+
+void RunRaycasts()
+{
+	BuildBenchGrid();
+
+	u32 seed = 67890;
+
+	//picking from eye height, and long rays from high above the blocks
+	vector<vec3> origins(RAY_COUNT);
+	vector<vec3> directions(RAY_COUNT);
+	vector<vec3> skyOrigins(RAY_COUNT);
+	vector<vec3> skyDirections(RAY_COUNT);
+
+	for (u32 i = 0; i < RAY_COUNT; ++i)
+	{
+		f32 room = RAYCAST_ROOM_CELLS * 0.5f;
+
+		origins[i] = vec3(NextRandom(seed) * room, 1.7f, NextRandom(seed) * room);
+		directions[i] = vec3(NextRandom(seed) - 0.5f, NextRandom(seed) - 0.7f, NextRandom(seed) - 0.5f);
+
+		skyOrigins[i] = vec3(NextRandom(seed) * room, 40.0f, NextRandom(seed) * room);
+		skyDirections[i] = vec3(NextRandom(seed) - 0.5f, -0.2f * NextRandom(seed), NextRandom(seed) - 0.5f);
+	}
+
+	auto castAll = [](const vector<vec3>& rayOrigins, const vector<vec3>& rayDirections, f32 maxDistance)
+	{
+		u32 hitCount = 0;
+		RaycastHit hit{};
+
+		for (u32 i = 0; i < RAY_COUNT; ++i)
+		{
+			if (ChunkStore::Raycast(rayOrigins[i], rayDirections[i], maxDistance, hit)) hitCount++;
+		}
+
+		return hitCount;
+	};
+
+	u32 pickHits = 0;
+	u32 skyHits = 0;
+	f64 pickTime = TimeBest([&]() { pickHits = castAll(origins, directions, 8.0f); });
+	f64 skyTime = TimeBest([&]() { skyHits = castAll(skyOrigins, skyDirections, 128.0f); });
+
+	benchSink = pickHits + skyHits;
+
+	cout << "[BENCH] raycast, " << ChunkStore::GetChunkCount() << " chunks: "
+		<< fixed << setprecision(0)
+		<< RAY_COUNT / (pickTime * 1e3) << " picking rays per ms (8m, "
+		<< pickHits * 100 / RAY_COUNT << "% hit), "
+		<< RAY_COUNT / (skyTime * 1e3) << " long rays per ms (128m, "
+		<< skyHits * 100 / RAY_COUNT << "% hit)\n";
+
+	ChunkStore::Clear();
+}
+
+void RunCharacterSteps()
+{
+	BuildBenchGrid();
+
+	CharacterBody body{};
+	body.pos = vec3(RAYCAST_ROOM_CELLS * 0.25f, 0.0f, RAYCAST_ROOM_CELLS * 0.25f);
+
+	//walks a slow circle across the blocks, jumping now and then
+	f64 stepTime = TimeBest([&]()
+	{
+		for (u32 i = 0; i < CHARACTER_STEP_COUNT; ++i)
+		{
+			f32 angle = static_cast<f32>(i) * 0.001f;
+			vec3 moveVelocity(std::cos(angle) * 4.0f, 0.0f, std::sin(angle) * 4.0f);
+
+			CharacterController::Step(body, moveVelocity, i % 90 == 0, 1.0f / 60.0f);
+		}
+	});
+
+	benchSink = static_cast<u64>(body.pos.x);
+
+	cout << "[BENCH] character controller: "
+		<< fixed << setprecision(3)
+		<< stepTime * 1e6 / CHARACTER_STEP_COUNT << "us per fixed step\n";
+
+	ChunkStore::Clear();
+}
+
+f32 NextRandom(u32& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return static_cast<f32>(seed >> 8) / static_cast<f32>(1u << 24);
+}
+
+void RunBroadphase()
+{
+	u32 seed = 24680;
+
+	vector<Proxy> proxies(BROADPHASE_BODY_COUNT);
+	vector<vec3> positions(BROADPHASE_BODY_COUNT);
+
+	//one step of every moving body drifting a little, like debris settling
+	auto runSteps = [&](u32 awakeRatio)
+	{
+		u32 pairCount = 0;
+		auto start = steady_clock::now();
+
+		for (u32 step = 0; step < BROADPHASE_STEP_COUNT; ++step)
+		{
+			for (u32 i = 0; i < BROADPHASE_BODY_COUNT; i += awakeRatio)
+			{
+				positions[i] += vec3(NextRandom(seed) - 0.5f, NextRandom(seed) - 0.5f, NextRandom(seed) - 0.5f) * 0.05f;
+				Broadphase::Move(proxies[i], positions[i] - vec3(0.5f), positions[i] + vec3(0.5f));
+			}
+
+			Broadphase::Update();
+			pairCount += static_cast<u32>(Broadphase::GetPairs().size());
+		}
+
+		duration<f64> elapsed = steady_clock::now() - start;
+		benchSink = pairCount;
+
+		return elapsed.count() / BROADPHASE_STEP_COUNT;
+	};
+
+	auto addBodies = [&](bool isSleeping)
+	{
+		for (u32 i = 0; i < BROADPHASE_BODY_COUNT; ++i)
+		{
+			positions[i] = vec3(NextRandom(seed) * 200.0f, NextRandom(seed) * 4.0f, NextRandom(seed) * 200.0f);
+			proxies[i] = Broadphase::Add(positions[i] - vec3(0.5f), positions[i] + vec3(0.5f), i, isSleeping);
+		}
+		Broadphase::Update();
+	};
+
+	addBodies(false);
+	f64 awakeTime = runSteps(1);
+	u32 pairCount = static_cast<u32>(Broadphase::GetPairs().size());
+	Broadphase::Clear();
+
+	addBodies(true);
+	f64 sleepingTime = runSteps(BROADPHASE_AWAKE_RATIO);
+	Broadphase::Clear();
+
+	cout << "[BENCH] broadphase, " << BROADPHASE_BODY_COUNT << " boxes, " << pairCount << " pairs: "
+		<< fixed << setprecision(1)
+		<< awakeTime * 1e6 << "us per step all moving, "
+		<< sleepingTime * 1e6 << "us per step with 1 in " << BROADPHASE_AWAKE_RATIO << " moving\n";
+}
+
+void RunDebris()
+{
+	ChunkStore::FillBox(vec3(-20.0f, -1.0f, -20.0f), vec3(20.0f, 0.0f, 20.0f), CELL_SOLID);
+
+	for (u32 i = 0; i < DEBRIS_PANEL_COUNT; ++i)
+	{
+		vec3 pos(
+			static_cast<f32>(i % 20) * 1.1f - 11.0f,
+			3.0f + static_cast<f32>(i / 20) * 0.3f,
+			static_cast<f32>(i / 20 % 5) * 1.2f + 5.0f);
+		vec3 rot(
+			static_cast<f32>(i * 7 % 40),
+			static_cast<f32>(i * 13 % 90),
+			0.0f);
+
+		Entity entity = EntityStore::Create();
+		TransformSystem::Add(entity, pos, rot, vec3(1.0f, 0.1f, 1.0f));
+		DebrisSystem::Add(entity);
+	}
+
+	//settling, until every island sleeps
+	u32 settleSteps = 0;
+	u32 maxContacts = 0;
+	auto start = steady_clock::now();
+
+	while (settleSteps < DEBRIS_MAX_STEPS)
+	{
+		DebrisSystem::Step(1.0f / 60.0f);
+		TransformSystem::Update();
+		FrameArena::EndFrame();
+		settleSteps++;
+
+		maxContacts = max(maxContacts, DebrisSystem::GetContactCount());
+		if (DebrisSystem::GetAwakeCount() == 0) break;
+	}
+
+	duration<f64> settleTime = steady_clock::now() - start;
+
+	//nothing moves, nothing should be solved
+	start = steady_clock::now();
+	for (u32 i = 0; i < DEBRIS_SLEEPING_STEPS; ++i)
+	{
+		DebrisSystem::Step(1.0f / 60.0f);
+		FrameArena::EndFrame();
+	}
+	duration<f64> sleepingTime = steady_clock::now() - start;
+
+	cout << "[BENCH] debris, " << DEBRIS_PANEL_COUNT << " panels, up to " << maxContacts << " contacts: "
+		<< (settleSteps == DEBRIS_MAX_STEPS ? "still moving after " : "asleep after ") << settleSteps << " steps, "
+		<< fixed << setprecision(1)
+		<< settleTime.count() * 1e6 / settleSteps << "us per step settling, "
+		<< sleepingTime.count() * 1e6 / DEBRIS_SLEEPING_STEPS << "us per step asleep\n";
+
+	//one floor cell goes, only the panels lying on it and the ones resting on those wake
+	ChunkStore::SetCell(ChunkStore::WorldToCell(vec3(-5.5f, -0.5f, 7.5f)), CELL_EMPTY);
+
+	start = steady_clock::now();
+	DebrisSystem::Step(1.0f / 60.0f);
+	duration<f64> wakeTime = steady_clock::now() - start;
+	FrameArena::EndFrame();
+
+	cout << "[BENCH] debris, one floor cell removed: " << DebrisSystem::GetAwakeCount()
+		<< " of " << DEBRIS_PANEL_COUNT << " panels woke in "
+		<< fixed << setprecision(1) << wakeTime.count() * 1e6 << "us\n";
+
+	for (u32 i = 0; i < DEBRIS_MAX_STEPS && DebrisSystem::GetAwakeCount() > 0; ++i)
+	{
+		DebrisSystem::Step(1.0f / 60.0f);
+		TransformSystem::Update();
+		FrameArena::EndFrame();
+	}
+
+	//the floor under one half goes, panels lying on that half wake with what rests on them
+	ChunkStore::FillBox(vec3(-20.0f, -1.0f, -20.0f), vec3(0.0f, 0.0f, 20.0f), CELL_EMPTY);
+
+	start = steady_clock::now();
+	DebrisSystem::Step(1.0f / 60.0f);
+	wakeTime = steady_clock::now() - start;
+	FrameArena::EndFrame();
+
+	cout << "[BENCH] debris, floor under half the pile removed: " << DebrisSystem::GetAwakeCount()
+		<< " of " << DEBRIS_PANEL_COUNT << " panels woke in "
+		<< fixed << setprecision(1) << wakeTime.count() * 1e6 << "us\n";
+
+	EntityStore::Clear();
+	Broadphase::Clear();
+	ChunkStore::Clear();
+}
+
+void RunWater()
+{
+	//floor, four walls, a pillar and a wire across the room
+	ChunkStore::FillBox(vec3(-10.0f, -0.5f, -10.0f), vec3(10.0f, 0.0f, 10.0f), CELL_SOLID);
+	ChunkStore::FillBox(vec3(-10.0f, 0.0f, -10.0f), vec3(-9.5f, 4.0f, 10.0f), CELL_SOLID);
+	ChunkStore::FillBox(vec3(9.5f, 0.0f, -10.0f), vec3(10.0f, 4.0f, 10.0f), CELL_SOLID);
+	ChunkStore::FillBox(vec3(-10.0f, 0.0f, -10.0f), vec3(10.0f, 4.0f, -9.5f), CELL_SOLID);
+	ChunkStore::FillBox(vec3(-10.0f, 0.0f, 9.5f), vec3(10.0f, 4.0f, 10.0f), CELL_SOLID);
+	ChunkStore::FillBox(vec3(2.0f, 0.0f, 2.0f), vec3(3.0f, 4.0f, 3.0f), CELL_SOLID);
+	ChunkStore::FillBox(vec3(-5.0f, 0.0f, 0.0f), vec3(5.0f, 0.5f, 0.5f), MakeBlockCell(BlockType::Wire));
+
+	Entity wire = EntityStore::Create();
+	EntityStore::GetCircuits().Add(wire);
+
+	ivec3 wireFirst{};
+	ivec3 wireLast{};
+	ChunkStore::GetBoxCells(vec3(-5.0f, 0.0f, 0.0f), vec3(5.0f, 0.5f, 0.5f), wireFirst, wireLast);
+	WaterSystem::AddCircuit(wire, wireFirst, wireLast);
+
+	u32 maxSteppedChunks = 0;
+	auto start = steady_clock::now();
+
+	for (u32 i = 0; i < WATER_POUR_STEPS; ++i)
+	{
+		WaterSystem::AddWater(ivec3(-10, 6, -10), 255);
+		WaterSystem::AddWater(ivec3(10, 6, 5), 255);
+		WaterSystem::Step();
+		FrameArena::EndFrame();
+
+		maxSteppedChunks = max(maxSteppedChunks, WaterSystem::GetSteppedChunkCount());
+	}
+
+	duration<f64> pourTime = steady_clock::now() - start;
+
+	//the leaks stop and the room evens out
+	u32 settleSteps = 0;
+	start = steady_clock::now();
+
+	while (settleSteps < WATER_MAX_STEPS
+		&& WaterSystem::GetActiveChunkCount() > 0)
+	{
+		WaterSystem::Step();
+		FrameArena::EndFrame();
+		settleSteps++;
+	}
+
+	duration<f64> settleTime = steady_clock::now() - start;
+
+	start = steady_clock::now();
+	for (u32 i = 0; i < WATER_SLEEPING_STEPS; ++i)
+	{
+		WaterSystem::Step();
+		FrameArena::EndFrame();
+	}
+	duration<f64> sleepingTime = steady_clock::now() - start;
+
+	cout << "[BENCH] water, " << ChunkStore::GetChunkCount() << " chunks, up to " << maxSteppedChunks << " stepped: "
+		<< fixed << setprecision(1)
+		<< pourTime.count() * 1e6 / WATER_POUR_STEPS << "us per step leaking, "
+		<< (settleSteps == WATER_MAX_STEPS ? "still flowing after " : "asleep after ") << settleSteps << " more steps at "
+		<< settleTime.count() * 1e6 / max(settleSteps, 1u) << "us per step, "
+		<< setprecision(3) << sleepingTime.count() * 1e6 / WATER_SLEEPING_STEPS << "us per step asleep\n";
+
+	start = steady_clock::now();
+	size_t surfaceCount = WaterSystem::GetSurfaces().size();
+	duration<f64> surfaceTime = steady_clock::now() - start;
+
+	cout << "[BENCH] water, " << surfaceCount << " surface cells listed in "
+		<< fixed << setprecision(1) << surfaceTime.count() * 1e6 << "us, the wire is "
+		<< (EntityStore::GetCircuits().Get(wire)->isShorted ? "shorted" : "dry") << "\n";
+
+	EntityStore::Clear();
+	WaterSystem::Clear();
+	ChunkStore::Clear();
+}
+
+void RunCollapse()
+{
+	ChunkStore::FillBox(
+		vec3(0.0f, -CELL_SIZE, 0.0f),
+		vec3(COLLAPSE_FLOOR_CELLS * CELL_SIZE, 0.0f, COLLAPSE_FLOOR_CELLS * CELL_SIZE),
+		CELL_SOLID);
+
+	auto addBlock = [](const ivec3& cell, BlockType type)
+		{
+			Entity entity = EntityStore::Create();
+			vec3 min = ChunkStore::CellToWorld(cell);
+
+			ChunkStore::SetCell(cell, MakeBlockCell(type));
+			SupportSystem::Add(entity, min, min + CELL_SIZE);
+
+			return entity;
+		};
+
+	//every fourth row is a wire with layer sockets on every other cell,
+	//between them towers of mixed blocks on every other cell
+	Entity towerBase{};
+	u32 blockCount = 0;
+	for (i32 z = 0; z < COLLAPSE_FLOOR_CELLS; z++)
+	{
+		for (i32 x = 0; x < COLLAPSE_FLOOR_CELLS; x++)
+		{
+			if (z % 4 == 0)
+			{
+				addBlock(ivec3(x, 0, z), BlockType::Wire);
+				blockCount++;
+
+				if (x % 2 == 0)
+				{
+					addBlock(ivec3(x, 1, z), BlockType::LayerSocket);
+					blockCount++;
+				}
+
+				continue;
+			}
+
+			if ((x + z) % 2 != 0) continue;
+
+			for (i32 y = 0; y < COLLAPSE_TOWER_HEIGHT; y++)
+			{
+				//anything but wires and layer sockets
+				u32 first = static_cast<u32>(BlockType::Repeater);
+				BlockType type = static_cast<BlockType>(first + (x + y + z) % (BLOCK_TYPE_COUNT - first));
+				Entity entity = addBlock(ivec3(x, y, z), type);
+				if (y == 0 && !towerBase.IsValid()) towerBase = entity;
+
+				blockCount++;
+			}
+		}
+	}
+
+	//one block taken from the bottom of a tower brings down the rest of it
+	auto start = steady_clock::now();
+
+	SupportSystem::Remove(towerBase);
+	EntityStore::GetSupports().Remove(towerBase);
+	SupportSystem::Resolve();
+
+	duration<f64> towerTime = steady_clock::now() - start;
+	u32 towerFallen = static_cast<u32>(SupportSystem::GetCollapsed().size());
+
+	//the whole floor gives way at once, everything on it goes in one resolve
+	start = steady_clock::now();
+
+	for (i32 z = 0; z < COLLAPSE_FLOOR_CELLS; z++)
+	{
+		for (i32 x = 0; x < COLLAPSE_FLOOR_CELLS; x++) SupportSystem::ClearCell(ivec3(x, -1, z));
+	}
+	SupportSystem::Resolve();
+
+	duration<f64> floorTime = steady_clock::now() - start;
+	u32 floorFallen = static_cast<u32>(SupportSystem::GetCollapsed().size());
+
+	cout << "[BENCH] collapse, " << blockCount << " blocks: "
+		<< fixed << setprecision(1)
+		<< towerTime.count() * 1e6 << "us for a tower of " << towerFallen << " falling, "
+		<< floorTime.count() * 1e3 << "ms for the floor giving way under " << floorFallen << " blocks, "
+		<< SupportSystem::GetCheckedCellCount() << " cells checked, "
+		<< floorTime.count() * 1e9 / max(floorFallen, 1u) << "ns per fallen block\n";
+
+	EntityStore::Clear();
+	WaterSystem::Clear();
+	ChunkStore::Clear();
+}
\ No newline at end of file
@@ -0,0 +1,321 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#include <thread>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "bcencoder.hpp"
+
+using CircuitGame::Cook::BCEncoder;
+using CircuitGame::Cook::Image;
+using CircuitGame::Graphics::CookedFormat;
+using CircuitGame::Graphics::GetCookedMipSize;
+
+using std::thread;
+using std::vector;
+using std::min;
+using std::max;
+using std::clamp;
+using std::swap;
+using std::abs;
+
+static void FetchBlock(
+	const Image& image,
+	u32 blockX,
+	u32 blockY,
+	u8 outBlock[16][4]);
+static void EncodeColorBlock(
+	const u8 block[16][4],
+	u8* out);
+static void EncodeAlphaBlock(
+	const u8 block[16][4],
+	u8* out);
+static u16 To565(const vec3& color);
+static vec3 From565(u16 color);
+
+namespace CircuitGame::Cook
+{
+	Image BCEncoder::Downsample(const Image& source)
+	{
+		Image result{};
+		result.width = max(source.width / 2, 1u);
+		result.height = max(source.height / 2, 1u);
+		result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+		for (u32 y = 0; y < result.height; ++y)
+		{
+			u32 y0 = min(y * 2, source.height - 1);
+			u32 y1 = min(y * 2 + 1, source.height - 1);
+
+			for (u32 x = 0; x < result.width; ++x)
+			{
+				u32 x0 = min(x * 2, source.width - 1);
+				u32 x1 = min(x * 2 + 1, source.width - 1);
+
+				for (u32 c = 0; c < 4; ++c)
+				{
+					u32 sum =
+						source.pixels[(static_cast<size_t>(y0) * source.width + x0) * 4 + c]
+						+ source.pixels[(static_cast<size_t>(y0) * source.width + x1) * 4 + c]
+						+ source.pixels[(static_cast<size_t>(y1) * source.width + x0) * 4 + c]
+						+ source.pixels[(static_cast<size_t>(y1) * source.width + x1) * 4 + c];
+
+					result.pixels[(static_cast<size_t>(y) * result.width + x) * 4 + c] =
+						static_cast<u8>((sum + 2) / 4);
+				}
+			}
+		}
+
+		return result;
+	}
+
+	vector<u8> BCEncoder::Encode(
+		const Image& image,
+		CookedFormat format,
+		u32 threadCount)
+	{
+		vector<u8> output(GetCookedMipSize(format, image.width, image.height));
+
+		if (format == CookedFormat::Cooked_RGBA8)
+		{
+			output = image.pixels;
+			return output;
+		}
+
+		u32 blocksX = (image.width + 3) / 4;
+		u32 blocksY = (image.height + 3) / 4;
+		u32 blockSize = format == CookedFormat::Cooked_BC1 ? 8 : 16;
+
+		auto EncodeRows = [&](u32 firstRow, u32 lastRow)
+			{
+				u8 block[16][4]{};
+				for (u32 by = firstRow; by < lastRow; ++by)
+				{
+					for (u32 bx = 0; bx < blocksX; ++bx)
+					{
+						FetchBlock(image, bx, by, block);
+
+						u8* out = &output[(static_cast<size_t>(by) * blocksX + bx) * blockSize];
+						if (format == CookedFormat::Cooked_BC3)
+						{
+							EncodeAlphaBlock(block, out);
+							EncodeColorBlock(block, out + 8);
+						}
+						else EncodeColorBlock(block, out);
+					}
+				}
+			};
+
+		//rows of blocks are independent, so each thread takes a contiguous slice
+
+		u32 workers = clamp(threadCount, 1u, blocksY);
+		u32 rowsPerWorker = (blocksY + workers - 1) / workers;
+
+		vector<thread> threads{};
+		for (u32 i = 0; i < workers; ++i)
+		{
+			u32 firstRow = i * rowsPerWorker;
+			u32 lastRow = min(firstRow + rowsPerWorker, blocksY);
+			if (firstRow >= lastRow) break;
+
+			threads.emplace_back(EncodeRows, firstRow, lastRow);
+		}
+		for (auto& worker : threads) worker.join();
+
+		return output;
+	}
+}
+
+void FetchBlock(
+	const Image& image,
+	u32 blockX,
+	u32 blockY,
+	u8 outBlock[16][4])
+{
+	for (u32 y = 0; y < 4; ++y)
+	{
+		u32 sourceY = min(blockY * 4 + y, image.height - 1);
+		for (u32 x = 0; x < 4; ++x)
+		{
+			u32 sourceX = min(blockX * 4 + x, image.width - 1);
+			const u8* pixel = &image.pixels[(static_cast<size_t>(sourceY) * image.width + sourceX) * 4];
+
+			outBlock[y * 4 + x][0] = pixel[0];
+			outBlock[y * 4 + x][1] = pixel[1];
+			outBlock[y * 4 + x][2] = pixel[2];
+			outBlock[y * 4 + x][3] = pixel[3];
+		}
+	}
+}
+
+void EncodeColorBlock(
+	const u8 block[16][4],
+	u8* out)
+{
+	//principal axis of the block colors through a few power iterations
+
+	vec3 colors[16]{};
+	vec3 mean(0.0f);
+	for (u32 i = 0; i < 16; ++i)
+	{
+		colors[i] = vec3(block[i][0], block[i][1], block[i][2]);
+		mean += colors[i];
+	}
+	mean /= 16.0f;
+
+	f32 cov[6]{};
+	for (u32 i = 0; i < 16; ++i)
+	{
+		vec3 d = colors[i] - mean;
+		cov[0] += d.r * d.r;
+		cov[1] += d.r * d.g;
+		cov[2] += d.r * d.b;
+		cov[3] += d.g * d.g;
+		cov[4] += d.g * d.b;
+		cov[5] += d.b * d.b;
+	}
+
+	vec3 axis(1.0f, 1.0f, 1.0f);
+	for (u32 iteration = 0; iteration < 4; ++iteration)
+	{
+		vec3 next(
+			cov[0] * axis.r + cov[1] * axis.g + cov[2] * axis.b,
+			cov[1] * axis.r + cov[3] * axis.g + cov[4] * axis.b,
+			cov[2] * axis.r + cov[4] * axis.g + cov[5] * axis.b);
+
+		f32 length = glm::length(next);
+		if (length < 1e-6f) break;
+		axis = next / length;
+	}
+
+	//extreme projections become the endpoints, inset slightly to reduce error
+
+	f32 minProjection = 1e30f;
+	f32 maxProjection = -1e30f;
+	for (u32 i = 0; i < 16; ++i)
+	{
+		f32 projection = glm::dot(colors[i] - mean, axis);
+		minProjection = min(minProjection, projection);
+		maxProjection = max(maxProjection, projection);
+	}
+
+	f32 inset = (maxProjection - minProjection) / 16.0f;
+	vec3 maxColor = glm::clamp(mean + axis * (maxProjection - inset), vec3(0.0f), vec3(255.0f));
+	vec3 minColor = glm::clamp(mean + axis * (minProjection + inset), vec3(0.0f), vec3(255.0f));
+
+	u16 color0 = To565(maxColor);
+	u16 color1 = To565(minColor);
+
+	//four-color mode requires color0 > color1
+	if (color0 < color1) swap(color0, color1);
+
+	u32 indices = 0;
+	if (color0 != color1)
+	{
+		vec3 palette[4]{};
+		palette[0] = From565(color0);
+		palette[1] = From565(color1);
+		palette[2] = (palette[0] * 2.0f + palette[1]) / 3.0f;
+		palette[3] = (palette[0] + palette[1] * 2.0f) / 3.0f;
+
+		for (u32 i = 0; i < 16; ++i)
+		{
+			u32 best = 0;
+			f32 bestDistance = 1e30f;
+			for (u32 p = 0; p < 4; ++p)
+			{
+				vec3 d = colors[i] - palette[p];
+				f32 distance = glm::dot(d, d);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			indices |= best << (i * 2);
+		}
+	}
+
+	out[0] = static_cast<u8>(color0 & 0xFF);
+	out[1] = static_cast<u8>(color0 >> 8);
+	out[2] = static_cast<u8>(color1 & 0xFF);
+	out[3] = static_cast<u8>(color1 >> 8);
+	out[4] = static_cast<u8>(indices & 0xFF);
+	out[5] = static_cast<u8>((indices >> 8) & 0xFF);
+	out[6] = static_cast<u8>((indices >> 16) & 0xFF);
+	out[7] = static_cast<u8>((indices >> 24) & 0xFF);
+}
+
+void EncodeAlphaBlock(
+	const u8 block[16][4],
+	u8* out)
+{
+	u8 alpha0 = 0;
+	u8 alpha1 = 255;
+	for (u32 i = 0; i < 16; ++i)
+	{
+		alpha0 = max(alpha0, block[i][3]);
+		alpha1 = min(alpha1, block[i][3]);
+	}
+
+	u64 indices = 0;
+	if (alpha0 != alpha1)
+	{
+		//alpha0 > alpha1 selects the eight value interpolation mode
+		u32 palette[8]{};
+		palette[0] = alpha0;
+		palette[1] = alpha1;
+		for (u32 p = 1; p < 7; ++p)
+		{
+			palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+		}
+
+		for (u32 i = 0; i < 16; ++i)
+		{
+			u32 best = 0;
+			i32 bestDistance = 256;
+			for (u32 p = 0; p < 8; ++p)
+			{
+				i32 distance = abs(static_cast<i32>(block[i][3]) - static_cast<i32>(palette[p]));
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			indices |= static_cast<u64>(best) << (i * 3);
+		}
+	}
+
+	out[0] = alpha0;
+	out[1] = alpha1;
+	for (u32 i = 0; i < 6; ++i)
+	{
+		out[2 + i] = static_cast<u8>((indices >> (i * 8)) & 0xFF);
+	}
+}
+
+u16 To565(const vec3& color)
+{
+	u32 r = static_cast<u32>(std::lround(color.r * 31.0f / 255.0f));
+	u32 g = static_cast<u32>(std::lround(color.g * 63.0f / 255.0f));
+	u32 b = static_cast<u32>(std::lround(color.b * 31.0f / 255.0f));
+
+	return static_cast<u16>((r << 11) | (g << 5) | b);
+}
+
+vec3 From565(u16 color)
+{
+	u32 r = (color >> 11) & 0x1F;
+	u32 g = (color >> 5) & 0x3F;
+	u32 b = color & 0x1F;
+
+	return vec3(
+		static_cast<f32>((r << 3) | (r >> 2)),
+		static_cast<f32>((g << 2) | (g >> 4)),
+		static_cast<f32>((b << 3) | (b >> 2)));
+}
\ No newline at end of file
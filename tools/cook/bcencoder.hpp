@@ -0,0 +1,40 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+#pragma once
+
+#include <vector>
+
+//kalawindow
+#include "core/platform.hpp"
+
+#include "graphics/cookedtexture.hpp"
+
+namespace CircuitGame::Cook
+{
+	using CircuitGame::Graphics::CookedFormat;
+
+	using std::vector;
+
+	struct Image
+	{
+		vector<u8> pixels{}; //RGBA8
+		u32 width{};
+		u32 height{};
+	};
+
+	class BCEncoder
+	{
+	public:
+		//Halves the image with a 2x2 box filter, odd edges are clamped
+		static Image Downsample(const Image& source);
+
+		//Encodes one mip level, 4x4 block rows are spread over the given thread count
+		static vector<u8> Encode(
+			const Image& image,
+			CookedFormat format,
+			u32 threadCount);
+	};
+}
\ No newline at end of file
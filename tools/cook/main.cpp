@@ -0,0 +1,323 @@
+//Copyright(C) 2025 Lost Empire Entertainment
+//This program comes with ABSOLUTELY NO WARRANTY.
+//This is free software, and you are welcome to redistribute it under certain conditions.
+//Read LICENSE.md for more information.
+
+//Circuit_Chan_cook - converts source textures into .cctx files with
+//precomputed mip chains in a GPU block compressed format.
+//Usage: Circuit_Chan_cook <input folder> <output folder> [bc1|bc3]
+//  - every .png, .jpg and .jpeg under the input folder is cooked,
+//    the folder structure is mirrored in the output folder
+//  - every block type gets blocks/<type>.cctx, the ones without a source texture
+//    in blocks/ are cooked from cube.jpg with the same tint the game uses
+//  - bc1 is the default, bc3 keeps an alpha channel
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image/stb_image.h"
+
+#include "bcencoder.hpp"
+#include "graphics/cookedtexture.hpp"
+#include "gameobjects/blocktype.hpp"
+
+using CircuitGame::Cook::BCEncoder;
+using CircuitGame::Cook::Image;
+using CircuitGame::Graphics::CookedFormat;
+using CircuitGame::Graphics::CookedTextureHeader;
+using CircuitGame::Graphics::CookedMipEntry;
+using CircuitGame::Graphics::COOKED_TEXTURE_MAGIC;
+using CircuitGame::Graphics::COOKED_TEXTURE_VERSION;
+using CircuitGame::Graphics::COOKED_TEXTURE_EXTENSION;
+using CircuitGame::GameObjects::BlockType;
+using CircuitGame::GameObjects::BLOCK_TYPE_COUNT;
+using CircuitGame::GameObjects::GetBlockTypeName;
+using CircuitGame::GameObjects::GetBlockFallbackTint;
+
+using std::cout;
+using std::cerr;
+using std::ofstream;
+using std::ios;
+using std::string;
+using std::vector;
+using std::thread;
+using std::max;
+using std::transform;
+using std::move;
+using std::filesystem::path;
+using std::filesystem::exists;
+using std::filesystem::is_directory;
+using std::filesystem::create_directories;
+using std::filesystem::recursive_directory_iterator;
+using std::filesystem::relative;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+static bool LoadSourceImage(
+	const path& input,
+	Image& outImage);
+
+static bool CookImage(
+	Image level,
+	const string& sourceName,
+	const path& output,
+	CookedFormat format,
+	u32 threadCount,
+	size_t& outSourceBytes,
+	size_t& outCookedBytes);
+
+static bool HasBlockSource(
+	const path& blockFolder,
+	const string& name);
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		cerr << "Usage: Circuit_Chan_cook <input folder> <output folder> [bc1|bc3]\n";
+		return 1;
+	}
+
+	path inputFolder = argv[1];
+	path outputFolder = argv[2];
+
+	CookedFormat format = CookedFormat::Cooked_BC1;
+	if (argc > 3)
+	{
+		string formatName = argv[3];
+		transform(formatName.begin(), formatName.end(), formatName.begin(), ::tolower);
+
+		if (formatName == "bc1") format = CookedFormat::Cooked_BC1;
+		else if (formatName == "bc3") format = CookedFormat::Cooked_BC3;
+		else
+		{
+			cerr << "[COOK] Unsupported format '" << formatName << "', must be bc1 or bc3!\n";
+			return 1;
+		}
+	}
+
+	if (!exists(inputFolder)
+		|| !is_directory(inputFolder))
+	{
+		cerr << "[COOK] Input folder '" << inputFolder.string() << "' does not exist!\n";
+		return 1;
+	}
+
+	u32 threadCount = max(thread::hardware_concurrency(), 1u);
+
+	auto start = steady_clock::now();
+
+	u32 cookedCount = 0;
+	u32 failedCount = 0;
+	size_t sourceBytes = 0;
+	size_t cookedBytes = 0;
+
+	for (const auto& entry : recursive_directory_iterator(inputFolder))
+	{
+		if (!entry.is_regular_file()) continue;
+
+		string extension = entry.path().extension().string();
+		transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		if (extension != ".png"
+			&& extension != ".jpg"
+			&& extension != ".jpeg")
+		{
+			continue;
+		}
+
+		path target = outputFolder / relative(entry.path(), inputFolder);
+		target.replace_extension(COOKED_TEXTURE_EXTENSION);
+
+		Image image{};
+		if (LoadSourceImage(entry.path(), image)
+			&& CookImage(
+				move(image),
+				entry.path().filename().string(),
+				target,
+				format,
+				threadCount,
+				sourceBytes,
+				cookedBytes))
+		{
+			++cookedCount;
+		}
+		else ++failedCount;
+	}
+
+	//the game loads one layer per block type from blocks/, types that have
+	//no texture of their own yet get the tinted cube texture like in the game
+	path fallbackPath = inputFolder / "cube.jpg";
+	Image fallback{};
+	if (exists(fallbackPath)
+		&& LoadSourceImage(fallbackPath, fallback))
+	{
+		for (u32 i = 0; i < BLOCK_TYPE_COUNT; ++i)
+		{
+			BlockType type = static_cast<BlockType>(i);
+			string name = GetBlockTypeName(type);
+			if (HasBlockSource(inputFolder / "blocks", name)) continue;
+
+			Image tinted = fallback;
+			vec3 tint = GetBlockFallbackTint(type);
+			for (size_t p = 0; p < tinted.pixels.size(); p += 4)
+			{
+				tinted.pixels[p + 0] = static_cast<u8>(tinted.pixels[p + 0] * tint.r);
+				tinted.pixels[p + 1] = static_cast<u8>(tinted.pixels[p + 1] * tint.g);
+				tinted.pixels[p + 2] = static_cast<u8>(tinted.pixels[p + 2] * tint.b);
+			}
+
+			if (CookImage(
+				move(tinted),
+				"cube.jpg tinted for " + name,
+				outputFolder / "blocks" / (name + COOKED_TEXTURE_EXTENSION),
+				format,
+				threadCount,
+				sourceBytes,
+				cookedBytes))
+			{
+				++cookedCount;
+			}
+			else ++failedCount;
+		}
+	}
+	else
+	{
+		cerr << "[COOK] No cube.jpg in the input folder, block types without a texture of their own are not cooked!\n";
+		++failedCount;
+	}
+
+	duration<double> elapsed = steady_clock::now() - start;
+
+	cout << "[COOK] Cooked " << cookedCount << " textures (" << failedCount << " failed) in "
+		<< elapsed.count() << "s on " << threadCount << " threads, "
+		<< sourceBytes / 1024 << "KB of RGBA8 mips became "
+		<< cookedBytes / 1024 << "KB.\n";
+
+	return failedCount == 0 ? 0 : 1;
+}
+
+bool LoadSourceImage(
+	const path& input,
+	Image& outImage)
+{
+	i32 width{};
+	i32 height{};
+	i32 channels{};
+
+	//same orientation as the runtime loader
+	stbi_set_flip_vertically_on_load(true);
+	u8* data = stbi_load(
+		input.string().c_str(),
+		&width,
+		&height,
+		&channels,
+		4);
+
+	if (data == nullptr)
+	{
+		cerr << "[COOK] Failed to load '" << input.string() << "'! Reason: " << stbi_failure_reason() << "\n";
+		return false;
+	}
+
+	outImage.width = static_cast<u32>(width);
+	outImage.height = static_cast<u32>(height);
+	outImage.pixels.assign(data, data + static_cast<size_t>(width) * height * 4);
+	stbi_image_free(data);
+
+	return true;
+}
+
+bool CookImage(
+	Image level,
+	const string& sourceName,
+	const path& output,
+	CookedFormat format,
+	u32 threadCount,
+	size_t& outSourceBytes,
+	size_t& outCookedBytes)
+{
+	u32 width = level.width;
+	u32 height = level.height;
+
+	//full mip chain down to 1x1
+
+	vector<CookedMipEntry> mips{};
+	vector<vector<u8>> mipData{};
+	while (true)
+	{
+		outSourceBytes += level.pixels.size();
+
+		vector<u8> encoded = BCEncoder::Encode(level, format, threadCount);
+
+		CookedMipEntry mip{};
+		mip.width = level.width;
+		mip.height = level.height;
+		mip.size = static_cast<u32>(encoded.size());
+		mips.push_back(mip);
+		mipData.push_back(move(encoded));
+
+		if (level.width == 1
+			&& level.height == 1)
+		{
+			break;
+		}
+		level = BCEncoder::Downsample(level);
+	}
+
+	CookedTextureHeader header{};
+	std::copy(COOKED_TEXTURE_MAGIC, COOKED_TEXTURE_MAGIC + 4, header.magic);
+	header.version = COOKED_TEXTURE_VERSION;
+	header.format = format;
+	header.width = width;
+	header.height = height;
+	header.mipCount = static_cast<u32>(mips.size());
+
+	u32 offset = static_cast<u32>(sizeof(CookedTextureHeader) + mips.size() * sizeof(CookedMipEntry));
+	for (auto& mip : mips)
+	{
+		mip.offset = offset;
+		offset += mip.size;
+	}
+
+	create_directories(output.parent_path());
+
+	ofstream file(output, ios::binary | ios::trunc);
+	if (!file.is_open())
+	{
+		cerr << "[COOK] Failed to open '" << output.string() << "' for writing!\n";
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(mips.data()), mips.size() * sizeof(CookedMipEntry));
+	for (const auto& bytes : mipData)
+	{
+		file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+		outCookedBytes += bytes.size();
+	}
+
+	cout << "[COOK] " << sourceName << " -> " << output.string()
+		<< " (" << width << "x" << height << ", " << mips.size() << " mips)\n";
+
+	return true;
+}
+
+bool HasBlockSource(
+	const path& blockFolder,
+	const string& name)
+{
+	for (const char* extension : { ".png", ".jpg", ".jpeg" })
+	{
+		if (exists(blockFolder / (name + extension))) return true;
+	}
+
+	return false;
+}
\ No newline at end of file